@@ -50,6 +50,7 @@ entity neo430_addr_gen is
     mem_i      : in  std_ulogic_vector(15 downto 0); -- memory input
     imm_i      : in  std_ulogic_vector(15 downto 0); -- branch offset
     irq_sel_i  : in  std_ulogic_vector(01 downto 0); -- IRQ vector
+    xirq_sel_i : in  std_ulogic_vector(03 downto 0); -- external IRQ vector (3: vectored mode, 2..0: source)
     -- control --
     ctrl_i     : in  std_ulogic_vector(ctrl_width_c-1 downto 0);
     -- data output --
@@ -102,12 +103,16 @@ begin
 
   -- Memory Address Output ----------------------------------------------------
   -- -----------------------------------------------------------------------------
-  memory_addr_out: process(ctrl_i, irq_sel_i, reg_i, mem_addr_reg)
+  memory_addr_out: process(ctrl_i, irq_sel_i, xirq_sel_i, reg_i, mem_addr_reg)
   begin
     if (ctrl_i(ctrl_adr_bp_en_c) = '1') then
       if (ctrl_i(ctrl_adr_ivec_oe_c) = '1') then -- interrupt handler call
         mem_addr_o <= dmem_base_c; -- IRQ vectors are located at the beginning of DMEM
-        mem_addr_o(2 downto 0) <= irq_sel_i & '0'; -- select according word-aligned entry
+        if (irq_sel_i = "11") and (xirq_sel_i(3) = '1') then -- vectored external IRQ: DMEM + 8 + 2*source
+          mem_addr_o(4 downto 0) <= std_ulogic_vector(unsigned'("01000") + unsigned("0" & xirq_sel_i(2 downto 0) & "0"));
+        else
+          mem_addr_o(2 downto 0) <= irq_sel_i & '0'; -- select according word-aligned entry
+        end if;
       else -- direct output of reg file
         mem_addr_o <= reg_i;
       end if;
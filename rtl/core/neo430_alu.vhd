@@ -1,7 +1,7 @@
 -- #################################################################################################
 -- #  << NEO430 - Arithmetical/Logical Unit >>                                                     #
 -- # ********************************************************************************************* #
--- # Main data processing ALU and operand registers. DADD instruction is not supported!            #
+-- # Main data processing ALU and operand registers. DADD instruction is optional (use_dadd_c).    #
 -- # ********************************************************************************************* #
 -- # BSD 3-Clause License                                                                          #
 -- #                                                                                               #
@@ -47,10 +47,15 @@ entity neo430_alu is
     clk_i  : in  std_ulogic; -- global clock, rising edge
     -- operands --
     reg_i  : in  std_ulogic_vector(15 downto 0); -- data from reg file
+    regb_i : in  std_ulogic_vector(15 downto 0); -- data from reg file read port B
     mem_i  : in  std_ulogic_vector(15 downto 0); -- data from memory
     sreg_i : in  std_ulogic_vector(15 downto 0); -- current SR
     -- control --
     ctrl_i : in  std_ulogic_vector(ctrl_width_c-1 downto 0);
+    -- custom instructions --
+    opa_o  : out std_ulogic_vector(15 downto 0); -- operand A (source register)
+    opb_o  : out std_ulogic_vector(15 downto 0); -- operand B (destination register)
+    cfu_i  : in  std_ulogic_vector(15 downto 0); -- CFU result
     -- results --
     data_o : out std_ulogic_vector(15 downto 0); -- result
     flag_o : out std_ulogic_vector(04 downto 0)  -- new ALU flags
@@ -63,11 +68,14 @@ architecture neo430_alu_rtl of neo430_alu is
   signal op_a_ff  : std_ulogic_vector(15 downto 0); -- operand register A
   signal op_b_ff  : std_ulogic_vector(15 downto 0); -- operand register B
   signal add_res  : std_ulogic_vector(17 downto 0); -- adder/subtractor kernel result
+  signal dadd_res : std_ulogic_vector(16 downto 0); -- decimal adder kernel result
+  signal xsh_res  : std_ulogic_vector(16 downto 0); -- multi-bit shifter result
   signal alu_res  : std_ulogic_vector(15 downto 0); -- alu result
   signal data_res : std_ulogic_vector(15 downto 0); -- final alu result
   signal zero     : std_ulogic; -- zero detector
   signal negative : std_ulogic; -- sign detector
   signal parity   : std_ulogic; -- parity detector
+  signal carry_in : std_ulogic; -- carry input (forced to zero by MSP430X extension word ZC bit)
 
 begin
 
@@ -86,15 +94,28 @@ begin
         op_a_ff <= op_data;
       end if;
       if (ctrl_i(ctrl_alu_opb_wr_c) = '1') then
-        op_b_ff <= op_data;
+        if (ctrl_i(ctrl_alu_opb_rfb_c) = '1') and (use_dual_rf_c = true) then -- both operands in one cycle
+          op_b_ff <= regb_i;
+        else
+          op_b_ff <= op_data;
+        end if;
       end if;
     end if;
   end process operand_register;
 
+  -- operands for CFU custom instructions --
+  opa_o <= op_a_ff;
+  opb_o <= op_b_ff;
+
+
+  -- Carry Input --------------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  carry_in <= sreg_i(sreg_c_c) and (not ctrl_i(ctrl_alu_zc_c));
+
 
   -- Binary Arithmetic Core ---------------------------------------------------
   -- -----------------------------------------------------------------------------
-  binary_arithmetic_core: process(ctrl_i, op_a_ff, op_b_ff, sreg_i)
+  binary_arithmetic_core: process(ctrl_i, op_a_ff, op_b_ff, carry_in)
     variable op_a_v             : std_ulogic_vector(15 downto 0);
     variable carry_v            : std_ulogic;
     variable carry_null_v       : std_ulogic;
@@ -117,7 +138,7 @@ begin
     -- carry input --
     if (ctrl_i(ctrl_alu_cmd3_c downto ctrl_alu_cmd0_c) = alu_addc_c) or 
        (ctrl_i(ctrl_alu_cmd3_c downto ctrl_alu_cmd0_c) = alu_subc_c) then -- use carry in
-      carry_in_v(0) := sreg_i(sreg_c_c);
+      carry_in_v(0) := carry_in;
     else
       carry_in_v(0) := carry_null_v; -- set default NO ACTIVE CARRY input
     end if;
@@ -148,9 +169,84 @@ begin
   end process binary_arithmetic_core;
 
 
+  -- Decimal (BCD) Arithmetic Core --------------------------------------------
+  -- -----------------------------------------------------------------------------
+  decimal_arithmetic_core: process(ctrl_i, op_a_ff, op_b_ff, carry_in)
+    variable carry_v    : std_ulogic;
+    variable carry_lo_v : std_ulogic;
+    variable sum_v      : unsigned(4 downto 0);
+  begin
+    if (use_dadd_c = true) then
+      carry_v := carry_in;
+      for i in 0 to 3 loop -- 4 BCD digits, ripple carry
+        sum_v := unsigned('0' & op_a_ff(i*4+3 downto i*4)) + unsigned('0' & op_b_ff(i*4+3 downto i*4));
+        if (carry_v = '1') then
+          sum_v := sum_v + 1;
+        end if;
+        if (sum_v > 9) then -- decimal adjust
+          sum_v   := sum_v + 6;
+          carry_v := '1';
+        else
+          carry_v := '0';
+        end if;
+        dadd_res(i*4+3 downto i*4) <= std_ulogic_vector(sum_v(3 downto 0));
+        if (i = 1) then
+          carry_lo_v := carry_v;
+        end if;
+      end loop; -- i
+      -- carry output --
+      if (ctrl_i(ctrl_alu_bw_c) = '1') then -- byte mode
+        dadd_res(16) <= carry_lo_v;
+      else -- word mode
+        dadd_res(16) <= carry_v;
+      end if;
+    else
+      dadd_res <= (others => '-');
+    end if;
+  end process decimal_arithmetic_core;
+
+
+  -- Multi-Bit Shifter (MSP430X RRCM/RRAM/RLAM/RRUM) --------------------------
+  -- -----------------------------------------------------------------------------
+  multi_bit_shifter: process(ctrl_i, op_a_ff, sreg_i)
+    variable data_v  : std_ulogic_vector(15 downto 0);
+    variable carry_v : std_ulogic;
+    variable lsb_v   : std_ulogic;
+    variable num_v   : natural range 0 to 3;
+  begin
+    if (use_xshift_c = true) then
+      data_v  := op_a_ff;
+      carry_v := sreg_i(sreg_c_c);
+      num_v   := to_integer(unsigned(ctrl_i(ctrl_alu_xsh_n1_c downto ctrl_alu_xsh_n0_c)));
+      for i in 0 to 3 loop -- 1..4 shift stages
+        if (i <= num_v) then
+          lsb_v := data_v(0);
+          case ctrl_i(ctrl_alu_cmd1_c downto ctrl_alu_cmd0_c) is
+            when "00" => -- RRCM: rotate right through carry
+              data_v := carry_v & data_v(15 downto 1);
+              carry_v := lsb_v;
+            when "01" => -- RRAM: shift right arithmetically
+              data_v := data_v(15) & data_v(15 downto 1);
+              carry_v := lsb_v;
+            when "10" => -- RLAM: shift left arithmetically
+              carry_v := data_v(15);
+              data_v := data_v(14 downto 0) & '0';
+            when others => -- RRUM: shift right unsigned
+              data_v := '0' & data_v(15 downto 1);
+              carry_v := lsb_v;
+          end case;
+        end if;
+      end loop; -- i
+      xsh_res <= carry_v & data_v;
+    else
+      xsh_res <= (others => '-');
+    end if;
+  end process multi_bit_shifter;
+
+
   -- ALU Core -----------------------------------------------------------------
   -- -----------------------------------------------------------------------------
-  alu_core: process(ctrl_i, op_a_ff, op_b_ff, sreg_i, negative, zero, parity, add_res)
+  alu_core: process(ctrl_i, op_a_ff, op_b_ff, sreg_i, carry_in, negative, zero, parity, add_res, dadd_res, xsh_res, cfu_i)
   begin
     -- defaults --
     alu_res <= op_a_ff;
@@ -172,6 +268,11 @@ begin
         flag_o(flag_c_c) <= add_res(16);
         flag_o(flag_v_c) <= add_res(17);
 
+      when alu_dadd_c => -- r <= a + b + carry (BCD)
+        alu_res <= dadd_res(15 downto 0);
+        flag_o(flag_c_c) <= dadd_res(16);
+        flag_o(flag_v_c) <= sreg_i(sreg_v_c); -- undefined, keep
+
       when alu_and_c => -- r <= a & b
         alu_res <= op_a_ff and op_b_ff;
         flag_o(flag_c_c) <= not zero;
@@ -213,9 +314,9 @@ begin
             alu_res(7) <= op_a_ff(7);
           end if;
         else -- alu_rrc_c
-          alu_res <= sreg_i(sreg_c_c) & op_a_ff(15 downto 1); -- word mode
+          alu_res <= carry_in & op_a_ff(15 downto 1); -- word mode
           if (ctrl_i(ctrl_alu_bw_c) = '1') then -- byte mode
-            alu_res(7) <= sreg_i(sreg_c_c);
+            alu_res(7) <= carry_in;
           end if;
         end if;
         flag_o(flag_c_c) <= op_a_ff(0);
@@ -252,6 +353,20 @@ begin
         flag_o(flag_p_c) <= '-';
 
     end case;
+
+    -- multi-bit shift (overrides single-bit function selected by the command bits) --
+    if (use_xshift_c = true) and (ctrl_i(ctrl_alu_xsh_c) = '1') then
+      alu_res <= xsh_res(15 downto 0);
+      flag_o(flag_c_c) <= xsh_res(16);
+      flag_o(flag_v_c) <= '0';
+      flag_o(flag_n_c) <= negative;
+      flag_o(flag_z_c) <= zero;
+    end if;
+
+    -- custom instruction (result computed by the CFU, flags are not updated) --
+    if (ctrl_i(ctrl_alu_cfu_c) = '1') then
+      alu_res <= cfu_i;
+    end if;
   end process alu_core;
 
 
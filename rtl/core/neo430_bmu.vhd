@@ -0,0 +1,111 @@
+-- #################################################################################################
+-- # << NEO430 - Bit Manipulation Unit >>                                                          #
+-- # ********************************************************************************************* #
+-- # Single-operation bit manipulation functions: Population count, count leading zeros, count     #
+-- # trailing zeros and bit reversal. Writing any register sets the operand; reading a register    #
+-- # returns the according function result of the current operand.                                 #
+-- # ********************************************************************************************* #
+-- # BSD 3-Clause License                                                                          #
+-- #                                                                                               #
+-- # Copyright (c) 2020, Stephan Nolting. All rights reserved.                                     #
+-- #                                                                                               #
+-- # Redistribution and use in source and binary forms, with or without modification, are          #
+-- # permitted provided that the following conditions are met:                                     #
+-- #                                                                                               #
+-- # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+-- #    conditions and the following disclaimer.                                                   #
+-- #                                                                                               #
+-- # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+-- #    conditions and the following disclaimer in the documentation and/or other materials        #
+-- #    provided with the distribution.                                                            #
+-- #                                                                                               #
+-- # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+-- #    endorse or promote products derived from this software without specific prior written      #
+-- #    permission.                                                                                #
+-- #                                                                                               #
+-- # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+-- # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+-- # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+-- # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+-- # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+-- # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+-- # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+-- # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+-- # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+-- # ********************************************************************************************* #
+-- # The NEO430 Processor - https://github.com/stnolting/neo430                                    #
+-- #################################################################################################
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library neo430;
+use neo430.neo430_package.all;
+
+entity neo430_bmu is
+  port (
+    -- host access --
+    clk_i  : in  std_ulogic; -- global clock line
+    rden_i : in  std_ulogic; -- read enable
+    wren_i : in  std_ulogic; -- write enable
+    addr_i : in  std_ulogic_vector(15 downto 0); -- address
+    data_i : in  std_ulogic_vector(15 downto 0); -- data in
+    data_o : out std_ulogic_vector(15 downto 0)  -- data out
+  );
+end neo430_bmu;
+
+architecture neo430_bmu_rtl of neo430_bmu is
+
+  -- IO space: module base address --
+  constant hi_abb_c : natural := index_size_f(io_size_c)-1; -- high address boundary bit
+  constant lo_abb_c : natural := index_size_f(bmu_size_c); -- low address boundary bit
+
+  -- access control --
+  signal acc_en : std_ulogic; -- module access enable
+  signal addr   : std_ulogic_vector(15 downto 0); -- access address
+  signal wren   : std_ulogic;
+
+  -- accessible registers --
+  signal opa : std_ulogic_vector(15 downto 0); -- operand
+
+begin
+
+  -- Access Control -----------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  acc_en <= '1' when (addr_i(hi_abb_c downto lo_abb_c) = bmu_base_c(hi_abb_c downto lo_abb_c)) else '0';
+  addr   <= bmu_base_c(15 downto lo_abb_c) & addr_i(lo_abb_c-1 downto 1) & '0'; -- word aligned
+  wren   <= acc_en and wren_i;
+
+
+  -- Write Access -------------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  write_access: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      if (wren = '1') then -- any register
+        opa <= data_i;
+      end if;
+    end if;
+  end process write_access;
+
+
+  -- Read Access --------------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  read_access: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      data_o <= (others => '0');
+      if (acc_en = '1') and (rden_i = '1') then
+        case addr is
+          when bmu_popc_addr_c => data_o <= std_ulogic_vector(to_unsigned(set_bits_f(opa), 16));
+          when bmu_clz_addr_c  => data_o <= std_ulogic_vector(to_unsigned(leading_zeros_f(opa), 16));
+          when bmu_ctz_addr_c  => data_o <= std_ulogic_vector(to_unsigned(leading_zeros_f(bit_reversal_f(opa)), 16));
+          when others          => data_o <= bit_reversal_f(opa); -- bmu_brev_addr_c
+        end case;
+      end if;
+    end if;
+  end process read_access;
+
+
+end neo430_bmu_rtl;
@@ -6,6 +6,8 @@
 -- # can only be accessed using full word (16-bit) accesses.                                       #
 -- # In the original state, this unit only provides 8 16-bit register, that do not perform any     #
 -- # kind of data manipulation.                                                                    #
+-- # Additionally, the CFU can implement up to 8 custom instructions (opcodes 0x18xx..0x1Fxx),     #
+-- # which operate directly on register file operands: Rdst <= CFU(function, Rsrc, Rdst).          #
 -- # Exemplary applications: Cryptography, complex arithmetic, rocket science, ...                 #
 -- # ********************************************************************************************* #
 -- # BSD 3-Clause License                                                                          #
@@ -57,7 +59,14 @@ entity neo430_cfu is
     data_o      : out std_ulogic_vector(15 downto 0); -- data out
     -- clock generator --
     clkgen_en_o : out std_ulogic; -- enable clock generator
-    clkgen_i    : in  std_ulogic_vector(07 downto 0)
+    clkgen_i    : in  std_ulogic_vector(07 downto 0);
+    -- custom instructions --
+    ci_req_i    : in  std_ulogic; -- start custom instruction
+    ci_fn_i     : in  std_ulogic_vector(02 downto 0); -- function select
+    ci_opa_i    : in  std_ulogic_vector(15 downto 0); -- operand A (source register)
+    ci_opb_i    : in  std_ulogic_vector(15 downto 0); -- operand B (destination register)
+    ci_res_o    : out std_ulogic_vector(15 downto 0); -- result
+    ci_ack_o    : out std_ulogic  -- result valid
     -- custom IOs --
 --  ...
   );
@@ -208,4 +217,50 @@ begin
   end process rd_access;
 
 
+  -- Custom Instructions ------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  -- The CPU executes the instruction word "0001 1fff ssss dddd" as custom instruction: It loads
+  -- operand A (ci_opa_i) from register Rssss and operand B (ci_opb_i) from register Rdddd and sets
+  -- ci_req_i for exactly one cycle. Operands and function select (ci_fn_i = fff) are valid during this
+  -- cycle and remain stable until the instruction has completed. The CPU waits until ci_ack_o is set
+  -- (this can be in the same cycle as ci_req_i) and writes ci_res_o to Rdddd in the following cycle,
+  -- so the result has to stay valid for one more cycle after ci_ack_o. The status flags are not altered.
+  -- Custom instructions are only available if the CFU is implemented (CFU_USE = true), otherwise
+  -- this opcode space is executed as NOP.
+
+  -- single-cycle operation --
+  ci_ack_o <= ci_req_i;
+
+  -- exemplary functions --
+  ci_core: process(ci_fn_i, ci_opa_i, ci_opb_i)
+    variable sum_v : unsigned(16 downto 0);
+  begin
+    sum_v := unsigned('0' & ci_opa_i) + unsigned('0' & ci_opb_i);
+    case ci_fn_i is
+      when "000" => -- unsigned average
+        ci_res_o <= std_ulogic_vector(sum_v(16 downto 1));
+      when "001" => -- unsigned minimum
+        if (unsigned(ci_opa_i) < unsigned(ci_opb_i)) then
+          ci_res_o <= ci_opa_i;
+        else
+          ci_res_o <= ci_opb_i;
+        end if;
+      when "010" => -- unsigned maximum
+        if (unsigned(ci_opa_i) > unsigned(ci_opb_i)) then
+          ci_res_o <= ci_opa_i;
+        else
+          ci_res_o <= ci_opb_i;
+        end if;
+      when "011" => -- unsigned saturating addition
+        if (sum_v(16) = '1') then
+          ci_res_o <= (others => '1');
+        else
+          ci_res_o <= std_ulogic_vector(sum_v(15 downto 0));
+        end if;
+      when others => -- not implemented
+        ci_res_o <= (others => '0');
+    end case;
+  end process ci_core;
+
+
 end neo430_cfu_rtl;
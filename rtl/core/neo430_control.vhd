@@ -42,19 +42,28 @@ library neo430;
 use neo430.neo430_package.all;
 
 entity neo430_control is
+  generic (
+    CFU_USE   : boolean := false -- implement CFU custom instructions?
+  );
   port (
     -- global control --
     clk_i     : in  std_ulogic; -- global clock, rising edge
     rst_i     : in  std_ulogic; -- global reset, low-active, async
     -- memory interface --
     instr_i   : in  std_ulogic_vector(15 downto 0); -- instruction word from memory
+    stall_i   : in  std_ulogic; -- memory access not completed yet, hold CPU state
     -- control --
     sreg_i    : in  std_ulogic_vector(15 downto 0); -- current status register
+    rf_i      : in  std_ulogic_vector(03 downto 0); -- register file read data (MSP430X RPT Rn: repetition count)
     ctrl_o    : out std_ulogic_vector(ctrl_width_c-1 downto 0); -- control signals
     irq_vec_o : out std_ulogic_vector(01 downto 0); -- irq channel address
     imm_o     : out std_ulogic_vector(15 downto 0); -- branch offset
+    -- custom instructions --
+    cfu_fn_o  : out std_ulogic_vector(02 downto 0); -- CFU function select
+    cfu_ack_i : in  std_ulogic; -- CFU result valid
     -- irq lines --
-    irq_i     : in  std_ulogic_vector(03 downto 0)  -- IRQ lines^
+    irq_i     : in  std_ulogic_vector(03 downto 0); -- IRQ lines
+    irq_ack_o : out std_ulogic_vector(03 downto 0)  -- IRQ handler started (vector fetch)
   );
 end neo430_control;
 
@@ -71,7 +80,8 @@ architecture neo430_control_rtl of neo430_control is
   type state_t is (RESET, IFETCH_0, IFETCH_1, DECODE,
     TRANS_0, TRANS_1, TRANS_2, TRANS_3, TRANS_4, TRANS_5, TRANS_6,
     PUSHCALL_0, PUSHCALL_1, PUSHCALL_2,
-    RETI_0, RETI_1, RETI_2, RETI_3,
+    PUSHM_0, PUSHM_1, PUSHM_2, POPM_0, POPM_1, POPM_2, POPM_3,
+    RETI_0, RETI_1, RETI_2, RETI_3, CFU_0, CFU_1, XEXT_0,
     IRQ_0, IRQ_1, IRQ_2, IRQ_3, IRQ_4, IRQ_5);
   signal state, state_nxt  : state_t;
   signal ctrl_nxt, ctrl    : std_ulogic_vector(ctrl_width_c-1 downto 0);
@@ -79,6 +89,12 @@ architecture neo430_control_rtl of neo430_control is
   signal mem_rd, mem_rd_ff : std_ulogic; -- memory read buffers
   signal src_nxt, src      : std_ulogic_vector(03 downto 0); -- source reg
   signal sam_nxt, sam      : std_ulogic_vector(01 downto 0); -- CMD according SRC addressing mode
+  signal mcnt_nxt, mcnt    : std_ulogic_vector(03 downto 0); -- PUSHM/POPM: number of remaining registers
+
+  -- MSP430X extension word (register mode: RPT/ZC) --
+  signal xext_nxt, xext    : std_ulogic; -- extension word pending for next instruction
+  signal xir_nxt, xir      : std_ulogic_vector(08 downto 0); -- (8) ZC, (7) #/Rn, (6) A/L, (3:0) executions - 1 / register
+  signal rcnt_nxt, rcnt    : std_ulogic_vector(03 downto 0); -- number of remaining repetitions
 
   -- irq system --
   signal irq_fire               : std_ulogic;
@@ -117,8 +133,12 @@ begin
     -- the arbiter requires a defined initial state
     if (rst_i = '0') then
       state <= RESET; -- this is crucial!
+      xext  <= '0';
     elsif rising_edge(clk_i) then
-      state <= state_nxt;
+      if (stall_i = '0') then
+        state <= state_nxt;
+        xext  <= xext_nxt;
+      end if;
     end if;
   end process arbiter_sync0;
 
@@ -126,33 +146,68 @@ begin
   begin
     if rising_edge(clk_i) then
       -- these signals do not need a specific reset state
-      ctrl      <= ctrl_nxt;
-      src       <= src_nxt;
-      mem_rd_ff <= mem_rd;
-      am        <= am_nxt;
-      sam       <= sam_nxt;
-      if (ir_wren = '1') then
-        ir <= instr_i; -- instruction register
+      if (stall_i = '0') then
+        ctrl      <= ctrl_nxt;
+        src       <= src_nxt;
+        mem_rd_ff <= mem_rd;
+        am        <= am_nxt;
+        sam       <= sam_nxt;
+        mcnt      <= mcnt_nxt;
+        xir       <= xir_nxt;
+        rcnt      <= rcnt_nxt;
+        if (ir_wren = '1') then
+          ir <= instr_i; -- instruction register
+        end if;
       end if;
     end if;
   end process arbiter_sync1;
 
-  -- control bus output --
-  ctrl_o <= ctrl;
+  -- control bus output: no state updates and no memory accesses while waiting for memory --
+  ctrl_output: process(ctrl, stall_i)
+  begin
+    ctrl_o <= ctrl;
+    if (stall_i = '1') then
+      ctrl_o(ctrl_rf_fup_c)     <= '0';
+      ctrl_o(ctrl_rf_wb_en_c)   <= '0';
+      ctrl_o(ctrl_rf_dsleep_c)  <= '0';
+      ctrl_o(ctrl_rf_dgie_c)    <= '0';
+      ctrl_o(ctrl_rf_bank_c)    <= '0';
+      ctrl_o(ctrl_alu_opa_wr_c) <= '0';
+      ctrl_o(ctrl_alu_opb_wr_c) <= '0';
+      ctrl_o(ctrl_adr_mar_wr_c) <= '0';
+      ctrl_o(ctrl_mem_wr_c)     <= '0';
+      ctrl_o(ctrl_mem_rd_c)     <= '0';
+      ctrl_o(ctrl_cfu_start_c)  <= '0';
+    end if;
+  end process ctrl_output;
+
+  -- custom instruction function select --
+  cfu_fn_o <= ir(10 downto 8);
 
-  -- someone using the DADD instruction? --
+  -- someone using the DADD instruction although it is not implemented? --
   dadd_sanity_check: process(ir)
   begin
-    if (ir(15 downto 12) = "1010") then -- DADD
-      assert false report "DADD instruction not supported!" severity warning;
+    if (ir(15 downto 12) = alu_dadd_c) and (use_dadd_c = false) then -- DADD
+      assert false report "DADD instruction not implemented (use_dadd_c = false)!" severity warning;
     end if;
   end process dadd_sanity_check;
 
 
+  -- CFU custom instructions use the MSP430X extension word space --
+  xext_sanity_check: process(clk_i)
+  begin
+    if (CFU_USE = true) and (use_xshift_c = true) then
+      assert false report "CFU custom instructions use the MSP430X extension word space - RPT/extended instructions are not available!" severity warning;
+    end if;
+  end process xext_sanity_check;
+
+
   -- Arbiter State Machine Comb -----------------------------------------------
   -- -----------------------------------------------------------------------------
-  arbiter_comb: process(state, instr_i, ir, ctrl, branch_taken, src, am, sam, mem_rd_ff, irq_start, sreg_i)
+  arbiter_comb: process(state, instr_i, ir, ctrl, branch_taken, src, am, sam, mcnt, mem_rd_ff, irq_start, irq_vec, sreg_i, cfu_ack_i,
+                        xext, xir, rcnt, rf_i)
     variable spec_cmd_v, valid_wb_v, move_cmd_v : std_ulogic;
+    variable xreg_mode_v : std_ulogic;
   begin
 
     -- NOTES --
@@ -165,6 +220,10 @@ begin
     src_nxt   <= src; -- source reg
     am_nxt    <= am;  -- total addressing mode [OP class I/II, src_addr_mode(1), src_addr_mode(0), dst_addr_mode]
     sam_nxt   <= sam; -- default source addressing mode
+    mcnt_nxt  <= mcnt; -- PUSHM/POPM register counter
+    xext_nxt  <= xext; -- extension word pending
+    xir_nxt   <= xir; -- extension word
+    rcnt_nxt  <= rcnt; -- remaining repetitions
     ir_wren   <= '0'; -- write to instruction register
     mem_rd    <= '0'; -- normal ("slow") memory read
     irq_ack   <= '0'; -- ack irq to irq-controller
@@ -177,6 +236,9 @@ begin
     ctrl_nxt(ctrl_adr_off2_c downto ctrl_adr_off0_c) <= "010"; -- add +2 as address offset
     ctrl_nxt(ctrl_mem_rd_c) <= mem_rd_ff; -- delayed memory read
     ctrl_nxt(ctrl_alu_bw_c) <= ctrl(ctrl_alu_bw_c); -- keep byte/word mode
+    ctrl_nxt(ctrl_alu_xsh_n1_c downto ctrl_alu_xsh_c) <= ctrl(ctrl_alu_xsh_n1_c downto ctrl_alu_xsh_c); -- keep multi-bit shift config
+    ctrl_nxt(ctrl_alu_cfu_c) <= ctrl(ctrl_alu_cfu_c); -- keep custom instruction mode
+    ctrl_nxt(ctrl_alu_zc_c) <= ctrl(ctrl_alu_zc_c); -- keep zero carry mode
 
     -- special single ALU operation? --
     spec_cmd_v := '0';
@@ -197,6 +259,16 @@ begin
       valid_wb_v := '0'; -- CMP and BIT instructions only write status flags
     end if;
 
+    -- extended instruction in register mode? (repetition and ZC only apply to register mode) --
+    xreg_mode_v := '0';
+    if (xext = '1') and (use_xshift_c = true) then
+      if (instr_i(15 downto 14) /= "00") then -- format I: SRC and DST register direct
+        xreg_mode_v := not (instr_i(7) or instr_i(5) or instr_i(4));
+      elsif (instr_i(13 downto 10) = "0100") and (instr_i(9) = '0') then -- format II (RRC/SWPB/RRA/SXT): register direct
+        xreg_mode_v := not (instr_i(5) or instr_i(4));
+      end if;
+    end if;
+
     -- state machine --
     case state is
 
@@ -212,11 +284,14 @@ begin
       -- ------------------------------------------------------------
         sam_nxt <= "00"; -- SRC address mode = REG, required for all special operations + IRQ
         ctrl_nxt(ctrl_alu_bw_c) <= '0'; -- word mode, also required for all IRQ states
+        ctrl_nxt(ctrl_alu_xsh_c) <= '0'; -- no multi-bit shift, also required for all IRQ states
+        ctrl_nxt(ctrl_alu_cfu_c) <= '0'; -- no custom instruction, also required for all IRQ states
+        ctrl_nxt(ctrl_alu_zc_c) <= '0'; -- no zero carry mode, also required for all IRQ states
         ctrl_nxt(ctrl_rf_adr3_c downto ctrl_rf_adr0_c) <= reg_pc_c; -- source/destination: PC
         ctrl_nxt(ctrl_adr_off2_c downto ctrl_adr_off0_c) <= "010"; -- add +2
         ctrl_nxt(ctrl_rf_in_sel_c) <= '1'; -- select addr gen feedback
         ctrl_nxt(ctrl_adr_bp_en_c) <= '1'; -- directly output PC/IRQ vector
-        if (irq_start = '1') then -- execute IRQ
+        if (irq_start = '1') and (xext = '0') then -- execute IRQ (not between extension word and instruction)
           state_nxt <= IRQ_0;
         elsif (sreg_i(sreg_s_c) = '0') then -- no sleep mode = normal execution
           ctrl_nxt(ctrl_mem_rd_c) <= '1'; -- Memory read (fast)
@@ -237,6 +312,18 @@ begin
         ctrl_nxt(ctrl_rf_adr3_c downto ctrl_rf_adr0_c) <= reg_pc_c; -- source/destination: PC (used by branch instructions only)
         ctrl_nxt(ctrl_adr_off2_c downto ctrl_adr_off0_c) <= "000"; -- add immediate offset (used by branch instructions only)
         ctrl_nxt(ctrl_rf_in_sel_c) <= '1'; -- select addr gen feedback (used by branch instructions only)
+        -- MSP430X extension word of previous cycle --
+        xext_nxt <= '0'; -- consumed by this instruction
+        rcnt_nxt <= (others => '0'); -- no repetition
+        if (xext = '1') and (use_xshift_c = true) then
+          if (xir(6) = '0') then -- A/L = 0: address-word (.A) executed as .W
+            ctrl_nxt(ctrl_alu_bw_c) <= '0';
+          end if;
+          if (xreg_mode_v = '1') then -- register mode: repetition count and zero carry
+            rcnt_nxt <= xir(3 downto 0);
+            ctrl_nxt(ctrl_alu_zc_c) <= xir(8);
+          end if;
+        end if;
 
         if (instr_i(15 downto 14) = "00") then -- branch or format II instruction
           if (instr_i(13) = '1') then -- BRANCH INSTRUCTION
@@ -267,6 +354,52 @@ begin
               when others => state_nxt <= TRANS_0;  -- single ALU OP (FORMAT II)
             end case;
 
+          elsif (instr_i(12 downto 10) = "101") and (use_pushm_c = true) then -- MULTI-REGISTER PUSH/POP (MSP430X: PUSHM/POPM)
+            -- ------------------------------------------------------------
+            sam_nxt  <= "00"; -- SRC address mode = REG
+            src_nxt  <= instr_i(3 downto 0); -- first register (PUSHM: highest, POPM: lowest)
+            mcnt_nxt <= instr_i(7 downto 4); -- number of registers - 1
+            ctrl_nxt(ctrl_alu_bw_c) <= '0'; -- word mode only (.A is executed as .W)
+            ctrl_nxt(ctrl_alu_cmd3_c downto ctrl_alu_cmd0_c) <= alu_mov_c; -- keep this for all following states
+            if (instr_i(9) = '0') then
+              state_nxt <= PUSHM_0;
+            else
+              state_nxt <= POPM_0;
+            end if;
+
+          elsif (instr_i(12) = '0') and (instr_i(7 downto 5) = "010") and (use_xshift_c = true) then -- MULTI-BIT SHIFT (MSP430X: RRCM/RRAM/RLAM/RRUM)
+            -- ------------------------------------------------------------
+            am_nxt  <= "0000"; -- class II, SRC/DST: register direct
+            sam_nxt <= "00"; -- SRC address mode = REG
+            src_nxt <= instr_i(3 downto 0); -- src is also dst
+            ctrl_nxt(ctrl_alu_bw_c) <= '0'; -- word mode only (.A is executed as .W)
+            ctrl_nxt(ctrl_alu_cmd3_c downto ctrl_alu_cmd0_c) <= "00" & instr_i(9 downto 8); -- shift type
+            ctrl_nxt(ctrl_alu_xsh_c) <= '1'; -- use barrel shifter
+            ctrl_nxt(ctrl_alu_xsh_n1_c downto ctrl_alu_xsh_n0_c) <= instr_i(11 downto 10); -- number of shifts - 1
+            state_nxt <= TRANS_0;
+
+          elsif (instr_i(12 downto 11) = "11") and (CFU_USE = true) then -- CUSTOM INSTRUCTION (CFU, MSP430X extension word space)
+            -- ------------------------------------------------------------
+            am_nxt  <= "1000"; -- class I, SRC/DST: register direct
+            sam_nxt <= "00"; -- SRC address mode = REG
+            src_nxt <= instr_i(7 downto 4); -- source register, destination register is ir(3:0)
+            ctrl_nxt(ctrl_alu_bw_c) <= '0'; -- word mode only
+            ctrl_nxt(ctrl_alu_cmd3_c downto ctrl_alu_cmd0_c) <= alu_mov_c; -- no ALU processing
+            ctrl_nxt(ctrl_alu_cfu_c) <= '1'; -- use CFU result
+            state_nxt <= TRANS_0;
+
+          elsif (instr_i(12 downto 11) = "11") and (use_xshift_c = true) then -- EXTENSION WORD (MSP430X, register mode: RPT/ZC)
+            -- ------------------------------------------------------------
+            -- address extension bits (non-register mode) are always zero for the 16-bit address space
+            xext_nxt <= '1'; -- applies to next instruction
+            xir_nxt  <= instr_i(8 downto 0);
+            ctrl_nxt(ctrl_rf_adr3_c downto ctrl_rf_adr0_c) <= instr_i(3 downto 0); -- RPT Rn: get repetition count
+            if (instr_i(7) = '1') then -- RPT Rn
+              state_nxt <= XEXT_0;
+            else -- RPT #n (or no repetition)
+              state_nxt <= IFETCH_0;
+            end if;
+
           else -- !!!UNDEFINED OPCODE!!!
             -- ------------------------------------------------------------
             state_nxt <= IFETCH_0;
@@ -283,7 +416,7 @@ begin
           am_nxt(0) <= instr_i(7); -- dst addressing mode
           ctrl_nxt(ctrl_alu_cmd3_c downto ctrl_alu_cmd0_c) <= instr_i(15 downto 12); -- ALU function
           src_nxt <= instr_i(11 downto 8);
-          if (instr_i(15 downto 12) = "1010") then -- !!!INVALID ALUOP!!!
+          if (instr_i(15 downto 12) = alu_dadd_c) and (use_dadd_c = false) then -- !!!INVALID ALUOP!!! (DADD not implemented)
             state_nxt <= IFETCH_0;
           else
             state_nxt <= TRANS_0;
@@ -309,6 +442,15 @@ begin
               state_nxt <= PUSHCALL_0;
             elsif (am(3) = '0') then -- CLASS II operation
               state_nxt <= TRANS_6;
+            elsif (use_dual_rf_c = true) then -- CLASS I: fetch both register operands at once
+              ctrl_nxt(ctrl_rf_badr3_c downto ctrl_rf_badr0_c) <= ir(3 downto 0); -- port B: reg B
+              ctrl_nxt(ctrl_alu_opb_rfb_c) <= '1'; -- OpB from RF read port B
+              ctrl_nxt(ctrl_alu_opb_wr_c) <= '1'; -- write OpB
+              if (ctrl(ctrl_alu_cfu_c) = '1') then -- custom instruction
+                state_nxt <= CFU_0;
+              else
+                state_nxt <= TRANS_6;
+              end if;
             else
               state_nxt <= TRANS_3;
             end if;
@@ -469,6 +611,8 @@ begin
             ctrl_nxt(ctrl_alu_opb_wr_c) <= '1'; -- write OpB
             if (am(2 downto 1) = "01") then
               state_nxt <= TRANS_4;
+            elsif (ctrl(ctrl_alu_cfu_c) = '1') then -- custom instruction
+              state_nxt <= CFU_0;
             else
               state_nxt <= TRANS_6;
             end if;
@@ -530,7 +674,32 @@ begin
         else -- DST: indexed (memory)
           ctrl_nxt(ctrl_mem_wr_c) <= valid_wb_v; -- valid MEM write back (not for CMP/BIT!)
         end if;
-        state_nxt <= IFETCH_0; -- done!
+        if (use_xshift_c = true) and (rcnt /= "0000") then -- MSP430X RPT: execute instruction again (register mode only)
+          rcnt_nxt  <= std_ulogic_vector(unsigned(rcnt) - 1);
+          state_nxt <= TRANS_0;
+        else
+          state_nxt <= IFETCH_0; -- done!
+        end if;
+
+
+      when XEXT_0 => -- extension word cycle 0: get repetition count from register (RPT Rn)
+      -- ------------------------------------------------------------
+        xir_nxt(3 downto 0) <= rf_i; -- Rn(3:0) = number of executions - 1
+        state_nxt <= IFETCH_0;
+
+
+      when CFU_0 => -- custom instruction cycle 0: start CFU (operands are valid in next cycle)
+      -- ------------------------------------------------------------
+        ctrl_nxt(ctrl_cfu_start_c) <= '1'; -- start custom instruction
+        state_nxt <= CFU_1;
+
+      when CFU_1 => -- custom instruction cycle 1: wait for CFU & RF write-back
+      -- ------------------------------------------------------------
+        ctrl_nxt(ctrl_rf_adr3_c downto ctrl_rf_adr0_c) <= ir(3 downto 0); -- destination
+        if (cfu_ack_i = '1') then
+          ctrl_nxt(ctrl_rf_wb_en_c) <= '1'; -- valid RF write back (no flag update)
+          state_nxt <= IFETCH_0; -- done!
+        end if;
 
 
       when PUSHCALL_0 => -- PUSH/CALL cycle 0 (stack update)
@@ -561,6 +730,77 @@ begin
         state_nxt <= IFETCH_0; -- done!
 
 
+      when PUSHM_0 => -- PUSHM cycle 0: SP=SP-2
+      -- ------------------------------------------------------------
+        ctrl_nxt(ctrl_rf_adr3_c downto ctrl_rf_adr0_c) <= reg_sp_c; -- source/destination: SP
+        ctrl_nxt(ctrl_adr_off2_c downto ctrl_adr_off0_c) <= "011"; -- add -2
+        ctrl_nxt(ctrl_adr_mar_wr_c) <= '1'; -- write to MAR
+        ctrl_nxt(ctrl_adr_mar_sel_c) <= '1'; -- use result from adder
+        ctrl_nxt(ctrl_rf_in_sel_c) <= '1'; -- select addr gen feedback
+        ctrl_nxt(ctrl_rf_wb_en_c) <= '1'; -- valid RF write back
+        state_nxt <= PUSHM_1;
+
+      when PUSHM_1 => -- PUSHM cycle 1: Buffer current register for memory write; select next register
+      -- ------------------------------------------------------------
+        ctrl_nxt(ctrl_alu_opa_wr_c) <= '1'; -- write to OpA
+        src_nxt  <= std_ulogic_vector(unsigned(src) - 1); -- next (lower) register
+        mcnt_nxt <= std_ulogic_vector(unsigned(mcnt) - 1);
+        if (mcnt = "0000") then -- last register
+          state_nxt <= PUSHCALL_2; -- final memory write
+        else
+          state_nxt <= PUSHM_2;
+        end if;
+
+      when PUSHM_2 => -- PUSHM cycle 2: Write buffered register to memory (push), SP=SP-2
+      -- ------------------------------------------------------------
+        ctrl_nxt(ctrl_mem_wr_c) <= '1'; -- memory write request
+        ctrl_nxt(ctrl_rf_adr3_c downto ctrl_rf_adr0_c) <= reg_sp_c; -- source/destination: SP
+        ctrl_nxt(ctrl_adr_off2_c downto ctrl_adr_off0_c) <= "011"; -- add -2
+        ctrl_nxt(ctrl_adr_mar_wr_c) <= '1'; -- write to MAR
+        ctrl_nxt(ctrl_adr_mar_sel_c) <= '1'; -- use result from adder
+        ctrl_nxt(ctrl_rf_in_sel_c) <= '1'; -- select addr gen feedback
+        ctrl_nxt(ctrl_rf_wb_en_c) <= '1'; -- valid RF write back
+        state_nxt <= PUSHM_1;
+
+
+      when POPM_0 | POPM_2 => -- POPM cycle 0/2: Output address of stack top; SP=SP+2
+      -- ------------------------------------------------------------
+        ctrl_nxt(ctrl_rf_adr3_c downto ctrl_rf_adr0_c) <= reg_sp_c; -- source/destination: SP
+        ctrl_nxt(ctrl_adr_bp_en_c) <= '1'; -- directly output RF.out to address bus
+        ctrl_nxt(ctrl_mem_rd_c) <= '1'; -- Memory read (fast)
+        ctrl_nxt(ctrl_adr_off2_c downto ctrl_adr_off0_c) <= "010"; -- add +2
+        ctrl_nxt(ctrl_rf_in_sel_c) <= '1'; -- select addr gen feedback
+        ctrl_nxt(ctrl_rf_wb_en_c) <= '1'; -- valid RF write back
+        if (state = POPM_0) then
+          state_nxt <= POPM_1;
+        else
+          state_nxt <= POPM_3;
+        end if;
+
+      when POPM_1 => -- POPM cycle 1: Buffer first stack word from MEM in OpA
+      -- ------------------------------------------------------------
+        ctrl_nxt(ctrl_alu_in_sel_c) <= '1'; -- get data from memory
+        ctrl_nxt(ctrl_alu_opa_wr_c) <= '1'; -- write to OpA
+        if (mcnt = "0000") then -- single register
+          state_nxt <= POPM_3;
+        else
+          state_nxt <= POPM_2;
+        end if;
+
+      when POPM_3 => -- POPM cycle 3: Write buffered word to current register; buffer next stack word from MEM in OpA
+      -- ------------------------------------------------------------
+        ctrl_nxt(ctrl_rf_wb_en_c) <= '1'; -- valid RF write back
+        ctrl_nxt(ctrl_alu_in_sel_c) <= '1'; -- get data from memory
+        src_nxt  <= std_ulogic_vector(unsigned(src) + 1); -- next (higher) register
+        mcnt_nxt <= std_ulogic_vector(unsigned(mcnt) - 1);
+        if (mcnt = "0000") then -- last register
+          state_nxt <= IFETCH_0; -- done!
+        else
+          ctrl_nxt(ctrl_alu_opa_wr_c) <= '1'; -- write to OpA
+          state_nxt <= POPM_2;
+        end if;
+
+
       when RETI_0 => -- RETI cycle 0: Output address of old SR; SP=SP+2
       -- ------------------------------------------------------------
         ctrl_nxt(ctrl_alu_cmd3_c downto ctrl_alu_cmd0_c) <= alu_mov_c; -- keep this for all following states
@@ -636,6 +876,7 @@ begin
         ctrl_nxt(ctrl_adr_ivec_oe_c) <= '1'; -- output IRQ vector
         ctrl_nxt(ctrl_mem_rd_c)      <= '1'; -- Memory read (fast)
         ctrl_nxt(ctrl_rf_dgie_c)     <= '1'; -- disable interrupt enable flag
+        ctrl_nxt(ctrl_rf_bank_c)     <= shadow_rf_irq_c(to_integer(unsigned(irq_vec))); -- switch to shadow register bank?
         irq_ack                      <= '1'; -- acknowledge started IRQ handler
         state_nxt <= IRQ_4;
 
@@ -682,7 +923,7 @@ begin
           irq_start <= '1';
         end if;
       else -- active IRQ
-        if (irq_ack = '1') then -- handler started?
+        if (irq_ack = '1') and (stall_i = '0') then -- handler started?
           irq_start <= '0';
         end if;
       end if;
@@ -693,10 +934,10 @@ begin
   irq_fire <= '1' when (irq_buf /= "0000") and (i_flag_ff1 = '1') and (sreg_i(sreg_i_c) = '1') else '0';
 
   -- acknowledge mask --
-  irq_ack_mask_gen: process(irq_ack, irq_vec)
+  irq_ack_mask_gen: process(irq_ack, irq_vec, stall_i)
     variable irq_tmp_v : std_ulogic_vector(2 downto 0);
   begin
-    irq_tmp_v := irq_ack & irq_vec;
+    irq_tmp_v := (irq_ack and (not stall_i)) & irq_vec;
     case irq_tmp_v is
       when "100"  => irq_ack_mask <= "0001";
       when "101"  => irq_ack_mask <= "0010";
@@ -725,5 +966,8 @@ begin
   -- interrupt vector output --
   irq_vec_o <= irq_vec; -- the final address is constructed in the address generator
 
+  -- interrupt handler started (used by the EXIRQ controller in vectored mode) --
+  irq_ack_o <= irq_ack_mask;
+
 
 end neo430_control_rtl;
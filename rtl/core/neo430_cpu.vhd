@@ -43,8 +43,9 @@ use neo430.neo430_package.all;
 
 entity neo430_cpu is
   generic (
-    BOOTLD_USE  : boolean := true; -- implement and use bootloader?
-    IMEM_AS_ROM : boolean := false -- implement IMEM as read-only memory?
+    BOOTLD_USE  : boolean := true;  -- implement and use bootloader?
+    IMEM_AS_ROM : boolean := false; -- implement IMEM as read-only memory?
+    CFU_USE     : boolean := false  -- implement CFU custom instructions?
   );
   port (
     -- global control --
@@ -57,8 +58,18 @@ entity neo430_cpu is
     mem_addr_o : out std_ulogic_vector(15 downto 0); -- address
     mem_data_o : out std_ulogic_vector(15 downto 0); -- write data
     mem_data_i : in  std_ulogic_vector(15 downto 0); -- read data
+    mem_wait_i : in  std_ulogic; -- memory access not completed yet, stall CPU
     -- interrupt system --
-    irq_i      : in  std_ulogic_vector(03 downto 0)  -- interrupt requests
+    irq_i      : in  std_ulogic_vector(03 downto 0); -- interrupt requests
+    irq_ack_o  : out std_ulogic_vector(03 downto 0); -- interrupt handler started
+    xirq_sel_i : in  std_ulogic_vector(03 downto 0); -- external IRQ vector (3: vectored mode, 2..0: source)
+    -- custom instruction interface --
+    cfu_req_o  : out std_ulogic; -- start custom instruction
+    cfu_fn_o   : out std_ulogic_vector(02 downto 0); -- function select
+    cfu_opa_o  : out std_ulogic_vector(15 downto 0); -- operand A (source register)
+    cfu_opb_o  : out std_ulogic_vector(15 downto 0); -- operand B (destination register)
+    cfu_res_i  : in  std_ulogic_vector(15 downto 0); -- result
+    cfu_ack_i  : in  std_ulogic  -- result valid
   );
 end neo430_cpu;
 
@@ -74,9 +85,12 @@ architecture neo430_cpu_rtl of neo430_cpu is
   signal alu_flags : std_ulogic_vector(04 downto 0); -- new ALU flags
   signal imm       : std_ulogic_vector(15 downto 0); -- branch offset
   signal rf_read   : std_ulogic_vector(15 downto 0); -- RF read data
+  signal rf_read_b : std_ulogic_vector(15 downto 0); -- RF read data, port B
   signal alu_res   : std_ulogic_vector(15 downto 0); -- ALU result
   signal addr_fb   : std_ulogic_vector(15 downto 0); -- address feedback
   signal irq_sel   : std_ulogic_vector(01 downto 0); -- IRQ vector
+  signal irq_ack   : std_ulogic_vector(03 downto 0); -- IRQ handler started
+  signal xirq_sel  : std_ulogic_vector(03 downto 0); -- external IRQ vector, captured at acknowledge
   signal dio_swap  : std_ulogic; -- data in/out swap
   signal bw_ff     : std_ulogic; -- byte/word access flag
   signal rd_ff     : std_ulogic; -- is read access
@@ -86,21 +100,45 @@ begin
   -- Control Unit -------------------------------------------------------------
   -- -----------------------------------------------------------------------------
   neo430_control_inst: neo430_control
+  generic map (
+    CFU_USE    => CFU_USE     -- implement CFU custom instructions?
+  )
   port map (
     -- global control --
     clk_i      => clk_i,      -- global clock, rising edge
     rst_i      => rst_i,      -- global reset, low-active, async
     -- memory interface --
     instr_i    => mem_data_i, -- instruction word from memory
+    stall_i    => mem_wait_i, -- memory access not completed yet
     -- control --
     sreg_i     => sreg,       -- current status register
+    rf_i       => rf_read(3 downto 0), -- register file read data (RPT Rn)
     ctrl_o     => ctrl_bus,   -- control signals
     irq_vec_o  => irq_sel,    -- irq channel address
     imm_o      => imm,        -- branch offset
+    -- custom instructions --
+    cfu_fn_o   => cfu_fn_o,   -- CFU function select
+    cfu_ack_i  => cfu_ack_i,  -- CFU result valid
     -- irq lines --
-    irq_i      => irq_i       -- IRQ lines
+    irq_i      => irq_i,      -- IRQ lines
+    irq_ack_o  => irq_ack     -- IRQ handler started
   );
 
+  -- IRQ acknowledge output --
+  irq_ack_o <= irq_ack;
+
+  -- External IRQ vector buffer --
+  -- The EXIRQ controller clears its state with the acknowledge and might select a new source while
+  -- the vector read is still pending (memory wait states), so use the source captured at acknowledge.
+  xirq_sel_buffer: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      if (irq_ack /= "0000") then
+        xirq_sel <= xirq_sel_i;
+      end if;
+    end if;
+  end process xirq_sel_buffer;
+
 
   -- Register File ------------------------------------------------------------
   -- -----------------------------------------------------------------------------
@@ -120,7 +158,8 @@ begin
     -- control --
     ctrl_i     => ctrl_bus,   -- control signals
     -- data output --
-    data_o     => rf_read,    -- read data
+    data_o     => rf_read,    -- read data (port A)
+    datb_o     => rf_read_b,  -- read data (port B)
     sreg_o     => sreg        -- current SR
   );
 
@@ -133,10 +172,15 @@ begin
     clk_i      => clk_i,      -- global clock, rising edge
     -- operands --
     reg_i      => rf_read,    -- data from reg file
+    regb_i     => rf_read_b,  -- data from reg file read port B
     mem_i      => mdi,        -- data from memory
     sreg_i     => sreg,       -- current SR
     -- control --
     ctrl_i     => ctrl_bus,   -- control signals
+    -- custom instructions --
+    opa_o      => cfu_opa_o,  -- operand A (source register)
+    opb_o      => cfu_opb_o,  -- operand B (destination register)
+    cfu_i      => cfu_res_i,  -- CFU result
     -- results --
     data_o     => alu_res,    -- result
     flag_o     => alu_flags   -- new ALU flags
@@ -154,6 +198,7 @@ begin
     mem_i      => mdi,        -- memory input
     imm_i      => imm,        -- branch offset
     irq_sel_i  => irq_sel,    -- IRQ vector
+    xirq_sel_i => xirq_sel,   -- external IRQ vector (captured)
     -- control --
     ctrl_i     => ctrl_bus,   -- control signals
     -- data output --
@@ -167,9 +212,11 @@ begin
   memory_control: process(clk_i)
   begin
     if rising_edge(clk_i) then
-      bw_ff    <= ctrl_bus(ctrl_alu_bw_c);
-      dio_swap <= ctrl_bus(ctrl_alu_bw_c) and mem_addr(0);
-      rd_ff    <= ctrl_bus(ctrl_mem_rd_c);
+      if (mem_wait_i = '0') then -- keep configuration of pending access
+        bw_ff    <= ctrl_bus(ctrl_alu_bw_c);
+        dio_swap <= ctrl_bus(ctrl_alu_bw_c) and mem_addr(0);
+        rd_ff    <= ctrl_bus(ctrl_mem_rd_c);
+      end if;
     end if;
   end process memory_control;
 
@@ -192,5 +239,8 @@ begin
   -- address output --
   mem_addr_o <= mem_addr(15 downto 1) & '0'; -- word-aligned addresses only beyond this point
 
+  -- custom instruction trigger --
+  cfu_req_o <= ctrl_bus(ctrl_cfu_start_c);
+
 
 end neo430_cpu_rtl;
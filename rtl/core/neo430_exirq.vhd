@@ -10,8 +10,11 @@
 -- # start the according handler function.                                                         #
 -- # If several IRQs occur at the same time, the one with highest priority is executed while the   #
 -- # others are kept in a buffer. The buffer is reset when the global enable flag of the unit is   #
--- # cleared. ext_irq_i(0) has highest priority while ext_irq_i(7) has the lowest priority.        #
+-- # cleared. Channels with their PRIO bit set are preferred over all other channels. Within the   #
+-- # same priority level ext_irq_i(0) has highest priority while ext_irq_i(7) has the lowest one.  #
 -- # Each enabled interrupt channel can also be triggered by software using the sw_irq_x bits.     #
+-- # In vectored mode the CPU fetches the handler address directly from a per-channel vector table #
+-- # (DMEM + 8 + 2*source) and the interrupt is acknowledged automatically by the vector fetch.    #
 -- # ********************************************************************************************* #
 -- # BSD 3-Clause License                                                                          #
 -- #                                                                                               #
@@ -62,6 +65,8 @@ entity neo430_exirq is
     data_o    : out std_ulogic_vector(15 downto 0); -- data out
     -- cpu interrupt --
     cpu_irq_o : out std_ulogic;
+    cpu_ack_i : in  std_ulogic; -- CPU has started the interrupt handler
+    cpu_vec_o : out std_ulogic_vector(3 downto 0); -- vectored mode & IRQ source
     -- external interrupt lines --
     ext_irq_i : in  std_ulogic_vector(7 downto 0); -- IRQ, triggering on HIGH level
     ext_ack_o : out std_ulogic_vector(7 downto 0)  -- acknowledge
@@ -77,6 +82,7 @@ architecture neo430_exirq_rtl of neo430_exirq is
   constant ctrl_en_c       : natural :=  3; -- r/w: unit enable
   constant ctrl_sw_irq_c   : natural :=  4; -- -/w: use irq_sel as SW IRQ trigger, auto-clears
   constant ctrl_ack_irq_c  : natural :=  5; -- -/w: ACK current IRQ, auto-clears
+  constant ctrl_vec_c      : natural :=  6; -- r/w: vectored mode (hardware dispatch + auto ACK)
   -- ...
   constant ctrl_en_irq0_c  : natural :=  8; -- r/w: IRQ channel 0 enable
   constant ctrl_en_irq1_c  : natural :=  9; -- r/w: IRQ channel 1 enable
@@ -90,15 +96,22 @@ architecture neo430_exirq_rtl of neo430_exirq is
   -- IO space: module base address --
   constant hi_abb_c : natural := index_size_f(io_size_c)-1; -- high address boundary bit
   constant lo_abb_c : natural := index_size_f(exirq_size_c); -- low address boundary bit
+  constant lo_abb_ext_c : natural := index_size_f(exirq_ext_size_c); -- low address boundary bit (extension registers)
 
   -- access control --
-  signal acc_en : std_ulogic; -- module access enable
-  signal wren   : std_ulogic; -- full word write enable
-  signal rden   : std_ulogic; -- read enable
+  signal acc_en     : std_ulogic; -- module access enable
+  signal acc_ext_en : std_ulogic; -- module extension registers access enable
+  signal addr_ext   : std_ulogic_vector(15 downto 0); -- access address (extension registers)
+  signal wren       : std_ulogic; -- full word write enable
+  signal rden       : std_ulogic; -- read enable
+  signal wren_ext   : std_ulogic; -- full word write enable (extension registers)
+  signal rden_ext   : std_ulogic; -- read enable (extension registers)
 
   -- r/w accessible registers --
   signal irq_enable  : std_ulogic_vector(7 downto 0);
+  signal irq_prio    : std_ulogic_vector(7 downto 0); -- high priority channels
   signal enable      : std_ulogic; -- global enable
+  signal vec_en      : std_ulogic; -- vectored mode
   signal irq_sel     : std_ulogic_vector(2 downto 0);
   signal sw_trig     : std_ulogic;
   signal ack_trig    : std_ulogic;
@@ -108,6 +121,8 @@ architecture neo430_exirq_rtl of neo430_exirq is
 
   -- controller core --
   signal irq_buf              : std_ulogic_vector(7 downto 0);
+  signal irq_pend             : std_ulogic_vector(7 downto 0); -- pending IRQs of highest active priority level
+  signal cpu_ack              : std_ulogic; -- vector fetched by CPU
   signal irq_src, irq_src_reg : std_ulogic_vector(2 downto 0);
   signal irq_fire, state      : std_ulogic;
 
@@ -119,6 +134,11 @@ begin
   wren   <= acc_en and wren_i;
   rden   <= acc_en and rden_i;
 
+  acc_ext_en <= '1' when (addr_i(hi_abb_c downto lo_abb_ext_c) = exirq_ext_base_c(hi_abb_c downto lo_abb_ext_c)) else '0';
+  addr_ext   <= exirq_ext_base_c(15 downto lo_abb_ext_c) & addr_i(lo_abb_ext_c-1 downto 1) & '0'; -- word aligned
+  wren_ext   <= acc_ext_en and wren_i;
+  rden_ext   <= acc_ext_en and rden_i;
+
 
   -- Write access -------------------------------------------------------------
   -- -----------------------------------------------------------------------------
@@ -130,11 +150,17 @@ begin
       if (wren = '1') then
         irq_sel    <= data_i(ctrl_irq_sel2_c downto ctrl_irq_sel0_c);
         enable     <= data_i(ctrl_en_c);
+        vec_en     <= data_i(ctrl_vec_c);
         irq_enable <= data_i(ctrl_en_irq7_c downto ctrl_en_irq0_c);
         -- irq_sel options --
         sw_trig    <= data_i(ctrl_sw_irq_c);
         ack_trig   <= data_i(ctrl_ack_irq_c);
       end if;
+      if (wren_ext = '1') and (addr_ext = exirq_prio_addr_c) then
+        irq_prio <= data_i(7 downto 0);
+      end if;
+      -- vector fetch by CPU acknowledges the current IRQ in vectored mode --
+      cpu_ack <= cpu_ack_i and vec_en;
     end if;
   end process wr_access;
 
@@ -195,7 +221,7 @@ begin
           state       <= '1'; -- go to active IRQ state
         end if;
       else -- active interrupt request
-        if (ack_trig = '1') or (enable = '0') then -- ack or disable
+        if (ack_trig = '1') or (cpu_ack = '1') or (enable = '0') then -- ack or disable
           state <= '0';
         end if;
       end if;
@@ -205,23 +231,29 @@ begin
   -- anybody firing? --
   irq_fire <= or_all_f(irq_buf);
 
+  -- high priority channels first --
+  irq_pend <= irq_buf and irq_prio when (or_all_f(irq_buf and irq_prio) = '1') else irq_buf;
+
   -- get interrupt priority --
-  irq_src <= "000" when (irq_buf(0) = '1') else
-             "001" when (irq_buf(1) = '1') else
-             "010" when (irq_buf(2) = '1') else
-             "011" when (irq_buf(3) = '1') else
-             "100" when (irq_buf(4) = '1') else
-             "101" when (irq_buf(5) = '1') else
-             "110" when (irq_buf(6) = '1') else
-             "111";-- when (irq_buf(7) = '1') else "---";
+  irq_src <= "000" when (irq_pend(0) = '1') else
+             "001" when (irq_pend(1) = '1') else
+             "010" when (irq_pend(2) = '1') else
+             "011" when (irq_pend(3) = '1') else
+             "100" when (irq_pend(4) = '1') else
+             "101" when (irq_pend(5) = '1') else
+             "110" when (irq_pend(6) = '1') else
+             "111";-- when (irq_pend(7) = '1') else "---";
+
+  -- vector for CPU --
+  cpu_vec_o <= vec_en & irq_src_reg;
 
 
   -- ACK priority decoder -----------------------------------------------------
   -- -----------------------------------------------------------------------------
-  ack_priority_dec: process(state, ack_trig, irq_src_reg)
+  ack_priority_dec: process(state, ack_trig, cpu_ack, irq_src_reg)
     variable irq_ack_v : std_ulogic_vector(3 downto 0);
   begin
-    irq_ack_v := (ack_trig and state) & irq_src_reg;
+    irq_ack_v := ((ack_trig or cpu_ack) and state) & irq_src_reg;
     case irq_ack_v is
       when "1000" => ack_mask <= "00000001";
       when "1001" => ack_mask <= "00000010";
@@ -246,6 +278,11 @@ begin
         data_o(ctrl_irq_sel2_c downto ctrl_irq_sel0_c) <= irq_src_reg;
         data_o(ctrl_en_irq7_c downto ctrl_en_irq0_c) <= irq_enable;
         data_o(ctrl_en_c) <= enable;
+        data_o(ctrl_vec_c) <= vec_en;
+      elsif (rden_ext = '1') then
+        if (addr_ext = exirq_prio_addr_c) then
+          data_o(7 downto 0) <= irq_prio;
+        end if;
       end if;
     end if;
   end process rd_access;
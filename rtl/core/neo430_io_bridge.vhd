@@ -0,0 +1,249 @@
+-- #################################################################################################
+-- # << NEO430 - IO Clock Domain Bridge >>                                                         #
+-- # ********************************************************************************************* #
+-- # Connects the peripheral devices running on the separate IO clock (clk_io_i) to the CPU's IO   #
+-- # bus. Each access is transferred to the IO clock domain using a toggle handshake. The host     #
+-- # side is busy (stalling the CPU) until the access has been completed. Read-modify-write        #
+-- # accesses (bit-band and atomic modify alias windows) are executed as one uninterrupted         #
+-- # sequence in the IO clock domain. Interrupt requests, the watchdog reset and the GPIO PWM      #
+-- # signal are synchronized to the CPU clock, the external reset is synchronized to the IO clock. #
+-- # ********************************************************************************************* #
+-- # BSD 3-Clause License                                                                          #
+-- #                                                                                               #
+-- # Copyright (c) 2020, Stephan Nolting. All rights reserved.                                     #
+-- #                                                                                               #
+-- # Redistribution and use in source and binary forms, with or without modification, are          #
+-- # permitted provided that the following conditions are met:                                     #
+-- #                                                                                               #
+-- # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+-- #    conditions and the following disclaimer.                                                   #
+-- #                                                                                               #
+-- # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+-- #    conditions and the following disclaimer in the documentation and/or other materials        #
+-- #    provided with the distribution.                                                            #
+-- #                                                                                               #
+-- # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+-- #    endorse or promote products derived from this software without specific prior written      #
+-- #    permission.                                                                                #
+-- #                                                                                               #
+-- # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+-- # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+-- # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+-- # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+-- # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+-- # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+-- # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+-- # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+-- # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+-- # ********************************************************************************************* #
+-- # The NEO430 Processor - https://github.com/stnolting/neo430                                    #
+-- #################################################################################################
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library neo430;
+use neo430.neo430_package.all;
+
+entity neo430_io_bridge is
+  port (
+    -- host access (CPU clock domain) --
+    clk_i        : in  std_ulogic; -- CPU clock line
+    rst_i        : in  std_ulogic; -- external reset, low-active, use as async
+    rden_i       : in  std_ulogic; -- read enable
+    wren_i       : in  std_ulogic; -- write enable
+    mden_i       : in  std_ulogic; -- read-modify-write enable
+    addr_i       : in  std_ulogic_vector(15 downto 0); -- address
+    data_i       : in  std_ulogic_vector(15 downto 0); -- data in
+    mmsk_i       : in  std_ulogic_vector(15 downto 0); -- modify: bits to modify
+    mval_i       : in  std_ulogic_vector(15 downto 0); -- modify: new bit values
+    mtgl_i       : in  std_ulogic; -- modify: toggle bits instead
+    data_o       : out std_ulogic_vector(15 downto 0); -- data out
+    busy_o       : out std_ulogic; -- access in progress
+    irq_o        : out std_ulogic_vector(01 downto 0); -- interrupt requests
+    wdt_rst_o    : out std_ulogic; -- watchdog reset, low-active, use as async
+    pwm_o        : out std_ulogic; -- GPIO PWM
+    -- device access (IO clock domain) --
+    clk_io_i     : in  std_ulogic; -- IO clock line
+    io_rst_o     : out std_ulogic; -- external reset, low-active, use as async
+    io_rden_o    : out std_ulogic; -- read enable
+    io_wren_o    : out std_ulogic; -- write enable
+    io_addr_o    : out std_ulogic_vector(15 downto 0); -- address
+    io_data_o    : out std_ulogic_vector(15 downto 0); -- data out
+    io_data_i    : in  std_ulogic_vector(15 downto 0); -- data in
+    io_irq_i     : in  std_ulogic_vector(01 downto 0); -- interrupt requests
+    io_wdt_rst_i : in  std_ulogic; -- watchdog reset, low-active
+    io_pwm_i     : in  std_ulogic  -- GPIO PWM
+  );
+end neo430_io_bridge;
+
+architecture neo430_io_bridge_rtl of neo430_io_bridge is
+
+  -- access request (host domain) - stable while busy --
+  signal req_tgl  : std_ulogic := '0'; -- toggles for each new request
+  signal req_op   : std_ulogic_vector(01 downto 0); -- 00: read, 01: write, 1-: read-modify-write
+  signal req_addr : std_ulogic_vector(15 downto 0);
+  signal req_data : std_ulogic_vector(15 downto 0);
+  signal req_mmsk : std_ulogic_vector(15 downto 0);
+  signal req_mval : std_ulogic_vector(15 downto 0);
+  signal req_mtgl : std_ulogic;
+  signal busy     : std_ulogic := '0';
+  signal rd_valid : std_ulogic := '0';
+  signal rdata    : std_ulogic_vector(15 downto 0);
+
+  -- access acknowledge (IO domain) --
+  signal ack_tgl  : std_ulogic := '0'; -- toggles when a request has been completed
+  signal io_rdata : std_ulogic_vector(15 downto 0); -- read data, stable until next request
+
+  -- synchronizers --
+  signal req_sync : std_ulogic_vector(02 downto 0) := (others => '0'); -- IO domain
+  signal ack_sync : std_ulogic_vector(02 downto 0) := (others => '0'); -- host domain
+  signal irq_tgl  : std_ulogic_vector(01 downto 0) := (others => '0'); -- IO domain
+  signal irq_sync0, irq_sync1, irq_sync2 : std_ulogic_vector(01 downto 0) := (others => '0'); -- host domain
+  signal pwm_sync : std_ulogic_vector(01 downto 0) := (others => '0'); -- host domain
+  signal wdt_sync : std_ulogic_vector(01 downto 0) := (others => '0'); -- host domain
+  signal rst_sync : std_ulogic_vector(01 downto 0); -- IO domain
+
+  -- device access sequencer (IO domain) --
+  type io_state_t is (S_IDLE, S_READ, S_WRITE);
+  signal io_state : io_state_t := S_IDLE;
+  signal io_rden  : std_ulogic := '0';
+  signal io_wren  : std_ulogic := '0';
+  signal io_wdata : std_ulogic_vector(15 downto 0);
+  signal io_new   : std_ulogic_vector(15 downto 0); -- new values of modified bits
+
+begin
+
+  -- Host Side ----------------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  host_ctrl: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      ack_sync <= ack_sync(1 downto 0) & ack_tgl;
+      rd_valid <= '0';
+      if (busy = '0') then -- accept new request
+        if ((rden_i or wren_i or mden_i) = '1') then
+          req_tgl  <= not req_tgl;
+          req_op   <= mden_i & wren_i;
+          req_addr <= addr_i;
+          req_data <= data_i;
+          req_mmsk <= mmsk_i;
+          req_mval <= mval_i;
+          req_mtgl <= mtgl_i;
+          busy     <= '1';
+        end if;
+      elsif ((ack_sync(2) xor ack_sync(1)) = '1') then -- request completed
+        rdata    <= io_rdata; -- stable since acknowledge
+        rd_valid <= not (req_op(1) or req_op(0));
+        busy     <= '0';
+      end if;
+    end if;
+  end process host_ctrl;
+
+  -- output read data only for one cycle (bus convention) --
+  data_o <= rdata when (rd_valid = '1') else (others => '0');
+  busy_o <= busy;
+
+
+  -- Device Side --------------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  io_ctrl: process(clk_io_i)
+  begin
+    if rising_edge(clk_io_i) then
+      req_sync <= req_sync(1 downto 0) & req_tgl;
+      io_rden  <= '0';
+      io_wren  <= '0';
+      case io_state is
+
+        when S_IDLE => -- wait for new request
+          if ((req_sync(2) xor req_sync(1)) = '1') then
+            io_wdata <= req_data;
+            if (req_op = "01") then -- write
+              io_wren  <= '1';
+              io_state <= S_WRITE;
+            else -- read / read-modify-write
+              io_rden  <= '1';
+              io_state <= S_READ;
+            end if;
+          end if;
+
+        when S_READ => -- device read data available
+          io_rdata <= io_data_i;
+          if (req_op(1) = '1') then -- read-modify-write: write back modified data
+            io_wdata <= (io_data_i and (not req_mmsk)) or (io_new and req_mmsk);
+            io_wren  <= '1';
+            io_state <= S_WRITE;
+          else
+            ack_tgl  <= not ack_tgl;
+            io_state <= S_IDLE;
+          end if;
+
+        when others => -- S_WRITE: write access completed
+          ack_tgl  <= not ack_tgl;
+          io_state <= S_IDLE;
+
+      end case;
+    end if;
+  end process io_ctrl;
+
+  -- modify: new values of masked bits --
+  io_new <= (not io_data_i) when (req_mtgl = '1') else req_mval;
+
+  -- device bus (request is stable during the access) --
+  io_rden_o <= io_rden;
+  io_wren_o <= io_wren;
+  io_addr_o <= req_addr;
+  io_data_o <= io_wdata;
+
+
+  -- Synchronizers ------------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  -- interrupt requests (single-shot) --
+  irq_sync_io: process(clk_io_i)
+  begin
+    if rising_edge(clk_io_i) then
+      irq_tgl <= irq_tgl xor io_irq_i;
+    end if;
+  end process irq_sync_io;
+
+  irq_sync_host: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      irq_sync0 <= irq_tgl;
+      irq_sync1 <= irq_sync0;
+      irq_sync2 <= irq_sync1;
+      -- GPIO PWM --
+      pwm_sync <= pwm_sync(0) & io_pwm_i;
+    end if;
+  end process irq_sync_host;
+
+  irq_o <= irq_sync2 xor irq_sync1;
+  pwm_o <= pwm_sync(1);
+
+  -- watchdog reset: asynchronous assertion, synchronous de-assertion --
+  wdt_rst_sync: process(io_wdt_rst_i, clk_i)
+  begin
+    if (io_wdt_rst_i = '0') then
+      wdt_sync <= (others => '0');
+    elsif rising_edge(clk_i) then
+      wdt_sync <= wdt_sync(0) & '1';
+    end if;
+  end process wdt_rst_sync;
+
+  wdt_rst_o <= wdt_sync(1);
+
+  -- external reset: asynchronous assertion, synchronous de-assertion --
+  io_rst_sync: process(rst_i, clk_io_i)
+  begin
+    if (rst_i = '0') then
+      rst_sync <= (others => '0');
+    elsif rising_edge(clk_io_i) then
+      rst_sync <= rst_sync(0) & '1';
+    end if;
+  end process io_rst_sync;
+
+  io_rst_o <= rst_sync(1);
+
+
+end neo430_io_bridge_rtl;
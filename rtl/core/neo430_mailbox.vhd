@@ -0,0 +1,314 @@
+-- #################################################################################################
+-- # << NEO430 - Inter-Core Mailbox >>                                                             #
+-- # ********************************************************************************************* #
+-- # Shared by NUM_CORES processors (neo430_top with MBOX_USE = true, common clock) for fast       #
+-- # inter-core communication. Each core has a receive FIFO for 16-bit messages (tagged with the   #
+-- # sender ID) and a single-entry send buffer; a message is delivered into the destination FIFO   #
+-- # one cycle after it has been written (round-robin between senders). 16 hardware semaphores     #
+-- # (lock/release via single write accesses, the lowest core ID wins simultaneous requests) and   #
+-- # doorbells for cross-core interrupts are also provided.                                        #
+-- # ********************************************************************************************* #
+-- # BSD 3-Clause License                                                                          #
+-- #                                                                                               #
+-- # Copyright (c) 2020, Stephan Nolting. All rights reserved.                                     #
+-- #                                                                                               #
+-- # Redistribution and use in source and binary forms, with or without modification, are          #
+-- # permitted provided that the following conditions are met:                                     #
+-- #                                                                                               #
+-- # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+-- #    conditions and the following disclaimer.                                                   #
+-- #                                                                                               #
+-- # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+-- #    conditions and the following disclaimer in the documentation and/or other materials        #
+-- #    provided with the distribution.                                                            #
+-- #                                                                                               #
+-- # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+-- #    endorse or promote products derived from this software without specific prior written      #
+-- #    permission.                                                                                #
+-- #                                                                                               #
+-- # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+-- # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+-- # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+-- # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+-- # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+-- # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+-- # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+-- # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+-- # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+-- # ********************************************************************************************* #
+-- # The NEO430 Processor - https://github.com/stnolting/neo430                                    #
+-- #################################################################################################
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library neo430;
+use neo430.neo430_package.all;
+
+entity neo430_mailbox is
+  generic (
+    NUM_CORES : natural := 2; -- number of attached cores (1..8)
+    FIFO_SIZE : natural := 4  -- message FIFO depth per core (power of two, min 2)
+  );
+  port (
+    -- global control --
+    clk_i : in  std_ulogic; -- global clock line (shared by all cores)
+    rst_i : in  std_ulogic; -- global reset, low-active, async
+    -- core ports (core n uses bits of slice n) --
+    rd_i  : in  std_ulogic_vector(NUM_CORES-1 downto 0); -- read enable
+    wr_i  : in  std_ulogic_vector(NUM_CORES-1 downto 0); -- write enable
+    adr_i : in  std_ulogic_vector(NUM_CORES*3-1 downto 0); -- register (word) address
+    dat_i : in  std_ulogic_vector(NUM_CORES*16-1 downto 0); -- write data
+    dat_o : out std_ulogic_vector(NUM_CORES*16-1 downto 0); -- read data
+    irq_o : out std_ulogic_vector(NUM_CORES-1 downto 0)  -- interrupt (message received / doorbell)
+  );
+end neo430_mailbox;
+
+architecture neo430_mailbox_rtl of neo430_mailbox is
+
+  -- register (word) addresses --
+  constant reg_ctrl_c : natural := 0; -- r/w: control and status
+  constant reg_dst_c  : natural := 1; -- r/w: destination core of next message
+  constant reg_tx_c   : natural := 2; -- -/w: send message
+  constant reg_rx_c   : natural := 3; -- r/-: receive (pop) message
+  constant reg_src_c  : natural := 4; -- r/-: sender of oldest message
+  constant reg_lock_c : natural := 5; -- r/w: w: try to lock semaphore, r: semaphores owned by this core
+  constant reg_free_c : natural := 6; -- r/w: w: release semaphore, r: all locked semaphores
+  constant reg_bell_c : natural := 7; -- r/w: w: ring doorbells of cores (mask), r: pending doorbells (clear on read)
+
+  -- control reg bits --
+  constant ctrl_rx_irq_c   : natural :=  0; -- r/w: message received interrupt enable
+  constant ctrl_db_irq_c   : natural :=  1; -- r/w: doorbell interrupt enable
+  constant ctrl_rx_avail_c : natural :=  2; -- r/-: message available
+  constant ctrl_tx_busy_c  : natural :=  3; -- r/-: last message not yet delivered
+  constant ctrl_tx_ovr_c   : natural :=  4; -- r/c: message written while TX busy was dropped, write 1 to clear
+  constant ctrl_id0_c      : natural :=  8; -- r/-: own core ID bit 0
+  constant ctrl_id2_c      : natural := 10; -- r/-: own core ID bit 2
+  constant ctrl_num0_c     : natural := 12; -- r/-: number of cores - 1, bit 0
+  constant ctrl_num2_c     : natural := 14; -- r/-: number of cores - 1, bit 2
+
+  -- fifo configuration --
+  constant fifo_idx_c : natural := index_size_f(FIFO_SIZE);
+
+  -- types --
+  type data_t   is array (0 to NUM_CORES-1) of std_ulogic_vector(15 downto 0);
+  type ptr_t    is array (0 to NUM_CORES-1) of unsigned(fifo_idx_c downto 0); -- incl. wrap-around bit
+  type id_t     is array (0 to NUM_CORES-1) of natural range 0 to NUM_CORES-1;
+  type fifo_t   is array (0 to NUM_CORES*FIFO_SIZE-1) of std_ulogic_vector(18 downto 0); -- sender ID & message
+  type sem_id_t is array (0 to 15) of natural range 0 to NUM_CORES-1;
+
+  -- message passing --
+  signal fifo    : fifo_t; -- receive FIFOs of all cores
+  signal w_ptr   : ptr_t;
+  signal r_ptr   : ptr_t;
+  signal tx_busy : std_ulogic_vector(NUM_CORES-1 downto 0);
+  signal tx_ovr  : std_ulogic_vector(NUM_CORES-1 downto 0); -- send overrun (message dropped)
+  signal tx_data : data_t; -- send buffers
+  signal tx_dst  : id_t;
+  signal rr_next : id_t; -- round-robin: sender with highest priority for each destination
+
+  -- control --
+  signal rx_irq_en : std_ulogic_vector(NUM_CORES-1 downto 0);
+  signal db_irq_en : std_ulogic_vector(NUM_CORES-1 downto 0);
+  signal bell      : data_t; -- pending doorbells: bit n = rung by core n
+
+  -- semaphores --
+  signal sem_lock  : std_ulogic_vector(15 downto 0);
+  signal sem_owner : sem_id_t;
+
+begin
+
+  -- Sanity Checks ------------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  assert not ((NUM_CORES = 0) or (NUM_CORES > 8)) report "NEO430 MBOX: NUM_CORES has to be 1..8!" severity error;
+  assert not ((FIFO_SIZE < 2) or (is_power_of_two_f(FIFO_SIZE, 16) = false)) report "NEO430 MBOX: FIFO_SIZE has to be a power of two (min 2)!" severity error;
+
+
+  -- Message Delivery, Register Write Access and Semaphores -------------------
+  -- -----------------------------------------------------------------------------
+  mbox_core: process(rst_i, clk_i)
+    variable adr_v   : natural range 0 to 7;
+    variable dat_v   : std_ulogic_vector(15 downto 0);
+    variable src_v   : natural range 0 to NUM_CORES-1;
+    variable sem_v   : natural range 0 to 15;
+    variable found_v : boolean;
+    variable w_ptr_v : ptr_t;
+    variable r_ptr_v : ptr_t;
+    variable busy_v  : std_ulogic_vector(NUM_CORES-1 downto 0);
+    variable bell_v  : data_t;
+    variable lock_v  : std_ulogic_vector(15 downto 0);
+    variable owner_v : sem_id_t;
+    variable irq_v   : std_ulogic_vector(NUM_CORES-1 downto 0);
+  begin
+    if (rst_i = '0') then
+      w_ptr     <= (others => (others => '0'));
+      r_ptr     <= (others => (others => '0'));
+      tx_busy   <= (others => '0');
+      tx_ovr    <= (others => '0');
+      tx_dst    <= (others => 0);
+      rr_next   <= (others => 0);
+      rx_irq_en <= (others => '0');
+      db_irq_en <= (others => '0');
+      bell      <= (others => (others => '0'));
+      sem_lock  <= (others => '0');
+      sem_owner <= (others => 0);
+      irq_o     <= (others => '0');
+    elsif rising_edge(clk_i) then
+      w_ptr_v := w_ptr;
+      r_ptr_v := r_ptr;
+      busy_v  := tx_busy;
+      bell_v  := bell;
+      lock_v  := sem_lock;
+      owner_v := sem_owner;
+      irq_v   := (others => '0');
+
+      -- message delivery: one message per destination and cycle, round-robin between senders --
+      for d in 0 to NUM_CORES-1 loop
+        found_v := false;
+        if ((w_ptr(d) - r_ptr(d)) /= FIFO_SIZE) then -- destination FIFO not full?
+          for k in 0 to NUM_CORES-1 loop
+            src_v := (rr_next(d) + k) mod NUM_CORES;
+            if (found_v = false) and (tx_busy(src_v) = '1') and (tx_dst(src_v) = d) then
+              found_v := true;
+              fifo(d*FIFO_SIZE + to_integer(w_ptr(d)(fifo_idx_c-1 downto 0))) <= std_ulogic_vector(to_unsigned(src_v, 3)) & tx_data(src_v);
+              w_ptr_v(d)    := w_ptr(d) + 1;
+              busy_v(src_v) := '0';
+              rr_next(d)    <= (src_v + 1) mod NUM_CORES;
+              irq_v(d)      := rx_irq_en(d);
+            end if;
+          end loop;
+        end if;
+      end loop;
+
+      -- core accesses --
+      for i in 0 to NUM_CORES-1 loop
+        adr_v := to_integer(unsigned(adr_i(i*3+2 downto i*3)));
+        dat_v := dat_i(i*16+15 downto i*16);
+        if (wr_i(i) = '1') then
+          case adr_v is
+            when reg_ctrl_c =>
+              rx_irq_en(i) <= dat_v(ctrl_rx_irq_c);
+              db_irq_en(i) <= dat_v(ctrl_db_irq_c);
+              if (dat_v(ctrl_tx_ovr_c) = '1') then
+                tx_ovr(i) <= '0';
+              end if;
+            when reg_dst_c =>
+              if (to_integer(unsigned(dat_v(2 downto 0))) < NUM_CORES) then
+                tx_dst(i) <= to_integer(unsigned(dat_v(2 downto 0)));
+              end if;
+            when reg_tx_c =>
+              if (tx_busy(i) = '0') then
+                tx_data(i) <= dat_v;
+                busy_v(i)  := '1';
+              else -- drop new message while the last one is still in transit
+                tx_ovr(i)  <= '1';
+              end if;
+            when reg_bell_c =>
+              for d in 0 to NUM_CORES-1 loop
+                if (dat_v(d) = '1') then
+                  bell_v(d)(i) := '1';
+                  irq_v(d)     := irq_v(d) or db_irq_en(d);
+                end if;
+              end loop;
+            when others => -- semaphores are processed below
+              NULL;
+          end case;
+        end if;
+        if (rd_i(i) = '1') then
+          if (adr_v = reg_rx_c) and (w_ptr(i) /= r_ptr(i)) then -- pop message
+            r_ptr_v(i) := r_ptr(i) + 1;
+          end if;
+          if (adr_v = reg_bell_c) then -- clear doorbells that have been read (new bells always win)
+            bell_v(i) := bell_v(i) and (not bell(i));
+          end if;
+        end if;
+      end loop;
+
+      -- semaphores: first all releases, then lock requests (lowest core ID wins) --
+      for i in 0 to NUM_CORES-1 loop
+        sem_v := to_integer(unsigned(dat_i(i*16+3 downto i*16)));
+        if (wr_i(i) = '1') and (to_integer(unsigned(adr_i(i*3+2 downto i*3))) = reg_free_c) then
+          if (lock_v(sem_v) = '1') and (owner_v(sem_v) = i) then -- only the owner can release a semaphore
+            lock_v(sem_v) := '0';
+          end if;
+        end if;
+      end loop;
+      for i in 0 to NUM_CORES-1 loop
+        sem_v := to_integer(unsigned(dat_i(i*16+3 downto i*16)));
+        if (wr_i(i) = '1') and (to_integer(unsigned(adr_i(i*3+2 downto i*3))) = reg_lock_c) then
+          if (lock_v(sem_v) = '0') then
+            lock_v(sem_v)  := '1';
+            owner_v(sem_v) := i;
+          end if;
+        end if;
+      end loop;
+
+      w_ptr     <= w_ptr_v;
+      r_ptr     <= r_ptr_v;
+      tx_busy   <= busy_v;
+      bell      <= bell_v;
+      sem_lock  <= lock_v;
+      sem_owner <= owner_v;
+      irq_o     <= irq_v;
+    end if;
+  end process mbox_core;
+
+
+  -- Read Access --------------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  read_access: process(clk_i)
+    variable rdata_v : std_ulogic_vector(15 downto 0);
+    variable avail_v : std_ulogic;
+    variable head_v  : std_ulogic_vector(18 downto 0);
+  begin
+    if rising_edge(clk_i) then
+      for i in 0 to NUM_CORES-1 loop
+        rdata_v := (others => '0');
+        avail_v := '0';
+        if (w_ptr(i) /= r_ptr(i)) then
+          avail_v := '1';
+        end if;
+        head_v := fifo(i*FIFO_SIZE + to_integer(r_ptr(i)(fifo_idx_c-1 downto 0)));
+        if (rd_i(i) = '1') then
+          case to_integer(unsigned(adr_i(i*3+2 downto i*3))) is
+            when reg_ctrl_c =>
+              rdata_v(ctrl_rx_irq_c)   := rx_irq_en(i);
+              rdata_v(ctrl_db_irq_c)   := db_irq_en(i);
+              rdata_v(ctrl_rx_avail_c) := avail_v;
+              rdata_v(ctrl_tx_busy_c)  := tx_busy(i);
+              rdata_v(ctrl_tx_ovr_c)   := tx_ovr(i);
+              rdata_v(ctrl_id2_c downto ctrl_id0_c)   := std_ulogic_vector(to_unsigned(i, 3));
+              rdata_v(ctrl_num2_c downto ctrl_num0_c) := std_ulogic_vector(to_unsigned(NUM_CORES-1, 3));
+            when reg_dst_c =>
+              rdata_v(2 downto 0) := std_ulogic_vector(to_unsigned(tx_dst(i), 3));
+            when reg_rx_c =>
+              if (avail_v = '1') then
+                rdata_v := head_v(15 downto 0);
+              end if;
+            when reg_src_c =>
+              if (avail_v = '1') then
+                rdata_v(15) := '1'; -- valid
+                rdata_v(2 downto 0) := head_v(18 downto 16);
+              end if;
+            when reg_lock_c =>
+              for k in 0 to 15 loop
+                if (sem_owner(k) = i) then
+                  rdata_v(k) := sem_lock(k);
+                end if;
+              end loop;
+            when reg_free_c =>
+              rdata_v := sem_lock;
+            when reg_bell_c =>
+              rdata_v := bell(i);
+            when others =>
+              NULL;
+          end case;
+        end if;
+        dat_o(i*16+15 downto i*16) <= rdata_v;
+      end loop;
+    end if;
+  end process read_access;
+
+
+end neo430_mailbox_rtl;
@@ -46,7 +46,15 @@ package neo430_package is
   -- -------------------------------------------------------------------------------------------
   constant use_dsp_mul_c    : boolean := false; -- use DSP blocks for MULDIV's multiplication core (default=false)
   constant use_xalu_c       : boolean := false; -- implement extended ALU function (default=false)
+  constant use_dadd_c       : boolean := false; -- implement DADD instruction (BCD addition) (default=false)
+  constant use_xshift_c     : boolean := false; -- implement MSP430X multi-bit shifts RRCM/RRAM/RLAM/RRUM (barrel shifter) and register-mode extension words (RPT, ZC) (default=false)
+  constant use_pushm_c      : boolean := false; -- implement MSP430X multi-register PUSHM/POPM instructions (default=false)
+  constant use_dual_rf_c    : boolean := false; -- dual-read-port register file, -1 cycle for register-to-register ALU ops (default=false)
+  constant shadow_rf_irq_c  : std_ulogic_vector(3 downto 0) := "0000"; -- CPU IRQ channel i uses shadow register bank (R4..R15) if bit i is set (default="0000")
   constant low_power_mode_c : boolean := false; -- can reduce switching activity, but will also decrease f_max and might increase area (default=false)
+  constant io_rd_pipe_c     : boolean := false; -- register IO read data (+1 cycle IO read latency), increases f_max for large configurations (default=false)
+  constant spi_fifo_size_c  : natural := 8; -- SPI TX/RX FIFO depth in words, has to be a power of two, min 2 (default=8)
+  constant twi_fifo_size_c  : natural := 16; -- TWI command/RX FIFO depth, has to be a power of two, min 8, max 128 (default=16)
 
   -- Internal Functions ---------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
@@ -64,6 +72,7 @@ package neo430_package is
   function or_all_f(a : std_ulogic_vector) return std_ulogic;
   function and_all_f(a : std_ulogic_vector) return std_ulogic;
   function xor_all_f(a : std_ulogic_vector) return std_ulogic;
+  function io_rd_side_effect_f(addr : std_ulogic_vector(15 downto 0)) return std_ulogic;
 
   -- Address Space Layout (make sure this is always sync with neo430.h) ---------------------
   -- -------------------------------------------------------------------------------------------
@@ -76,16 +85,31 @@ package neo430_package is
   constant dmem_base_c     : std_ulogic_vector(15 downto 0) := x"C000"; -- base address, fixed!
   constant dmem_max_size_c : natural := 12*1024; -- bytes, fixed!
 
+  -- Banked Far Memory (XMEM) Window: one bank of the far memory, IMEM is limited to 32kB when XMEM is used --
+  constant xmem_win_base_c : std_ulogic_vector(15 downto 0) := x"8000"; -- window base address, fixed!
+  constant xmem_win_size_c : natural := 16*1024; -- window/bank size in bytes, fixed!
+  constant xmem_max_size_c : natural := 1024*1024; -- bytes (20-bit address space), fixed!
+
   -- Boot ROM --
   constant boot_base_c     : std_ulogic_vector(15 downto 0) := x"F000"; -- bootloader base address, fixed!
   constant boot_size_c     : natural := 2*1024; -- bytes, max 2048 bytes!
   constant boot_max_size_c : natural := 2*1024; -- bytes, fixed!
 
+  -- Bit-Band Alias Window: one byte address per bit of the primary IO device registers (0xFF80..0xFFFF) --
+  constant bitband_base_c  : std_ulogic_vector(15 downto 0) := x"F800"; -- base address, fixed!
+  constant bitband_size_c  : natural := 1024; -- bytes, fixed!
+
+  -- Atomic Modify Windows: write-only set/clear/toggle aliases of the complete IO area (0xFF00..0xFFFF) --
+  constant iomod_set_base_c : std_ulogic_vector(15 downto 0) := x"FC00"; -- set bits, fixed!
+  constant iomod_clr_base_c : std_ulogic_vector(15 downto 0) := x"FD00"; -- clear bits, fixed!
+  constant iomod_tgl_base_c : std_ulogic_vector(15 downto 0) := x"FE00"; -- toggle bits, fixed!
+
   -- IO: Peripheral Devices ("IO") Area --
   -- Each device must use 2 bytes or a multiple of 2 bytes as address space!
   -- CONTROL register(s) (including the device enable) must be located at the base address of the device!
-  constant io_base_c : std_ulogic_vector(15 downto 0) := x"FF80";
-  constant io_size_c : natural := 128; -- bytes, fixed!
+  -- 0xFF80..0xFFFF: primary device registers; 0xFF00..0xFF7F: device extension registers
+  constant io_base_c : std_ulogic_vector(15 downto 0) := x"FF00";
+  constant io_size_c : natural := 256; -- bytes, fixed!
 
   -- IO: Multiplier/Divider Unit (MULDIV) --
   constant muldiv_base_c : std_ulogic_vector(15 downto 0) := x"FF80";
@@ -132,6 +156,24 @@ package neo430_package is
   constant spi_ctrl_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(spi_base_c) + x"0000");
   constant spi_rtx_addr_c  : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(spi_base_c) + x"0002");
 
+  -- IO: Banked Far Memory Control (XMEM) --
+  constant xmem_base_c : std_ulogic_vector(15 downto 0) := x"FF38";
+  constant xmem_size_c : natural := 8; -- bytes
+
+  constant xmem_bank_addr_c  : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(xmem_base_c) + x"0000");
+  constant xmem_ptrlo_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(xmem_base_c) + x"0002");
+  constant xmem_ptrhi_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(xmem_base_c) + x"0004");
+  constant xmem_data_addr_c  : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(xmem_base_c) + x"0006");
+
+  -- IO: Serial Peripheral Interface - extension registers (SPI_EXT) --
+  constant spi_ext_base_c : std_ulogic_vector(15 downto 0) := x"FF40";
+  constant spi_ext_size_c : natural := 8; -- bytes
+
+  constant spi_fct_addr_c  : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(spi_ext_base_c) + x"0000");
+  constant spi_tlen_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(spi_ext_base_c) + x"0002");
+  constant spi_qct_addr_c  : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(spi_ext_base_c) + x"0004");
+--constant spi_???_addr_c  : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(spi_ext_base_c) + x"0006");
+
   -- IO: General purpose input/output port (GPIO)  --
   constant gpio_base_c : std_ulogic_vector(15 downto 0) := x"FFA8";
   constant gpio_size_c : natural := 8; -- bytes
@@ -198,6 +240,15 @@ package neo430_package is
   constant twi_ctrl_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(twi_base_c) + x"0000");
   constant twi_rtx_addr_c  : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(twi_base_c) + x"0002");
 
+  -- IO: Two Wire Serial Interface - extension registers (TWI_EXT) --
+  constant twi_ext_base_c : std_ulogic_vector(15 downto 0) := x"FF48";
+  constant twi_ext_size_c : natural := 8; -- bytes
+
+  constant twi_fct_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(twi_ext_base_c) + x"0000");
+  constant twi_cmd_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(twi_ext_base_c) + x"0002");
+  constant twi_rxd_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(twi_ext_base_c) + x"0004");
+--constant twi_???_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(twi_ext_base_c) + x"0006");
+
   -- IO: True Random Number Generator (TRNG) --
   constant trng_base_c : std_ulogic_vector(15 downto 0) := x"FFEC";
   constant trng_size_c : natural := 2; -- bytes
@@ -210,10 +261,59 @@ package neo430_package is
 
   constant exirq_ctrl_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(exirq_base_c) + x"0000");
 
+  -- IO: External Interrupts Controller - extension registers (EXIRQ_EXT) --
+  constant exirq_ext_base_c : std_ulogic_vector(15 downto 0) := x"FF50";
+  constant exirq_ext_size_c : natural := 8; -- bytes
+
+  constant exirq_prio_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(exirq_ext_base_c) + x"0000");
+--constant exirq_???_addr_c  : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(exirq_ext_base_c) + x"0002");
+--constant exirq_???_addr_c  : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(exirq_ext_base_c) + x"0004");
+--constant exirq_???_addr_c  : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(exirq_ext_base_c) + x"0006");
+
+  -- IO: Bit Manipulation Unit (BMU) --
+  constant bmu_base_c : std_ulogic_vector(15 downto 0) := x"FF58";
+  constant bmu_size_c : natural := 8; -- bytes
+
+  constant bmu_popc_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(bmu_base_c) + x"0000");
+  constant bmu_clz_addr_c  : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(bmu_base_c) + x"0002");
+  constant bmu_ctz_addr_c  : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(bmu_base_c) + x"0004");
+  constant bmu_brev_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(bmu_base_c) + x"0006");
+
+  -- IO: Wishbone Slave Port (WBS) --
+  constant wbs_base_c : std_ulogic_vector(15 downto 0) := x"FF68";
+  constant wbs_size_c : natural := 8; -- bytes
+
+  constant wbs_ctrl_addr_c  : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(wbs_base_c) + x"0000");
+  constant wbs_dbin_addr_c  : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(wbs_base_c) + x"0002");
+  constant wbs_dbout_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(wbs_base_c) + x"0004");
+--constant wbs_???_addr_c   : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(wbs_base_c) + x"0006");
+
+  -- IO: Inter-Core Mailbox Port (MBOX) - registers are implemented by the external neo430_mailbox --
+  constant mbox_base_c : std_ulogic_vector(15 downto 0) := x"FF70";
+  constant mbox_size_c : natural := 16; -- bytes
+
+  constant mbox_ctrl_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(mbox_base_c) + x"0000");
+  constant mbox_dst_addr_c  : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(mbox_base_c) + x"0002");
+  constant mbox_tx_addr_c   : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(mbox_base_c) + x"0004");
+  constant mbox_rx_addr_c   : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(mbox_base_c) + x"0006");
+  constant mbox_src_addr_c  : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(mbox_base_c) + x"0008");
+  constant mbox_lock_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(mbox_base_c) + x"000A");
+  constant mbox_free_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(mbox_base_c) + x"000C");
+  constant mbox_bell_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(mbox_base_c) + x"000E");
+
   -- IO: System Configuration (SYSCONFIG) --
   constant sysconfig_base_c : std_ulogic_vector(15 downto 0) := x"FFF0";
   constant sysconfig_size_c : natural := 16; -- bytes
 
+  -- IO: System Configuration - extension registers (SYSCONFIG_EXT) --
+  constant sysconfig_ext_base_c : std_ulogic_vector(15 downto 0) := x"FF60";
+  constant sysconfig_ext_size_c : natural := 8; -- bytes
+
+  constant sysconfig_ioclk_lo_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(sysconfig_ext_base_c) + x"0000");
+  constant sysconfig_ioclk_hi_addr_c : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(sysconfig_ext_base_c) + x"0002");
+  constant sysconfig_hartid_addr_c   : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(sysconfig_ext_base_c) + x"0004");
+  constant sysconfig_xmem_addr_c     : std_ulogic_vector(15 downto 0) := std_ulogic_vector(unsigned(sysconfig_ext_base_c) + x"0006");
+
   -- Clock Generator -------------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
   constant clk_div2_c    : natural := 0;
@@ -240,6 +340,7 @@ package neo430_package is
   constant sreg_i_c : natural := 3;  -- r/w: global interrupt enable
   constant sreg_s_c : natural := 4;  -- r/w: CPU sleep flag
   constant sreg_p_c : natural := 5;  -- r/w: parity flag
+  constant sreg_b_c : natural := 6;  -- r/w: shadow register bank select
   constant sreg_v_c : natural := 8;  -- r/w: overflow flag
   constant sreg_q_c : natural := 14; -- -/w: clear pending IRQ buffer when set
   constant sreg_r_c : natural := 15; -- r/w: enable write access to IMEM (ROM) when set
@@ -267,6 +368,11 @@ package neo430_package is
   constant ctrl_rf_dsleep_c   : natural :=  9; -- disable sleep mode
   constant ctrl_rf_dgie_c     : natural := 10; -- disable global interrupt enable
   constant ctrl_rf_boot_c     : natural := 11; -- inject PC boot address
+  constant ctrl_rf_bank_c     : natural := 32; -- switch to shadow register bank
+  constant ctrl_rf_badr0_c    : natural := 35; -- read port B register address bit 0 (use_dual_rf_c only)
+  constant ctrl_rf_badr1_c    : natural := 36; -- read port B register address bit 1 (use_dual_rf_c only)
+  constant ctrl_rf_badr2_c    : natural := 37; -- read port B register address bit 2 (use_dual_rf_c only)
+  constant ctrl_rf_badr3_c    : natural := 38; -- read port B register address bit 3 (use_dual_rf_c only)
   -- alu --
   constant ctrl_alu_in_sel_c  : natural := 12; -- ALU OP input select
   constant ctrl_alu_opa_wr_c  : natural := 13; -- write ALU operand A
@@ -276,6 +382,12 @@ package neo430_package is
   constant ctrl_alu_cmd2_c    : natural := 17; -- ALU command bit 2
   constant ctrl_alu_cmd3_c    : natural := 18; -- ALU command bit 3
   constant ctrl_alu_bw_c      : natural := 19; -- byte(1)/word(0) operation
+  constant ctrl_alu_xsh_c     : natural := 29; -- multi-bit shift operation (shift type = ALU command bits 1:0)
+  constant ctrl_alu_xsh_n0_c  : natural := 30; -- multi-bit shift: number of shifts - 1, bit 0
+  constant ctrl_alu_xsh_n1_c  : natural := 31; -- multi-bit shift: number of shifts - 1, bit 1
+  constant ctrl_alu_cfu_c     : natural := 33; -- use CFU custom instruction result
+  constant ctrl_alu_opb_rfb_c : natural := 39; -- ALU operand B input: 0 = OP input select, 1 = RF read port B
+  constant ctrl_alu_zc_c      : natural := 40; -- zero carry: use carry = 0 as input (MSP430X extension word ZC bit)
   -- address generator --
   constant ctrl_adr_off0_c    : natural := 20; -- address offset selection bit 0
   constant ctrl_adr_off1_c    : natural := 21; -- address offset selection bit 1
@@ -287,8 +399,10 @@ package neo430_package is
   -- memory interface --
   constant ctrl_mem_wr_c      : natural := 27; -- write to memory
   constant ctrl_mem_rd_c      : natural := 28; -- read from memory
+  -- custom functions unit --
+  constant ctrl_cfu_start_c   : natural := 34; -- start CFU custom instruction
   -- bus size --
-  constant ctrl_width_c       : natural := 29; -- control bus size
+  constant ctrl_width_c       : natural := 41; -- control bus size
 
   -- Condition Codes ------------------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
@@ -313,7 +427,7 @@ package neo430_package is
   constant alu_subc_c : std_ulogic_vector(3 downto 0) := "0111"; -- r <= b - a - 1 + carry
   constant alu_sub_c  : std_ulogic_vector(3 downto 0) := "1000"; -- r <= b - a
   constant alu_cmp_c  : std_ulogic_vector(3 downto 0) := "1001"; -- b - a (no write back)
---constant alu_dadd_c : std_ulogic_vector(3 downto 0) := "1010"; -- r <= a + b (BCD) [NOT SUPPORTED!]
+  constant alu_dadd_c : std_ulogic_vector(3 downto 0) := "1010"; -- r <= a + b + carry (BCD), if use_dadd_c = true
   constant alu_bit_c  : std_ulogic_vector(3 downto 0) := "1011"; -- a & b (no write back)
   constant alu_bic_c  : std_ulogic_vector(3 downto 0) := "1100"; -- r <= !a & b
   constant alu_bis_c  : std_ulogic_vector(3 downto 0) := "1101"; -- r <= a | b
@@ -327,10 +441,15 @@ package neo430_package is
     generic (
       -- general configuration --
       CLOCK_SPEED  : natural := 100000000; -- main clock in Hz
+      IO_CLK_SPEED : natural := 0; -- peripheral clock in Hz, 0 = same as main clock (default=0)
       IMEM_SIZE    : natural := 4*1024; -- internal IMEM size in bytes, max 32kB (default=4kB)
       DMEM_SIZE    : natural := 2*1024; -- internal DMEM size in bytes, max 28kB (default=2kB)
+      IMEM_WAIT    : natural := 0;      -- wait states for each IMEM access (default=0)
+      DMEM_WAIT    : natural := 0;      -- wait states for each DMEM access (default=0)
+      XMEM_SIZE    : natural := 0;      -- banked far memory size in bytes, 0 = none, 16kB..1MB (default=0)
       -- additional configuration --
       USER_CODE    : std_ulogic_vector(15 downto 0) := x"0000"; -- custom user code
+      HART_ID      : natural := 0;      -- core ID in multi-core systems, 0..65535 (default=0)
       -- module configuration --
       MULDIV_USE   : boolean := true;  -- implement multiplier/divider unit? (default=true)
       WB32_USE     : boolean := true;  -- implement WB32 unit? (default=true)
@@ -346,6 +465,9 @@ package neo430_package is
       TRNG_USE     : boolean := false; -- implement TRNG? (default=false)
       EXIRQ_USE    : boolean := true;  -- implement EXIRQ? (default=true)
       FREQ_GEN_USE : boolean := true;  -- implement FREQ_GEN? (default=true)
+      BMU_USE      : boolean := false; -- implement bit manipulation unit? (default=false)
+      WBS_USE      : boolean := false; -- implement wishbone slave port (DMEM access)? (default=false)
+      MBOX_USE     : boolean := false; -- implement inter-core mailbox port? (default=false)
       -- boot configuration --
       BOOTLD_USE   : boolean := true; -- implement and use bootloader? (default=true)
       IMEM_AS_ROM  : boolean := false -- implement IMEM as read-only memory? (default=false)
@@ -353,6 +475,7 @@ package neo430_package is
     port (
       -- global control --
       clk_i      : in  std_ulogic; -- global clock, rising edge
+      clk_io_i   : in  std_ulogic := '0'; -- peripheral clock, rising edge, not used if IO_CLK_SPEED = 0
       rst_i      : in  std_ulogic; -- global reset, async, low-active
       -- gpio --
       gpio_o     : out std_ulogic_vector(15 downto 0); -- parallel output
@@ -368,6 +491,7 @@ package neo430_package is
       spi_mosi_o : out std_ulogic; -- serial data line out
       spi_miso_i : in  std_ulogic; -- serial data line in
       spi_cs_o   : out std_ulogic_vector(05 downto 0); -- SPI CS
+      spi_dq_io  : inout std_logic_vector(03 downto 0); -- SPI dual/quad data lines IO0..IO3
       twi_sda_io : inout std_logic; -- twi serial data line
       twi_scl_io : inout std_logic; -- twi serial clock line
       -- 32-bit wishbone interface --
@@ -379,6 +503,23 @@ package neo430_package is
       wb_stb_o   : out std_ulogic; -- strobe
       wb_cyc_o   : out std_ulogic; -- valid cycle
       wb_ack_i   : in  std_ulogic; -- transfer acknowledge
+      -- 16-bit wishbone slave interface (external DMEM access) --
+      wbs_adr_i  : in  std_ulogic_vector(15 downto 0); -- address
+      wbs_dat_i  : in  std_ulogic_vector(15 downto 0); -- write data
+      wbs_dat_o  : out std_ulogic_vector(15 downto 0); -- read data
+      wbs_we_i   : in  std_ulogic; -- read/write
+      wbs_sel_i  : in  std_ulogic_vector(01 downto 0); -- byte enable
+      wbs_stb_i  : in  std_ulogic; -- strobe
+      wbs_cyc_i  : in  std_ulogic; -- valid cycle
+      wbs_ack_o  : out std_ulogic; -- transfer acknowledge
+      wbs_irq_o  : out std_ulogic; -- doorbell interrupt to host
+      -- inter-core mailbox interface (connect to neo430_mailbox) --
+      mbox_rd_o  : out std_ulogic; -- read enable
+      mbox_wr_o  : out std_ulogic; -- write enable
+      mbox_adr_o : out std_ulogic_vector(02 downto 0); -- register (word) address
+      mbox_dat_o : out std_ulogic_vector(15 downto 0); -- write data
+      mbox_dat_i : in  std_ulogic_vector(15 downto 0); -- read data, valid one cycle after read enable
+      mbox_irq_i : in  std_ulogic; -- mailbox interrupt (message received / doorbell)
       -- external interrupts --
       ext_irq_i  : in  std_ulogic_vector(07 downto 0); -- external interrupt request lines
       ext_ack_o  : out std_ulogic_vector(07 downto 0)  -- external interrupt request acknowledges
@@ -388,19 +529,28 @@ package neo430_package is
   -- Component: CPU Control -----------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
   component neo430_control
+    generic (
+      CFU_USE   : boolean := false -- implement CFU custom instructions?
+    );
     port (
       -- global control --
       clk_i     : in  std_ulogic; -- global clock, rising edge
       rst_i     : in  std_ulogic; -- global reset, low-active, async
       -- memory interface --
       instr_i   : in  std_ulogic_vector(15 downto 0); -- instruction word from memory
+      stall_i   : in  std_ulogic; -- memory access not completed yet, hold CPU state
       -- control --
       sreg_i    : in  std_ulogic_vector(15 downto 0); -- current status register
+      rf_i      : in  std_ulogic_vector(03 downto 0); -- register file read data (MSP430X RPT Rn: repetition count)
       ctrl_o    : out std_ulogic_vector(ctrl_width_c-1 downto 0); -- control signals
       irq_vec_o : out std_ulogic_vector(01 downto 0); -- irq channel address
       imm_o     : out std_ulogic_vector(15 downto 0); -- branch offset
+      -- custom instructions --
+      cfu_fn_o  : out std_ulogic_vector(02 downto 0); -- CFU function select
+      cfu_ack_i : in  std_ulogic; -- CFU result valid
       -- irq lines --
-      irq_i     : in  std_ulogic_vector(03 downto 0)  -- IRQ lines
+      irq_i     : in  std_ulogic_vector(03 downto 0); -- IRQ lines
+      irq_ack_o : out std_ulogic_vector(03 downto 0)  -- IRQ handler started (vector fetch)
     );
   end component;
 
@@ -422,7 +572,8 @@ package neo430_package is
       -- control --
       ctrl_i : in  std_ulogic_vector(ctrl_width_c-1 downto 0);
       -- data output --
-      data_o : out std_ulogic_vector(15 downto 0); -- read data
+      data_o : out std_ulogic_vector(15 downto 0); -- read data (port A)
+      datb_o : out std_ulogic_vector(15 downto 0); -- read data (port B, use_dual_rf_c only)
       sreg_o : out std_ulogic_vector(15 downto 0)  -- current SR
     );
   end component;
@@ -435,10 +586,15 @@ package neo430_package is
       clk_i  : in  std_ulogic; -- global clock, rising edge
       -- operands --
       reg_i  : in  std_ulogic_vector(15 downto 0); -- data from reg file
+      regb_i : in  std_ulogic_vector(15 downto 0); -- data from reg file read port B
       mem_i  : in  std_ulogic_vector(15 downto 0); -- data from memory
       sreg_i : in  std_ulogic_vector(15 downto 0); -- current SR
       -- control --
       ctrl_i : in  std_ulogic_vector(ctrl_width_c-1 downto 0);
+      -- custom instructions --
+      opa_o  : out std_ulogic_vector(15 downto 0); -- operand A (source register)
+      opb_o  : out std_ulogic_vector(15 downto 0); -- operand B (destination register)
+      cfu_i  : in  std_ulogic_vector(15 downto 0); -- CFU result
       -- results --
       data_o : out std_ulogic_vector(15 downto 0); -- result
       flag_o : out std_ulogic_vector(04 downto 0)  -- new ALU flags
@@ -456,6 +612,7 @@ package neo430_package is
       mem_i      : in  std_ulogic_vector(15 downto 0); -- memory input
       imm_i      : in  std_ulogic_vector(15 downto 0); -- branch offset
       irq_sel_i  : in  std_ulogic_vector(01 downto 0); -- IRQ vector
+      xirq_sel_i : in  std_ulogic_vector(03 downto 0); -- external IRQ vector (3: vectored mode, 2..0: source)
       -- control --
       ctrl_i     : in  std_ulogic_vector(ctrl_width_c-1 downto 0);
       -- data output --
@@ -468,8 +625,9 @@ package neo430_package is
   -- -------------------------------------------------------------------------------------------
   component neo430_cpu
     generic (
-      BOOTLD_USE  : boolean := true; -- implement and use bootloader?
-      IMEM_AS_ROM : boolean := false -- implement IMEM as read-only memory?
+      BOOTLD_USE  : boolean := true;  -- implement and use bootloader?
+      IMEM_AS_ROM : boolean := false; -- implement IMEM as read-only memory?
+      CFU_USE     : boolean := false  -- implement CFU custom instructions?
     );
     port(
       -- global control --
@@ -482,8 +640,18 @@ package neo430_package is
       mem_addr_o : out std_ulogic_vector(15 downto 0); -- address
       mem_data_o : out std_ulogic_vector(15 downto 0); -- write data
       mem_data_i : in  std_ulogic_vector(15 downto 0); -- read data
+      mem_wait_i : in  std_ulogic; -- memory access not completed yet, stall CPU
       -- interrupt system --
-      irq_i      : in  std_ulogic_vector(03 downto 0)  -- interrupt requests
+      irq_i      : in  std_ulogic_vector(03 downto 0); -- interrupt requests
+      irq_ack_o  : out std_ulogic_vector(03 downto 0); -- interrupt handler started
+      xirq_sel_i : in  std_ulogic_vector(03 downto 0); -- external IRQ vector (3: vectored mode, 2..0: source)
+      -- custom instruction interface --
+      cfu_req_o  : out std_ulogic; -- start custom instruction
+      cfu_fn_o   : out std_ulogic_vector(02 downto 0); -- function select
+      cfu_opa_o  : out std_ulogic_vector(15 downto 0); -- operand A (source register)
+      cfu_opb_o  : out std_ulogic_vector(15 downto 0); -- operand B (destination register)
+      cfu_res_i  : in  std_ulogic_vector(15 downto 0); -- result
+      cfu_ack_i  : in  std_ulogic  -- result valid
     );
   end component;
 
@@ -522,6 +690,30 @@ package neo430_package is
     );
   end component;
 
+  -- Component: Banked Far Memory (XMEM) ----------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  component neo430_xmem
+    generic (
+      XMEM_SIZE : natural := 64*1024; -- far memory size in bytes, power of two, 16kB..1MB
+      IMEM_SIZE : natural := 4*1024   -- internal IMEM size in bytes, max 32kB
+    );
+    port (
+      -- host access: control registers --
+      clk_i      : in  std_ulogic; -- global clock line
+      rden_i     : in  std_ulogic; -- read enable
+      wren_i     : in  std_ulogic; -- write enable
+      addr_i     : in  std_ulogic_vector(15 downto 0); -- address
+      data_i     : in  std_ulogic_vector(15 downto 0); -- data in
+      data_o     : out std_ulogic_vector(15 downto 0); -- data out
+      -- host access: memory window --
+      win_rden_i : in  std_ulogic; -- read enable
+      win_wren_i : in  std_ulogic_vector(01 downto 0); -- write enable
+      win_addr_i : in  std_ulogic_vector(15 downto 0); -- address
+      win_data_i : in  std_ulogic_vector(15 downto 0); -- data in
+      win_data_o : out std_ulogic_vector(15 downto 0)  -- data out
+    );
+  end component;
+
   -- Component: Bootloader ROM --------------------------------------------------------------
   -- -------------------------------------------------------------------------------------------
   component neo430_boot_rom
@@ -611,6 +803,7 @@ package neo430_package is
       spi_mosi_o  : out std_ulogic; -- SPI master out, slave in
       spi_miso_i  : in  std_ulogic; -- SPI master in, slave out
       spi_cs_o    : out std_ulogic_vector(05 downto 0); -- SPI CS
+      spi_dq_io   : inout std_logic_vector(03 downto 0); -- SPI bidirectional data lines IO0..IO3 (dual/quad mode)
       -- interrupt --
       spi_irq_o   : out std_ulogic -- transmission done interrupt
     );
@@ -690,6 +883,78 @@ package neo430_package is
     );
   end component;
 
+  -- Component: Bit Manipulation Unit (BMU) ------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  component neo430_bmu
+    port (
+      -- host access --
+      clk_i  : in  std_ulogic; -- global clock line
+      rden_i : in  std_ulogic; -- read enable
+      wren_i : in  std_ulogic; -- write enable
+      addr_i : in  std_ulogic_vector(15 downto 0); -- address
+      data_i : in  std_ulogic_vector(15 downto 0); -- data in
+      data_o : out std_ulogic_vector(15 downto 0)  -- data out
+    );
+  end component;
+
+  -- Component: Wishbone Slave Port (WBS) ---------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  component neo430_wb_slave
+    generic (
+      DMEM_SIZE : natural := 2*1024 -- internal DMEM size in bytes
+    );
+    port (
+      -- host access --
+      clk_i      : in  std_ulogic; -- global clock line
+      rst_i      : in  std_ulogic; -- global reset, low-active, async
+      rden_i     : in  std_ulogic; -- read enable
+      wren_i     : in  std_ulogic; -- write enable
+      addr_i     : in  std_ulogic_vector(15 downto 0); -- address
+      data_i     : in  std_ulogic_vector(15 downto 0); -- data in
+      data_o     : out std_ulogic_vector(15 downto 0); -- data out
+      irq_o      : out std_ulogic; -- doorbell interrupt
+      -- DMEM access --
+      mem_req_o  : out std_ulogic; -- DMEM access request
+      mem_done_i : in  std_ulogic; -- DMEM access completed, read data valid
+      mem_rden_o : out std_ulogic; -- DMEM read enable
+      mem_wren_o : out std_ulogic_vector(01 downto 0); -- DMEM write enable
+      mem_addr_o : out std_ulogic_vector(15 downto 0); -- DMEM address
+      mem_data_o : out std_ulogic_vector(15 downto 0); -- DMEM write data
+      mem_data_i : in  std_ulogic_vector(15 downto 0); -- DMEM read data
+      -- wishbone slave interface --
+      wbs_adr_i  : in  std_ulogic_vector(15 downto 0); -- address
+      wbs_dat_i  : in  std_ulogic_vector(15 downto 0); -- write data
+      wbs_dat_o  : out std_ulogic_vector(15 downto 0); -- read data
+      wbs_we_i   : in  std_ulogic; -- read/write
+      wbs_sel_i  : in  std_ulogic_vector(01 downto 0); -- byte enable
+      wbs_stb_i  : in  std_ulogic; -- strobe
+      wbs_cyc_i  : in  std_ulogic; -- valid cycle
+      wbs_ack_o  : out std_ulogic; -- transfer acknowledge
+      wbs_irq_o  : out std_ulogic  -- doorbell interrupt to host
+    );
+  end component;
+
+  -- Component: Inter-Core Mailbox (MBOX) ---------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  component neo430_mailbox
+    generic (
+      NUM_CORES : natural := 2; -- number of attached cores (1..8)
+      FIFO_SIZE : natural := 4  -- message FIFO depth per core (power of two, min 2)
+    );
+    port (
+      -- global control --
+      clk_i : in  std_ulogic; -- global clock line (shared by all cores)
+      rst_i : in  std_ulogic; -- global reset, low-active, async
+      -- core ports (core n uses bits of slice n) --
+      rd_i  : in  std_ulogic_vector(NUM_CORES-1 downto 0); -- read enable
+      wr_i  : in  std_ulogic_vector(NUM_CORES-1 downto 0); -- write enable
+      adr_i : in  std_ulogic_vector(NUM_CORES*3-1 downto 0); -- register (word) address
+      dat_i : in  std_ulogic_vector(NUM_CORES*16-1 downto 0); -- write data
+      dat_o : out std_ulogic_vector(NUM_CORES*16-1 downto 0); -- read data
+      irq_o : out std_ulogic_vector(NUM_CORES-1 downto 0)  -- interrupt (message received / doorbell)
+    );
+  end component;
+
   -- Component: Custom Functions Unit (CFU) -------------------------------------------------
   -- -------------------------------------------------------------------------------------------
   component neo430_cfu
@@ -703,7 +968,14 @@ package neo430_package is
       data_o      : out std_ulogic_vector(15 downto 0); -- data out
       -- clock generator --
       clkgen_en_o : out std_ulogic; -- enable clock generator
-      clkgen_i    : in  std_ulogic_vector(07 downto 0)
+      clkgen_i    : in  std_ulogic_vector(07 downto 0);
+      -- custom instructions --
+      ci_req_i    : in  std_ulogic; -- start custom instruction
+      ci_fn_i     : in  std_ulogic_vector(02 downto 0); -- function select
+      ci_opa_i    : in  std_ulogic_vector(15 downto 0); -- operand A (source register)
+      ci_opb_i    : in  std_ulogic_vector(15 downto 0); -- operand B (destination register)
+      ci_res_o    : out std_ulogic_vector(15 downto 0); -- result
+      ci_ack_o    : out std_ulogic  -- result valid
       -- custom IOs --
 --    ...
     );
@@ -779,6 +1051,8 @@ package neo430_package is
       data_o    : out std_ulogic_vector(15 downto 0); -- data out
       -- cpu interrupt --
       cpu_irq_o : out std_ulogic;
+      cpu_ack_i : in  std_ulogic; -- CPU has started the interrupt handler
+      cpu_vec_o : out std_ulogic_vector(3 downto 0); -- vectored mode & IRQ source
       -- external interrupt lines --
       ext_irq_i : in  std_ulogic_vector(7 downto 0); -- IRQ
       ext_ack_o : out std_ulogic_vector(7 downto 0)  -- acknowledge
@@ -810,10 +1084,13 @@ package neo430_package is
     generic (
       -- general configuration --
       CLOCK_SPEED  : natural := 100000000; -- main clock in Hz
+      IO_CLK_SPEED : natural := 0; -- peripheral clock in Hz, 0 = main clock
       IMEM_SIZE    : natural := 4*1024; -- internal IMEM size in bytes
       DMEM_SIZE    : natural := 2*1024; -- internal DMEM size in bytes
+      XMEM_SIZE    : natural := 0; -- banked far memory size in bytes
       -- additional configuration --
       USER_CODE    : std_ulogic_vector(15 downto 0) := x"0000"; -- custom user code
+      HART_ID      : natural := 0; -- core ID in multi-core systems
       -- module configuration --
       MULDIV_USE   : boolean := true; -- implement multiplier/divider unit?
       WB32_USE     : boolean := true; -- implement WB32 unit?
@@ -829,6 +1106,9 @@ package neo430_package is
       TRNG_USE     : boolean := true; -- implement TRNG?
       EXIRQ_USE    : boolean := true; -- implement EXIRQ?
       FREQ_GEN_USE : boolean := true; -- implement FREQ_GEN?
+      BMU_USE      : boolean := true; -- implement BMU?
+      WBS_USE      : boolean := true; -- implement wishbone slave port?
+      MBOX_USE     : boolean := true; -- implement inter-core mailbox port?
       -- boot configuration --
       BOOTLD_USE   : boolean := true; -- implement and use bootloader?
       IMEM_AS_ROM  : boolean := false -- implement IMEM as read-only memory?
@@ -843,6 +1123,40 @@ package neo430_package is
     );
   end component;
 
+  -- Component: IO Clock Domain Bridge ------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  component neo430_io_bridge
+    port (
+      -- host access (CPU clock domain) --
+      clk_i        : in  std_ulogic; -- CPU clock line
+      rst_i        : in  std_ulogic; -- external reset, low-active, use as async
+      rden_i       : in  std_ulogic; -- read enable
+      wren_i       : in  std_ulogic; -- write enable
+      mden_i       : in  std_ulogic; -- read-modify-write enable
+      addr_i       : in  std_ulogic_vector(15 downto 0); -- address
+      data_i       : in  std_ulogic_vector(15 downto 0); -- data in
+      mmsk_i       : in  std_ulogic_vector(15 downto 0); -- modify: bits to modify
+      mval_i       : in  std_ulogic_vector(15 downto 0); -- modify: new bit values
+      mtgl_i       : in  std_ulogic; -- modify: toggle bits instead
+      data_o       : out std_ulogic_vector(15 downto 0); -- data out
+      busy_o       : out std_ulogic; -- access in progress
+      irq_o        : out std_ulogic_vector(01 downto 0); -- interrupt requests
+      wdt_rst_o    : out std_ulogic; -- watchdog reset, low-active, use as async
+      pwm_o        : out std_ulogic; -- GPIO PWM
+      -- device access (IO clock domain) --
+      clk_io_i     : in  std_ulogic; -- IO clock line
+      io_rst_o     : out std_ulogic; -- external reset, low-active, use as async
+      io_rden_o    : out std_ulogic; -- read enable
+      io_wren_o    : out std_ulogic; -- write enable
+      io_addr_o    : out std_ulogic_vector(15 downto 0); -- address
+      io_data_o    : out std_ulogic_vector(15 downto 0); -- data out
+      io_data_i    : in  std_ulogic_vector(15 downto 0); -- data in
+      io_irq_i     : in  std_ulogic_vector(01 downto 0); -- interrupt requests
+      io_wdt_rst_i : in  std_ulogic; -- watchdog reset, low-active
+      io_pwm_i     : in  std_ulogic  -- GPIO PWM
+    );
+  end component;
+
 end neo430_package;
 
 package body neo430_package is
@@ -885,7 +1199,7 @@ package body neo430_package is
   -- Function: Count number of set bits (aka population count) ------------------------------
   -- -------------------------------------------------------------------------------------------
   function set_bits_f(input : std_ulogic_vector) return natural is
-    variable cnt_v : natural range 0 to input'length-1;
+    variable cnt_v : natural range 0 to input'length;
   begin
     cnt_v := 0;
     for i in input'length-1 downto 0 loop
@@ -1032,4 +1346,19 @@ package body neo430_package is
     return tmp_v;
   end function xor_all_f;
 
+  -- Function: IO register with read side effect (read pops/clears data) --------------------
+  -- -------------------------------------------------------------------------------------------
+  function io_rd_side_effect_f(addr : std_ulogic_vector(15 downto 0)) return std_ulogic is
+  begin
+    if (addr = uart_rtx_addr_c)   or -- clears RX data available flag
+       (addr = spi_rtx_addr_c)    or -- pops RX FIFO
+       (addr = trng_ctrl_addr_c)  or -- clears data ready flag
+       (addr = twi_rxd_addr_c)    or -- pops RX FIFO
+       (addr = xmem_data_addr_c)  or -- increments XMEM address pointer
+       (addr(15 downto index_size_f(mbox_size_c)) = mbox_base_c(15 downto index_size_f(mbox_size_c))) then -- mailbox (RX pop, doorbell/lock clear)
+      return '1';
+    end if;
+    return '0';
+  end function io_rd_side_effect_f;
+
 end neo430_package;
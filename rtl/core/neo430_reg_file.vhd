@@ -57,7 +57,8 @@ entity neo430_reg_file is
     -- control --
     ctrl_i : in  std_ulogic_vector(ctrl_width_c-1 downto 0);
     -- data output --
-    data_o : out std_ulogic_vector(15 downto 0); -- read data
+    data_o : out std_ulogic_vector(15 downto 0); -- read data (port A)
+    datb_o : out std_ulogic_vector(15 downto 0); -- read data (port B, use_dual_rf_c only)
     sreg_o : out std_ulogic_vector(15 downto 0)  -- current SR
   );
 end neo430_reg_file;
@@ -70,9 +71,14 @@ architecture neo430_reg_file_rtl of neo430_reg_file is
   -- can be mapped to distributed RAM saving logic resources
   constant pc_boot_addr_c : std_ulogic_vector(15 downto 0) := cond_sel_stdulogicvector_f(BOOTLD_USE, boot_base_c, imem_base_c);
 
-  -- register file (including dummy regs) --
-  type   reg_file_t is array (15 downto 0) of std_ulogic_vector(15 downto 0);
+  -- shadow register bank implemented? --
+  constant shadow_en_c : boolean := (shadow_rf_irq_c /= "0000");
+
+  -- register file (including dummy regs and R4..R15 of the shadow bank) --
+  type   reg_file_t is array (cond_sel_natural_f(shadow_en_c, 31, 15) downto 0) of std_ulogic_vector(15 downto 0);
   signal reg_file : reg_file_t;
+  signal rf_adr   : std_ulogic_vector(04 downto 0); -- physical register address
+  signal rf_badr  : std_ulogic_vector(04 downto 0); -- physical register address, read port B
   signal sreg     : std_ulogic_vector(15 downto 0);
   signal sreg_int : std_ulogic_vector(15 downto 0);
 
@@ -110,6 +116,9 @@ begin
         if (use_xalu_c = true) then -- implement parity computation?
           sreg(sreg_p_c) <= in_data(sreg_p_c);
         end if;
+        if (shadow_en_c = true) then -- implement shadow register bank?
+          sreg(sreg_b_c) <= in_data(sreg_b_c);
+        end if;
         if (IMEM_AS_ROM = false) then -- r-flag is 0 when IMEM is ROM
           sreg(sreg_r_c) <= in_data(sreg_r_c);
         end if;
@@ -122,6 +131,10 @@ begin
         -- disable interrupt enable --
         if (ctrl_i(ctrl_rf_dgie_c) = '1') then
           sreg(sreg_i_c) <= '0';
+        end if;
+        -- switch to shadow register bank --
+        if (ctrl_i(ctrl_rf_bank_c) = '1') and (shadow_en_c = true) then
+          sreg(sreg_b_c) <= '1';
         end if;
          -- update ALU flags --
         if (ctrl_i(ctrl_rf_fup_c) = '1') then
@@ -153,6 +166,9 @@ begin
     if (use_xalu_c = true) then -- implement parity computation?
       sreg_o(sreg_p_c) <= sreg(sreg_p_c);
     end if;
+    if (shadow_en_c = true) then -- implement shadow register bank?
+      sreg_o(sreg_b_c) <= sreg(sreg_b_c);
+    end if;
     -- SREG for user --
     sreg_int <= (others => '0');
     sreg_int(sreg_c_c) <= sreg(sreg_c_c);
@@ -166,14 +182,25 @@ begin
     if (use_xalu_c = true) then -- implement parity computation?
       sreg_int(sreg_p_c) <= sreg(sreg_p_c);
     end if;
+    if (shadow_en_c = true) then -- implement shadow register bank?
+      sreg_int(sreg_b_c) <= sreg(sreg_b_c);
+    end if;
   end process sreg_combine;
 
+  -- physical register address: R4..R15 are banked, PC, SP, SR and CG are shared --
+  rf_adr(4) <= sreg(sreg_b_c) when (shadow_en_c = true) and (ctrl_i(ctrl_rf_adr3_c downto ctrl_rf_adr2_c) /= "00") else '0';
+  rf_adr(3 downto 0) <= ctrl_i(ctrl_rf_adr3_c downto ctrl_rf_adr0_c);
+
+  -- physical register address of read port B (same banking) --
+  rf_badr(4) <= sreg(sreg_b_c) when (shadow_en_c = true) and (ctrl_i(ctrl_rf_badr3_c downto ctrl_rf_badr2_c) /= "00") else '0';
+  rf_badr(3 downto 0) <= ctrl_i(ctrl_rf_badr3_c downto ctrl_rf_badr0_c);
+
   -- general purpose register file (including PC, SP, dummy SR and dummy CG) --
   rf_write: process(clk_i)
   begin
     if rising_edge(clk_i) then
       if (ctrl_i(ctrl_rf_wb_en_c) = '1') then -- valid register file write
-        reg_file(to_integer(unsigned(ctrl_i(ctrl_rf_adr3_c downto ctrl_rf_adr0_c)))) <= in_data;
+        reg_file(to_integer(unsigned(rf_adr))) <= in_data;
       end if;
     end if;
   end process rf_write;
@@ -181,7 +208,7 @@ begin
 
   -- Register File Read Access ------------------------------------------------
   -- -----------------------------------------------------------------------------
-  rf_read: process(ctrl_i, reg_file, sreg_int)
+  rf_read: process(ctrl_i, rf_adr, reg_file, sreg_int)
     variable const_sel_v : std_ulogic_vector(2 downto 0);
   begin
     if ((ctrl_i(ctrl_rf_adr3_c downto ctrl_rf_adr0_c) = reg_sr_c) or
@@ -200,9 +227,24 @@ begin
         when others => data_o <= (others => '-');
       end case;
     else -- gp register file read access
-      data_o <= reg_file(to_integer(unsigned(ctrl_i(ctrl_rf_adr3_c downto ctrl_rf_adr0_c))));
+      data_o <= reg_file(to_integer(unsigned(rf_adr)));
     end if;
   end process rf_read;
 
+  -- second read port: destination operand (register direct only), fetched together with the source operand --
+  -- the RF is written through a single port only, so this maps to a second distributed RAM copy of the array --
+  rf_read_b: process(ctrl_i, rf_badr, reg_file, sreg_int)
+  begin
+    if (use_dual_rf_c = false) then
+      datb_o <= (others => '0'); -- not implemented
+    elsif (ctrl_i(ctrl_rf_badr3_c downto ctrl_rf_badr0_c) = reg_sr_c) then
+      datb_o <= sreg_int; -- read SR
+    elsif (ctrl_i(ctrl_rf_badr3_c downto ctrl_rf_badr0_c) = reg_cg_c) then
+      datb_o <= x"0000"; -- CG in register mode: 0
+    else -- gp register file read access
+      datb_o <= reg_file(to_integer(unsigned(rf_badr)));
+    end if;
+  end process rf_read_b;
+
 
 end neo430_reg_file_rtl;
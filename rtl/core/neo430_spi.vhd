@@ -2,7 +2,12 @@
 -- #  << NEO430 - Serial Peripheral Interface >>                                                   #
 -- # ********************************************************************************************* #
 -- # Frame format: 8-bit or 16-bit, MSB or LSB first, 2 clock modes, 8 clock speeds, 6 CS lines.   #
--- # Interrupt: SPI_transfer_done                                                                  #
+-- # TX and RX FIFOs (spi_fifo_size_c words) allow back-to-back frames without CPU interaction. A  #
+-- # transfer-length counter (TLEN) automatically sends dummy frames for burst reads.              #
+-- # Received frames are only pushed to the RX FIFO if FCT.RX_EN is set; otherwise a read of RTX   #
+-- # returns the last received frame (single transfers without FIFO handling).                     #
+-- # Dual/quad data line modes (MSB first) via bidirectional spi_dq_io lines for fast flash IO.    #
+-- # Interrupt: SPI_transfer_done, TX FIFO empty, RX FIFO half full, burst done                    #
 -- # ********************************************************************************************* #
 -- # BSD 3-Clause License                                                                          #
 -- #                                                                                               #
@@ -59,6 +64,7 @@ entity neo430_spi is
     spi_mosi_o  : out std_ulogic; -- SPI master out, slave in
     spi_miso_i  : in  std_ulogic; -- SPI master in, slave out
     spi_cs_o    : out std_ulogic_vector(05 downto 0); -- SPI CS
+    spi_dq_io   : inout std_logic_vector(03 downto 0); -- SPI bidirectional data lines IO0..IO3 (dual/quad mode)
     -- interrupt --
     spi_irq_o   : out std_ulogic -- transmission done interrupt
   );
@@ -69,6 +75,7 @@ architecture neo430_spi_rtl of neo430_spi is
   -- IO space: module base address --
   constant hi_abb_c : natural := index_size_f(io_size_c)-1; -- high address boundary bit
   constant lo_abb_c : natural := index_size_f(spi_size_c); -- low address boundary bit
+  constant lo_abb_ext_c : natural := index_size_f(spi_ext_size_c); -- low address boundary bit (extension registers)
 
   -- control reg bits --
   constant ctrl_spi_cs_sel0_c : natural :=  0; -- r/w: spi CS 0
@@ -86,22 +93,86 @@ architecture neo430_spi_rtl of neo430_spi is
   constant ctrl_spi_dir_c     : natural := 12; -- r/w: shift direction (0: MSB first, 1: LSB first)
   constant ctrl_spi_size_c    : natural := 13; -- r/w: data size(0: 8-bit, 1: 16-bit)
   --       reserved           : natural := 14;
-  constant ctrl_spi_busy_c    : natural := 15; -- r/-: spi transceiver is busy
+  constant ctrl_spi_busy_c    : natural := 15; -- r/-: spi transceiver is busy (including pending FIFO/burst frames)
+
+  -- fifo control reg bits --
+  constant fct_txe_irq_c  : natural :=  0; -- r/w: interrupt when TX FIFO becomes empty
+  constant fct_rxh_irq_c  : natural :=  1; -- r/w: interrupt when RX FIFO becomes at least half full
+  constant fct_done_irq_c : natural :=  2; -- r/w: interrupt when burst is done (TX FIFO empty, TLEN = 0, transceiver idle)
+  constant fct_tx_clr_c   : natural :=  3; -- -/w: clear TX FIFO and TLEN
+  constant fct_rx_clr_c   : natural :=  4; -- -/w: clear RX FIFO and overrun flag
+  constant fct_size0_c    : natural :=  5; -- r/-: log2(FIFO depth) bit 0
+  constant fct_size1_c    : natural :=  6; -- r/-: log2(FIFO depth) bit 1
+  constant fct_size2_c    : natural :=  7; -- r/-: log2(FIFO depth) bit 2
+  constant fct_tx_empty_c : natural :=  8; -- r/-: TX FIFO is empty
+  constant fct_tx_full_c  : natural :=  9; -- r/-: TX FIFO is full
+  constant fct_rx_avail_c : natural := 10; -- r/-: RX FIFO data available
+  constant fct_rx_half_c  : natural := 11; -- r/-: RX FIFO is at least half full
+  constant fct_rx_full_c  : natural := 12; -- r/-: RX FIFO is full
+  constant fct_rx_ovr_c   : natural := 13; -- r/-: RX FIFO overrun (data lost)
+  constant fct_rx_en_c    : natural := 14; -- r/w: push received frames into RX FIFO (0: RTX returns last received frame)
+  --       reserved       : natural := 15;
+
+  -- quad spi control reg bits --
+  constant qct_mode0_c : natural := 0; -- r/w: data line mode bit 0 (00: single, 01: dual, 1-: quad)
+  constant qct_mode1_c : natural := 1; -- r/w: data line mode bit 1
+  constant qct_wr_c    : natural := 2; -- r/w: drive data lines in dual/quad mode (0: read, 1: write)
+  constant qct_dq_en_c : natural := 3; -- r/w: use spi_dq_io lines instead of spi_mosi_o/spi_miso_i
+
+  -- fifo configuration --
+  constant fifo_abb_c : natural := index_size_f(spi_fifo_size_c); -- fifo pointer size
 
   -- access control --
-  signal acc_en : std_ulogic; -- module access enable
-  signal addr   : std_ulogic_vector(15 downto 0); -- access address
-  signal wr_en  : std_ulogic; -- word write enable
-  signal rd_en  : std_ulogic; -- read enable
+  signal acc_en     : std_ulogic; -- module access enable
+  signal acc_ext_en : std_ulogic; -- module extension registers access enable
+  signal addr       : std_ulogic_vector(15 downto 0); -- access address
+  signal addr_ext   : std_ulogic_vector(15 downto 0); -- access address (extension registers)
+  signal wr_en      : std_ulogic; -- word write enable
+  signal rd_en      : std_ulogic; -- read enable
+  signal wr_ext_en  : std_ulogic; -- word write enable (extension registers)
+  signal rd_ext_en  : std_ulogic; -- read enable (extension registers)
 
   -- accessible regs --
   signal ctrl : std_ulogic_vector(15 downto 0);
+  signal fct  : std_ulogic_vector(02 downto 0); -- fifo irq configuration
+  signal rx_en : std_ulogic; -- RX FIFO enable
+  signal tlen : std_ulogic_vector(15 downto 0); -- remaining burst (dummy) frames
+  signal qct  : std_ulogic_vector(03 downto 0); -- data line mode configuration
+
+  -- fifos --
+  type fifo_mem_t is array (0 to spi_fifo_size_c-1) of std_ulogic_vector(15 downto 0);
+  signal tx_fifo_mem   : fifo_mem_t;
+  signal tx_fifo_w_pnt : std_ulogic_vector(fifo_abb_c downto 0);
+  signal tx_fifo_r_pnt : std_ulogic_vector(fifo_abb_c downto 0);
+  signal tx_fifo_we    : std_ulogic;
+  signal tx_fifo_re    : std_ulogic;
+  signal tx_fifo_clr   : std_ulogic;
+  signal tx_fifo_empty : std_ulogic;
+  signal tx_fifo_full  : std_ulogic;
+  signal tx_fifo_rdata : std_ulogic_vector(15 downto 0);
+  signal rx_fifo_mem   : fifo_mem_t;
+  signal rx_fifo_w_pnt : std_ulogic_vector(fifo_abb_c downto 0);
+  signal rx_fifo_r_pnt : std_ulogic_vector(fifo_abb_c downto 0);
+  signal rx_fifo_level : std_ulogic_vector(fifo_abb_c downto 0);
+  signal rx_fifo_we    : std_ulogic;
+  signal rx_fifo_re    : std_ulogic;
+  signal rx_fifo_clr   : std_ulogic;
+  signal rx_fifo_empty : std_ulogic;
+  signal rx_fifo_half  : std_ulogic;
+  signal rx_fifo_full  : std_ulogic;
+  signal rx_fifo_ovr   : std_ulogic;
+
+  -- burst control --
+  signal tlen_dec  : std_ulogic; -- start of dummy frame
+  signal busy_all  : std_ulogic; -- transceiver, fifo or burst busy
+  signal irq_sync  : std_ulogic_vector(02 downto 0); -- edge detector for fifo interrupts
 
   -- clock generator --
   signal spi_clk : std_ulogic;
 
   -- spi transceiver --
   signal spi_busy     : std_ulogic;
+  signal spi_done     : std_ulogic;
   signal spi_state0   : std_ulogic;
   signal spi_state1   : std_ulogic;
   signal spi_rtx_sreg : std_ulogic_vector(15 downto 0);
@@ -109,6 +180,15 @@ architecture neo430_spi_rtl of neo430_spi is
   signal spi_bitcnt   : std_ulogic_vector(04 downto 0);
   signal spi_miso_ff0 : std_ulogic;
   signal spi_miso_ff1 : std_ulogic;
+  signal spi_sdi      : std_ulogic; -- serial data input (single mode)
+  signal spi_sreg_nxt : std_ulogic_vector(15 downto 0); -- shifted frame
+
+  -- dual/quad data lines --
+  signal spi_dq_ff0 : std_ulogic_vector(03 downto 0);
+  signal spi_dq_ff1 : std_ulogic_vector(03 downto 0);
+  signal spi_dq_o   : std_ulogic_vector(03 downto 0);
+  signal spi_dq_out : std_ulogic_vector(03 downto 0);
+  signal spi_dq_oe  : std_ulogic_vector(03 downto 0);
 
 begin
 
@@ -119,6 +199,11 @@ begin
   wr_en  <= acc_en and wren_i;
   rd_en  <= acc_en and rden_i;
 
+  acc_ext_en <= '1' when (addr_i(hi_abb_c downto lo_abb_ext_c) = spi_ext_base_c(hi_abb_c downto lo_abb_ext_c)) else '0';
+  addr_ext   <= spi_ext_base_c(15 downto lo_abb_ext_c) & addr_i(lo_abb_ext_c-1 downto 1) & '0'; -- word aligned
+  wr_ext_en  <= acc_ext_en and wren_i;
+  rd_ext_en  <= acc_ext_en and rden_i;
+
 
   -- Write access -------------------------------------------------------------
   -- -----------------------------------------------------------------------------
@@ -130,10 +215,135 @@ begin
           ctrl <= data_i;
         end if;
       end if;
+      -- fifo/burst configuration, reset while SPI is disabled --
+      if (ctrl(ctrl_spi_en_c) = '0') then
+        fct   <= (others => '0');
+        rx_en <= '0';
+        tlen  <= (others => '0');
+        qct  <= (others => '0');
+      else
+        if (wr_ext_en = '1') and (addr_ext = spi_fct_addr_c) then
+          fct   <= data_i(fct_done_irq_c downto fct_txe_irq_c);
+          rx_en <= data_i(fct_rx_en_c);
+        end if;
+        if (wr_ext_en = '1') and (addr_ext = spi_qct_addr_c) then
+          qct <= data_i(qct_dq_en_c downto qct_mode0_c);
+        end if;
+        if (wr_ext_en = '1') and (addr_ext = spi_tlen_addr_c) then
+          tlen <= data_i;
+        elsif (tx_fifo_clr = '1') then
+          tlen <= (others => '0');
+        elsif (tlen_dec = '1') then
+          tlen <= std_ulogic_vector(unsigned(tlen) - 1);
+        end if;
+      end if;
     end if;
   end process wr_access;
 
 
+  -- TX FIFO ------------------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  tx_fifo_we  <= '1' when (wr_en = '1') and (addr = spi_rtx_addr_c) and (tx_fifo_full = '0') else '0';
+  tx_fifo_clr <= '1' when (ctrl(ctrl_spi_en_c) = '0') or ((wr_ext_en = '1') and (addr_ext = spi_fct_addr_c) and (data_i(fct_tx_clr_c) = '1')) else '0';
+
+  tx_fifo_sync: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      if (tx_fifo_clr = '1') then
+        tx_fifo_w_pnt <= (others => '0');
+        tx_fifo_r_pnt <= (others => '0');
+      else
+        if (tx_fifo_we = '1') then
+          tx_fifo_w_pnt <= std_ulogic_vector(unsigned(tx_fifo_w_pnt) + 1);
+        end if;
+        if (tx_fifo_re = '1') then
+          tx_fifo_r_pnt <= std_ulogic_vector(unsigned(tx_fifo_r_pnt) + 1);
+        end if;
+      end if;
+      if (tx_fifo_we = '1') then
+        tx_fifo_mem(to_integer(unsigned(tx_fifo_w_pnt(fifo_abb_c-1 downto 0)))) <= data_i;
+      end if;
+    end if;
+  end process tx_fifo_sync;
+
+  -- status --
+  tx_fifo_rdata <= tx_fifo_mem(to_integer(unsigned(tx_fifo_r_pnt(fifo_abb_c-1 downto 0))));
+  tx_fifo_empty <= '1' when (tx_fifo_r_pnt = tx_fifo_w_pnt) else '0';
+  tx_fifo_full  <= '1' when (tx_fifo_r_pnt(fifo_abb_c) /= tx_fifo_w_pnt(fifo_abb_c)) and
+                            (tx_fifo_r_pnt(fifo_abb_c-1 downto 0) = tx_fifo_w_pnt(fifo_abb_c-1 downto 0)) else '0';
+
+
+  -- RX FIFO ------------------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  rx_fifo_re  <= '1' when (rd_en = '1') and (addr = spi_rtx_addr_c) and (rx_en = '1') and (rx_fifo_empty = '0') else '0';
+  rx_fifo_clr <= '1' when (ctrl(ctrl_spi_en_c) = '0') or ((wr_ext_en = '1') and (addr_ext = spi_fct_addr_c) and (data_i(fct_rx_clr_c) = '1')) else '0';
+
+  rx_fifo_sync: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      if (rx_fifo_clr = '1') then
+        rx_fifo_w_pnt <= (others => '0');
+        rx_fifo_r_pnt <= (others => '0');
+        rx_fifo_ovr   <= '0';
+      else
+        if (rx_fifo_we = '1') then
+          if (rx_fifo_full = '0') then
+            rx_fifo_w_pnt <= std_ulogic_vector(unsigned(rx_fifo_w_pnt) + 1);
+          else -- data lost
+            rx_fifo_ovr <= '1';
+          end if;
+        end if;
+        if (rx_fifo_re = '1') then
+          rx_fifo_r_pnt <= std_ulogic_vector(unsigned(rx_fifo_r_pnt) + 1);
+        end if;
+      end if;
+      if (rx_fifo_we = '1') and (rx_fifo_full = '0') then
+        rx_fifo_mem(to_integer(unsigned(rx_fifo_w_pnt(fifo_abb_c-1 downto 0)))) <= spi_rx_data;
+      end if;
+    end if;
+  end process rx_fifo_sync;
+
+  -- status --
+  rx_fifo_level <= std_ulogic_vector(unsigned(rx_fifo_w_pnt) - unsigned(rx_fifo_r_pnt));
+  rx_fifo_empty <= '1' when (rx_fifo_r_pnt = rx_fifo_w_pnt) else '0';
+  rx_fifo_half  <= '1' when (unsigned(rx_fifo_level) >= (spi_fifo_size_c/2)) else '0';
+  rx_fifo_full  <= rx_fifo_level(fifo_abb_c);
+
+
+  -- Interrupt Generator ------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  irq_gen: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      irq_sync <= (not busy_all) & rx_fifo_half & tx_fifo_empty;
+      spi_irq_o <= '0';
+      if (ctrl(ctrl_spi_en_c) = '1') then
+        if (ctrl(ctrl_spi_irq_en_c) = '1') and (spi_done = '1') then -- single transfer done
+          spi_irq_o <= '1';
+        end if;
+        if (fct(fct_txe_irq_c) = '1') and (tx_fifo_empty = '1') and (irq_sync(0) = '0') then -- TX FIFO became empty
+          spi_irq_o <= '1';
+        end if;
+        if (fct(fct_rxh_irq_c) = '1') and (rx_fifo_half = '1') and (irq_sync(1) = '0') then -- RX FIFO became half full
+          spi_irq_o <= '1';
+        end if;
+        if (fct(fct_done_irq_c) = '1') and (busy_all = '0') and (irq_sync(2) = '0') then -- burst done
+          spi_irq_o <= '1';
+        end if;
+      end if;
+    end if;
+  end process irq_gen;
+
+
+  -- FIFO size check --
+  fifo_size_check: process(clk_i)
+  begin
+    if (is_power_of_two_f(spi_fifo_size_c, 7) = false) or (spi_fifo_size_c < 2) then
+      assert false report "SPI FIFO size (spi_fifo_size_c) has to be a power of two (min 2, max 128)!" severity error;
+    end if;
+  end process fifo_size_check;
+
+
   -- Clock Selection ----------------------------------------------------------
   -- -----------------------------------------------------------------------------
   -- clock enable --
@@ -151,26 +361,36 @@ begin
       -- input (MISO) synchronizer --
       spi_miso_ff0 <= spi_miso_i;
       spi_miso_ff1 <= spi_miso_ff0;
+      spi_dq_ff0   <= std_ulogic_vector(spi_dq_io);
+      spi_dq_ff1   <= spi_dq_ff0;
       -- arbiter --
-      spi_irq_o <= '0';
+      spi_done <= '0';
       if (spi_state0 = '0') or (ctrl(ctrl_spi_en_c) = '0') then -- idle or disabled
-        if (ctrl(ctrl_spi_size_c) = '0') then -- 8 bit mode
+        if (qct(qct_mode1_c) = '1') then -- quad mode: 4 bits per clock
+          spi_bitcnt <= "00" & ctrl(ctrl_spi_size_c) & (not ctrl(ctrl_spi_size_c)) & '0';
+        elsif (qct(qct_mode0_c) = '1') then -- dual mode: 2 bits per clock
+          spi_bitcnt <= "0" & ctrl(ctrl_spi_size_c) & (not ctrl(ctrl_spi_size_c)) & "00";
+        elsif (ctrl(ctrl_spi_size_c) = '0') then -- 8 bit mode
           spi_bitcnt <= "01000";
         else -- 16 bit mode
           spi_bitcnt <= "10000";
         end if;
         spi_state1 <= '0';
         spi_mosi_o <= '0';
+        spi_dq_o   <= (others => '0');
         spi_sclk_o <= '0';
         if (ctrl(ctrl_spi_en_c) = '0') then -- disabled
           spi_busy <= '0';
-        elsif (wr_en = '1') and (addr = spi_rtx_addr_c) then
+        elsif (tx_fifo_re = '1') then -- next frame from TX FIFO
           if (ctrl(ctrl_spi_size_c) = '0') then -- 8 bit mode
-            spi_rtx_sreg <= data_i(7 downto 0) & "00000000";
+            spi_rtx_sreg <= tx_fifo_rdata(7 downto 0) & "00000000";
           else -- 16 bit mode
-            spi_rtx_sreg <= data_i(15 downto 0);
+            spi_rtx_sreg <= tx_fifo_rdata(15 downto 0);
           end if;
           spi_busy <= '1';
+        elsif (tlen_dec = '1') then -- dummy frame for burst read
+          spi_rtx_sreg <= (others => '1');
+          spi_busy     <= '1';
         end if;
         spi_state0 <= spi_busy and spi_clk; -- start with next new clock pulse
 
@@ -183,14 +403,19 @@ begin
           else
             spi_mosi_o <= spi_rtx_sreg(0); -- LSB first
           end if;
+          if (qct(qct_mode1_c) = '1') then -- quad mode
+            spi_dq_o <= spi_rtx_sreg(15 downto 12);
+          elsif (qct(qct_mode0_c) = '1') then -- dual mode
+            spi_dq_o <= "00" & spi_rtx_sreg(15 downto 14);
+          elsif (ctrl(ctrl_spi_dir_c) = '0') then -- single mode, MSB first
+            spi_dq_o <= "000" & spi_rtx_sreg(15);
+          else -- single mode, LSB first
+            spi_dq_o <= "000" & spi_rtx_sreg(0);
+          end if;
           if (spi_clk = '1') then
             spi_state1 <= '1';
             if (ctrl(ctrl_spi_cpha_c) = '0') then
-              if (ctrl(ctrl_spi_dir_c) = '0') then
-                spi_rtx_sreg <= spi_rtx_sreg(14 downto 0) & spi_miso_ff1; -- MSB first
-              else
-                spi_rtx_sreg <= spi_miso_ff1 & spi_rtx_sreg(15 downto 1); -- LSB first
-              end if;
+              spi_rtx_sreg <= spi_sreg_nxt;
             end if;
             spi_bitcnt <= std_ulogic_vector(unsigned(spi_bitcnt) - 1);
           end if;
@@ -200,16 +425,12 @@ begin
           if (spi_clk = '1') then
             spi_state1 <= '0';
             if (ctrl(ctrl_spi_cpha_c) = '1') then
-              if (ctrl(ctrl_spi_dir_c) = '0') then
-                spi_rtx_sreg <= spi_rtx_sreg(14 downto 0) & spi_miso_ff1; -- MSB first
-              else
-                spi_rtx_sreg <= spi_miso_ff1 & spi_rtx_sreg(15 downto 1); -- LSB first
-              end if;
+              spi_rtx_sreg <= spi_sreg_nxt;
             end if;
             if (spi_bitcnt = "00000") then
               spi_state0 <= '0';
               spi_busy   <= '0';
-              spi_irq_o  <= ctrl(ctrl_spi_irq_en_c);
+              spi_done   <= '1';
             end if;
           end if;
         end if;
@@ -217,8 +438,58 @@ begin
     end if;
   end process spi_rtx_unit;
 
-  -- SPI receiver output --
+  -- shift register input --
+  spi_sdi <= spi_dq_ff1(1) when (qct(qct_dq_en_c) = '1') else spi_miso_ff1;
+
+  spi_shift: process(qct, ctrl, spi_rtx_sreg, spi_sdi, spi_dq_ff1)
+  begin
+    if (qct(qct_mode1_c) = '1') then -- quad mode, always MSB first
+      spi_sreg_nxt <= spi_rtx_sreg(11 downto 0) & spi_dq_ff1(3 downto 0);
+    elsif (qct(qct_mode0_c) = '1') then -- dual mode, always MSB first
+      spi_sreg_nxt <= spi_rtx_sreg(13 downto 0) & spi_dq_ff1(1 downto 0);
+    elsif (ctrl(ctrl_spi_dir_c) = '0') then -- single mode, MSB first
+      spi_sreg_nxt <= spi_rtx_sreg(14 downto 0) & spi_sdi;
+    else -- single mode, LSB first
+      spi_sreg_nxt <= spi_sdi & spi_rtx_sreg(15 downto 1);
+    end if;
+  end process spi_shift;
+
+  -- fetch next frame from TX FIFO or generate dummy frame when idle --
+  tx_fifo_re <= '1' when (ctrl(ctrl_spi_en_c) = '1') and (spi_state0 = '0') and (spi_busy = '0') and (tx_fifo_empty = '0') else '0';
+  tlen_dec   <= '1' when (ctrl(ctrl_spi_en_c) = '1') and (spi_state0 = '0') and (spi_busy = '0') and (tx_fifo_empty = '1') and
+                         (tlen /= x"0000") and (rx_fifo_full = '0') and (spi_done = '0') else '0'; -- stall burst if RX FIFO is full
+
+  -- SPI receiver output (shift register is final one cycle after the last clock edge) --
   spi_rx_data <= (x"00" & spi_rtx_sreg(7 downto 0)) when (ctrl(ctrl_spi_size_c) = '0') else spi_rtx_sreg(15 downto 0);
+  rx_fifo_we  <= spi_done and rx_en; -- single transfers without RX FIFO only update the RTX register
+
+  -- transceiver, FIFO or burst busy --
+  busy_all <= '1' when (spi_busy = '1') or (spi_done = '1') or (tx_fifo_empty = '0') or (tlen /= x"0000") else '0';
+
+  -- Bidirectional Data Lines -----------------------------------------------
+  -- -----------------------------------------------------------------------------
+  -- IO0 = MOSI, IO1 = MISO; IO2 (WP#) and IO3 (HOLD#) are driven high in single and dual mode
+  spi_dq_ctrl: process(qct, spi_dq_o)
+  begin
+    if (qct(qct_dq_en_c) = '0') then -- lines not used
+      spi_dq_oe  <= "0000";
+      spi_dq_out <= "0000";
+    elsif (qct(qct_mode1_c) = '1') then -- quad mode
+      spi_dq_oe  <= (others => qct(qct_wr_c));
+      spi_dq_out <= spi_dq_o;
+    elsif (qct(qct_mode0_c) = '1') then -- dual mode
+      spi_dq_oe  <= "11" & qct(qct_wr_c) & qct(qct_wr_c);
+      spi_dq_out <= "11" & spi_dq_o(1 downto 0);
+    else -- single mode
+      spi_dq_oe  <= "1101";
+      spi_dq_out <= "11" & '0' & spi_dq_o(0);
+    end if;
+  end process spi_dq_ctrl;
+
+  spi_dq_tristate:
+  for i in 0 to 3 generate
+    spi_dq_io(i) <= std_logic(spi_dq_out(i)) when (spi_dq_oe(i) = '1') else 'Z';
+  end generate; -- i
 
   -- direct user-defined CS --  
   spi_cs_o(0) <= '0' when (ctrl(ctrl_spi_cs_sel0_c) = '1') else '1';
@@ -251,9 +522,31 @@ begin
           data_o(ctrl_spi_cs_sel3_c) <= ctrl(ctrl_spi_cs_sel3_c);
           data_o(ctrl_spi_cs_sel4_c) <= ctrl(ctrl_spi_cs_sel4_c);
           data_o(ctrl_spi_cs_sel5_c) <= ctrl(ctrl_spi_cs_sel5_c);
-          data_o(ctrl_spi_busy_c)    <= spi_busy;
+          data_o(ctrl_spi_busy_c)    <= busy_all;
         else -- spi_rtx_addr_c
-          data_o(15 downto 0) <= spi_rx_data;
+          if (rx_en = '1') then -- oldest RX FIFO entry
+            data_o(15 downto 0) <= rx_fifo_mem(to_integer(unsigned(rx_fifo_r_pnt(fifo_abb_c-1 downto 0))));
+          else -- last received frame
+            data_o(15 downto 0) <= spi_rx_data;
+          end if;
+        end if;
+      elsif (rd_ext_en = '1') then
+        if (addr_ext = spi_fct_addr_c) then
+          data_o(fct_txe_irq_c)  <= fct(fct_txe_irq_c);
+          data_o(fct_rxh_irq_c)  <= fct(fct_rxh_irq_c);
+          data_o(fct_done_irq_c) <= fct(fct_done_irq_c);
+          data_o(fct_size2_c downto fct_size0_c) <= std_ulogic_vector(to_unsigned(fifo_abb_c, 3));
+          data_o(fct_tx_empty_c) <= tx_fifo_empty;
+          data_o(fct_tx_full_c)  <= tx_fifo_full;
+          data_o(fct_rx_avail_c) <= not rx_fifo_empty;
+          data_o(fct_rx_half_c)  <= rx_fifo_half;
+          data_o(fct_rx_full_c)  <= rx_fifo_full;
+          data_o(fct_rx_ovr_c)   <= rx_fifo_ovr;
+          data_o(fct_rx_en_c)    <= rx_en;
+        elsif (addr_ext = spi_tlen_addr_c) then
+          data_o <= tlen;
+        else -- spi_qct_addr_c
+          data_o(qct_dq_en_c downto qct_mode0_c) <= qct;
         end if;
       end if;
     end if;
@@ -46,10 +46,13 @@ entity neo430_sysconfig is
   generic (
     -- general configuration --
     CLOCK_SPEED  : natural := 100000000; -- main clock in Hz
+    IO_CLK_SPEED : natural := 0; -- peripheral clock in Hz, 0 = main clock
     IMEM_SIZE    : natural := 4*1024; -- internal IMEM size in bytes
     DMEM_SIZE    : natural := 2*1024; -- internal DMEM size in bytes
+    XMEM_SIZE    : natural := 0; -- banked far memory size in bytes
     -- additional configuration --
     USER_CODE    : std_ulogic_vector(15 downto 0) := x"0000"; -- custom user code
+    HART_ID      : natural := 0; -- core ID in multi-core systems
     -- module configuration --
     MULDIV_USE   : boolean := true; -- implement multiplier/divider unit?
     WB32_USE     : boolean := true; -- implement WB32 unit?
@@ -65,6 +68,9 @@ entity neo430_sysconfig is
     TRNG_USE     : boolean := true; -- implement TRNG?
     EXIRQ_USE    : boolean := true; -- implement EXIRQ?
     FREQ_GEN_USE : boolean := true; -- implement FREQ_GEN?
+    BMU_USE      : boolean := true; -- implement BMU?
+    WBS_USE      : boolean := true; -- implement wishbone slave port?
+    MBOX_USE     : boolean := true; -- implement inter-core mailbox port?
     -- boot configuration --
     BOOTLD_USE   : boolean := true; -- implement and use bootloader?
     IMEM_AS_ROM  : boolean := false -- implement IMEM as read-only memory?
@@ -84,15 +90,24 @@ architecture neo430_sysconfig_rtl of neo430_sysconfig is
   -- IO space: module base address --
   constant hi_abb_c : natural := index_size_f(io_size_c)-1; -- high address boundary bit
   constant lo_abb_c : natural := index_size_f(sysconfig_size_c); -- low address boundary bit
+  constant lo_abb_ext_c : natural := index_size_f(sysconfig_ext_size_c); -- low address boundary bit (extension registers)
+
+  -- peripheral clock --
+  constant io_clk_c : natural := cond_sel_natural_f((IO_CLK_SPEED = 0), CLOCK_SPEED, IO_CLK_SPEED);
 
   -- access control --
   signal acc_en    : std_ulogic; -- access enable
   signal addr      : std_ulogic_vector(15 downto 0);
   signal rden      : std_ulogic;
   signal info_addr : std_ulogic_vector(02 downto 0);
+  signal acc_ext_en : std_ulogic; -- extension registers access enable
+  signal rden_ext   : std_ulogic;
 
   -- misc --
-  signal f_clk : std_ulogic_vector(31 downto 0);
+  signal f_clk    : std_ulogic_vector(31 downto 0);
+  signal f_clk_io : std_ulogic_vector(31 downto 0);
+  signal hartid   : std_ulogic_vector(15 downto 0);
+  signal xmem_kb  : std_ulogic_vector(15 downto 0);
 
   -- system information ROM --
   type info_mem_t is array (0 to 7) of std_ulogic_vector(15 downto 0);
@@ -106,6 +121,9 @@ begin
   addr   <= sysconfig_base_c(15 downto lo_abb_c) & addr_i(lo_abb_c-1 downto 1) & '0'; -- word aligned
   rden   <= acc_en and rden_i;
 
+  acc_ext_en <= '1' when (addr_i(hi_abb_c downto lo_abb_ext_c) = sysconfig_ext_base_c(hi_abb_c downto lo_abb_ext_c)) else '0';
+  rden_ext   <= acc_ext_en and rden_i;
+
   info_addr <= addr(index_size_f(sysconfig_size_c)-1 downto 1);
   
 
@@ -142,7 +160,16 @@ begin
   sysinfo_mem(4)(00) <= '1' when (use_dsp_mul_c    = true) else '0'; -- use DSP blocks for MULDIV.multiplier
   sysinfo_mem(4)(01) <= '1' when (use_xalu_c       = true) else '0'; -- implement eXtended ALU functions
   sysinfo_mem(4)(02) <= '1' when (low_power_mode_c = true) else '0'; -- use (experimental) low-power mode
-  sysinfo_mem(4)(15 downto 03) <= (others => '0'); -- reserved
+  sysinfo_mem(4)(03) <= '1' when (use_dadd_c       = true) else '0'; -- implement DADD instruction
+  sysinfo_mem(4)(04) <= '1' when (use_xshift_c     = true) else '0'; -- implement MSP430X multi-bit shifts and register-mode extension words (RPT)
+  sysinfo_mem(4)(05) <= '1' when (use_pushm_c      = true) else '0'; -- implement MSP430X PUSHM/POPM instructions
+  sysinfo_mem(4)(09 downto 06) <= shadow_rf_irq_c; -- CPU IRQ channels using the shadow register bank
+  sysinfo_mem(4)(10) <= '1' when (BMU_USE          = true) else '0'; -- BMU present? (CPUID1 is full)
+  sysinfo_mem(4)(11) <= '1' when (IO_CLK_SPEED     /= 0) else '0'; -- peripherals use separate clock (clk_io_i)
+  sysinfo_mem(4)(12) <= '1' when (use_dual_rf_c    = true) else '0'; -- dual-read-port register file
+  sysinfo_mem(4)(13) <= '1' when (WBS_USE          = true) else '0'; -- wishbone slave port present? (CPUID1 is full)
+  sysinfo_mem(4)(14) <= '1' when (MBOX_USE         = true) else '0'; -- inter-core mailbox port present? (CPUID1 is full)
+  sysinfo_mem(4)(15) <= '1' when (XMEM_SIZE        /= 0) else '0'; -- banked far memory present? (CPUID1 is full)
 
   -- CPUID5: DMEM (RAM) size --
   sysinfo_mem(5) <= std_ulogic_vector(to_unsigned(DMEM_SIZE, 16)); -- size in bytes
@@ -152,6 +179,15 @@ begin
   sysinfo_mem(6) <= f_clk(15 downto 00); -- clock speed LO
   sysinfo_mem(7) <= f_clk(31 downto 16); -- clock speed HI
 
+  -- CPUID8/CPUID9 (extension registers): Peripheral clock speed --
+  f_clk_io <= std_ulogic_vector(to_unsigned(io_clk_c, 32));
+
+  -- CPUID10 (extension register): Hart ID --
+  hartid <= std_ulogic_vector(to_unsigned(HART_ID, 16));
+
+  -- CPUID11 (extension register): XMEM size in kB --
+  xmem_kb <= std_ulogic_vector(to_unsigned(XMEM_SIZE/1024, 16));
+
 
   -- Read Access --------------------------------------------------------------
   -- -----------------------------------------------------------------------------
@@ -160,6 +196,13 @@ begin
     if rising_edge(clk_i) then
       if (rden = '1') then
         data_o <= sysinfo_mem(to_integer(unsigned(info_addr)));
+      elsif (rden_ext = '1') then
+        case addr_i(2 downto 1) is
+          when "00"   => data_o <= f_clk_io(15 downto 00); -- peripheral clock speed LO
+          when "01"   => data_o <= f_clk_io(31 downto 16); -- peripheral clock speed HI
+          when "10"   => data_o <= hartid; -- core ID
+          when others => data_o <= xmem_kb; -- far memory size in kB
+        end case;
       else
         data_o <= (others => '0');
       end if;
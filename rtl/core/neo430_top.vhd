@@ -12,6 +12,7 @@
 -- #  - NEO430 CPU (MSP430(TM)-ISA-compatible) (CPU)                                               #
 -- #  - Internal RAM or ROM (configurable size) for code (IMEM)                                    #
 -- #  - Internal RAM (configurable size) for data (and code) (DMEM)                                #
+-- #  - Bit-band and set/clear/toggle alias windows for atomic IO register bit accesses (BITBAND)  #
 -- #  - Sysconfig (infomem for various system information) (SYSCONFIG)                             #
 -- #  - Optional 16-bit multiplier/divider unit (MULDIV)                                           #
 -- #  - Optional 16-bit IN and 16-bit OUT GPIO port with pin-change interrupt (GPIO)               #
@@ -28,6 +29,10 @@
 -- #  - Optional True Random Number Generator (TRNG)                                               #
 -- #  - Optional External Interrupts Controller (EXIRQ)                                            #
 -- #  - Optional Arbitrary Frequency Generator (FREQ_GEN)                                          #
+-- #  - Optional Bit Manipulation Unit (BMU)                                                       #
+-- #  - Optional Wishbone slave port for external DMEM access (WBS)                                #
+-- #  - Optional Inter-core mailbox port for multi-core clusters (MBOX)                            #
+-- #  - Optional banked far memory (up to 1MB) via 16kB window and far pointer (XMEM)              #
 -- # ********************************************************************************************* #
 -- # BSD 3-Clause License                                                                          #
 -- #                                                                                               #
@@ -71,10 +76,15 @@ entity neo430_top is
   generic (
     -- general configuration --
     CLOCK_SPEED  : natural := 100000000; -- main clock in Hz
-    IMEM_SIZE    : natural := 4*1024; -- internal IMEM size in bytes, max 48kB (default=4kB)
+    IO_CLK_SPEED : natural := 0; -- peripheral clock in Hz, 0 = same as main clock (default=0)
+    IMEM_SIZE    : natural := 4*1024; -- internal IMEM size in bytes, max 48kB (32kB with XMEM) (default=4kB)
     DMEM_SIZE    : natural := 2*1024; -- internal DMEM size in bytes, max 12kB (default=2kB)
+    IMEM_WAIT    : natural := 0;      -- wait states for each IMEM access (default=0)
+    DMEM_WAIT    : natural := 0;      -- wait states for each DMEM access (default=0)
+    XMEM_SIZE    : natural := 0;      -- banked far memory size in bytes, 0 = none, 16kB..1MB (default=0)
     -- additional configuration --
     USER_CODE    : std_ulogic_vector(15 downto 0) := x"0000"; -- custom user code
+    HART_ID      : natural := 0;      -- core ID in multi-core systems, 0..65535 (default=0)
     -- module configuration --
     MULDIV_USE   : boolean := true;  -- implement multiplier/divider unit? (default=true)
     WB32_USE     : boolean := true;  -- implement WB32 unit? (default=true)
@@ -90,6 +100,9 @@ entity neo430_top is
     TRNG_USE     : boolean := false; -- implement TRNG? (default=false)
     EXIRQ_USE    : boolean := true;  -- implement EXIRQ? (default=true)
     FREQ_GEN_USE : boolean := true;  -- implement FREQ_GEN? (default=true)
+    BMU_USE      : boolean := false; -- implement bit manipulation unit? (default=false)
+    WBS_USE      : boolean := false; -- implement wishbone slave port (DMEM access)? (default=false)
+    MBOX_USE     : boolean := false; -- implement inter-core mailbox port? (default=false)
     -- boot configuration --
     BOOTLD_USE   : boolean := true;  -- implement and use bootloader? (default=true)
     IMEM_AS_ROM  : boolean := false  -- implement IMEM as read-only memory? (default=false)
@@ -97,6 +110,7 @@ entity neo430_top is
   port (
     -- global control --
     clk_i      : in  std_ulogic; -- global clock, rising edge
+    clk_io_i   : in  std_ulogic := '0'; -- peripheral clock, rising edge, not used if IO_CLK_SPEED = 0
     rst_i      : in  std_ulogic; -- global reset, async, LOW-active
     -- parallel io --
     gpio_o     : out std_ulogic_vector(15 downto 0); -- parallel output
@@ -112,6 +126,7 @@ entity neo430_top is
     spi_mosi_o : out std_ulogic; -- serial data line out
     spi_miso_i : in  std_ulogic; -- serial data line in
     spi_cs_o   : out std_ulogic_vector(05 downto 0); -- SPI CS
+    spi_dq_io  : inout std_logic_vector(03 downto 0); -- SPI dual/quad data lines IO0..IO3
     twi_sda_io : inout std_logic; -- twi serial data line
     twi_scl_io : inout std_logic; -- twi serial clock line
     -- 32-bit wishbone interface --
@@ -123,6 +138,23 @@ entity neo430_top is
     wb_stb_o   : out std_ulogic; -- strobe
     wb_cyc_o   : out std_ulogic; -- valid cycle
     wb_ack_i   : in  std_ulogic; -- transfer acknowledge
+    -- 16-bit wishbone slave interface (external DMEM access) --
+    wbs_adr_i  : in  std_ulogic_vector(15 downto 0); -- address
+    wbs_dat_i  : in  std_ulogic_vector(15 downto 0); -- write data
+    wbs_dat_o  : out std_ulogic_vector(15 downto 0); -- read data
+    wbs_we_i   : in  std_ulogic; -- read/write
+    wbs_sel_i  : in  std_ulogic_vector(01 downto 0); -- byte enable
+    wbs_stb_i  : in  std_ulogic; -- strobe
+    wbs_cyc_i  : in  std_ulogic; -- valid cycle
+    wbs_ack_o  : out std_ulogic; -- transfer acknowledge
+    wbs_irq_o  : out std_ulogic; -- doorbell interrupt to host
+    -- inter-core mailbox interface (connect to neo430_mailbox) --
+    mbox_rd_o  : out std_ulogic; -- read enable
+    mbox_wr_o  : out std_ulogic; -- write enable
+    mbox_adr_o : out std_ulogic_vector(02 downto 0); -- register (word) address
+    mbox_dat_o : out std_ulogic_vector(15 downto 0); -- write data
+    mbox_dat_i : in  std_ulogic_vector(15 downto 0); -- read data, valid one cycle after read enable
+    mbox_irq_i : in  std_ulogic; -- mailbox interrupt (message received / doorbell)
     -- external interrupts --
     ext_irq_i  : in  std_ulogic_vector(07 downto 0); -- external interrupt request lines (active HI)
     ext_ack_o  : out std_ulogic_vector(07 downto 0)  -- external interrupt request acknowledges
@@ -149,6 +181,11 @@ architecture neo430_top_rtl of neo430_top is
   signal twi_cg_en      : std_ulogic;
   signal cfu_cg_en      : std_ulogic;
   signal freq_gen_cg_en : std_ulogic;
+  signal per_clk_div    : std_ulogic_vector(11 downto 0);
+  signal per_clk_div_ff : std_ulogic_vector(11 downto 0);
+  signal per_clk_gen    : std_ulogic_vector(07 downto 0);
+  signal per_cg_en      : std_ulogic;
+  signal clk_io         : std_ulogic; -- peripheral clock
 
   type cpu_bus_t is record
     rd_en : std_ulogic;
@@ -156,6 +193,7 @@ architecture neo430_top_rtl of neo430_top is
     addr  : std_ulogic_vector(15 downto 0);
     rdata : std_ulogic_vector(15 downto 0);
     wdata : std_ulogic_vector(15 downto 0);
+    stall : std_ulogic;
   end record;
 
   -- main CPU communication bus --
@@ -163,10 +201,87 @@ architecture neo430_top_rtl of neo430_top is
   signal io_acc   : std_ulogic;
   signal io_wr_en : std_ulogic;
   signal io_rd_en : std_ulogic;
+  signal io_addr  : std_ulogic_vector(15 downto 0);
+  signal io_wdata : std_ulogic_vector(15 downto 0);
+  signal io_rdata : std_ulogic_vector(15 downto 0);
+  signal io_rd_ff : std_ulogic_vector(15 downto 0); -- IO read data pipeline register
+  signal io_data  : std_ulogic_vector(15 downto 0); -- final IO read data (direct or registered)
+  signal io_wait  : std_ulogic; -- CPU IO read waiting for pipeline register
+
+  -- main memory wait states --
+  constant dmem_wait_max_c : natural := cond_sel_natural_f(WBS_USE, 2*DMEM_WAIT, DMEM_WAIT); -- + pending slave access
+  constant mem_wait_max_c  : natural := cond_sel_natural_f((IMEM_WAIT > dmem_wait_max_c), IMEM_WAIT, dmem_wait_max_c);
+  signal mem_wait_cnt : natural range 0 to mem_wait_max_c; -- remaining wait states of current access
+  signal mem_wait     : std_ulogic; -- CPU memory access not completed yet
+  signal mem_bus      : cpu_bus_t; -- access to IMEM & DMEM: CPU or held access
+  signal mem_hold     : cpu_bus_t; -- held CPU access
+
+  -- DMEM arbitration (CPU / wishbone slave port) --
+  signal dmem_bus      : cpu_bus_t; -- access to DMEM: CPU or slave port
+  signal dmem_rdata    : std_ulogic_vector(15 downto 0); -- DMEM read data
+  signal dmem_cpu_acc  : std_ulogic; -- CPU accesses DMEM
+  signal dmem_wbs      : std_ulogic; -- DMEM is used by slave port
+  signal dmem_wbs_ff   : std_ulogic; -- DMEM was used by slave port in last cycle
+  signal dmem_wbs_cnt  : natural range 0 to DMEM_WAIT; -- remaining wait states of slave port access
+  signal dmem_wbs_last : std_ulogic; -- last cycle of slave port access
+  signal wbs_mem_req   : std_ulogic;
+  signal wbs_mem_done  : std_ulogic;
+  signal wbs_mem       : cpu_bus_t; -- slave port DMEM access
+
+  -- bit-band and atomic modify alias windows --
+  signal bb_acc    : std_ulogic; -- CPU accesses alias window
+  signal bb_target : std_ulogic_vector(15 downto 0); -- aliased IO register
+  signal bb_rd_ff  : std_ulogic_vector(01 downto 0); -- alias read: select bits from (direct/registered) IO read data
+  signal bb_bit_ff : std_ulogic_vector(02 downto 0); -- alias read: accessed bit pair
+  signal bb_rdata  : std_ulogic_vector(15 downto 0); -- alias read: selected bits (registered)
+  signal bb_rmw    : std_ulogic_vector(02 downto 0); -- alias write sequence: 0: read target, 1/2: write target
+  signal bb_rd     : std_ulogic; -- alias read data valid
+  signal bb_wr     : std_ulogic; -- alias write sequence: write target
+  signal bb_adr_ff : std_ulogic_vector(15 downto 0); -- alias write: target register
+  signal bb_msk_ff : std_ulogic_vector(15 downto 0); -- alias write: bits to modify
+  signal bb_val_ff : std_ulogic_vector(15 downto 0); -- alias write: new bit values
+  signal bb_tgl_ff : std_ulogic; -- alias write: toggle masked bits
+  signal bb_new    : std_ulogic_vector(15 downto 0); -- alias write: new values of masked bits
+  signal am_acc    : std_ulogic; -- CPU accesses atomic set/clear/toggle window
+  signal am_target : std_ulogic_vector(15 downto 0); -- modified IO register
+
+  -- peripheral clock domain (UART, SPI, TWI, PWM, TIMER, WDT) --
+  signal per_acc      : std_ulogic; -- IO access to peripheral clock domain device
+  signal per_rd_en    : std_ulogic;
+  signal per_wr_en    : std_ulogic;
+  signal per_addr     : std_ulogic_vector(15 downto 0);
+  signal per_wdata    : std_ulogic_vector(15 downto 0);
+  signal per_rdata    : std_ulogic_vector(15 downto 0);
+  signal per_rst      : std_ulogic; -- external reset
+  signal per_irq      : std_ulogic_vector(01 downto 0);
+  signal per_wdt_rst  : std_ulogic;
+  signal per_pwm      : std_ulogic;
+  signal io_per_rdata : std_ulogic_vector(15 downto 0); -- peripheral read data, direct IO bus access
+
+  -- IO clock domain bridge, CPU side (only if IO_CLK_SPEED /= 0) --
+  signal xb_rd_en     : std_ulogic; -- read access
+  signal xb_wr_en     : std_ulogic; -- write access
+  signal xb_md_en     : std_ulogic; -- alias window read-modify-write access
+  signal xb_busy      : std_ulogic;
+  signal xb_bb        : std_ulogic; -- bit-band read access
+  signal xb_rdata     : std_ulogic_vector(15 downto 0);
+  signal xb_cpu_rdata : std_ulogic_vector(15 downto 0); -- final read data (bit-band bit selection)
+  signal xb_irq       : std_ulogic_vector(01 downto 0);
+  signal xb_wait      : std_ulogic; -- CPU waiting for bridge
+
+  -- custom instruction interface (CPU <-> CFU) --
+  signal cfu_req : std_ulogic;
+  signal cfu_fn  : std_ulogic_vector(02 downto 0);
+  signal cfu_opa : std_ulogic_vector(15 downto 0);
+  signal cfu_opb : std_ulogic_vector(15 downto 0);
+  signal cfu_res : std_ulogic_vector(15 downto 0);
+  signal cfu_ack : std_ulogic;
 
   -- read-back data buses --
   signal rom_rdata       : std_ulogic_vector(15 downto 0);
   signal ram_rdata       : std_ulogic_vector(15 downto 0);
+  signal xmem_rdata      : std_ulogic_vector(15 downto 0);
+  signal xmem_io_rdata   : std_ulogic_vector(15 downto 0);
   signal muldiv_rdata    : std_ulogic_vector(15 downto 0);
   signal wb_rdata        : std_ulogic_vector(15 downto 0);
   signal boot_rdata      : std_ulogic_vector(15 downto 0);
@@ -182,16 +297,27 @@ architecture neo430_top_rtl of neo430_top is
   signal trng_rdata      : std_ulogic_vector(15 downto 0);
   signal exirq_rdata     : std_ulogic_vector(15 downto 0);
   signal freq_gen_rdata  : std_ulogic_vector(15 downto 0);
+  signal bmu_rdata       : std_ulogic_vector(15 downto 0);
+  signal wbs_rdata       : std_ulogic_vector(15 downto 0);
+  signal mbox_rdata      : std_ulogic_vector(15 downto 0);
   signal sysconfig_rdata : std_ulogic_vector(15 downto 0);
 
   -- interrupt system --
   signal irq       : std_ulogic_vector(03 downto 0);
+  signal irq_ack   : std_ulogic_vector(03 downto 0);
+  signal xirq_sel  : std_ulogic_vector(03 downto 0);
   signal timer_irq : std_ulogic;
   signal uart_irq  : std_ulogic;
   signal spi_irq   : std_ulogic;
   signal twi_irq   : std_ulogic;
   signal gpio_irq  : std_ulogic;
   signal ext_irq   : std_ulogic;
+  signal wbs_irq   : std_ulogic;
+  signal mbox_irq  : std_ulogic;
+
+  -- mailbox port --
+  signal mbox_acc   : std_ulogic;
+  signal mbox_rd_ff : std_ulogic;
 
   -- misc --
   signal imem_up_en : std_ulogic;
@@ -234,7 +360,7 @@ begin
       clk_div <= (others => '0');
     elsif rising_edge(clk_i) then
       -- anybody needing fresh clocks?
-      if ((timer_cg_en or uart_cg_en or spi_cg_en or wdt_cg_en or pwm_cg_en or twi_cg_en or cfu_cg_en or freq_gen_cg_en) = '1') then
+      if ((cfu_cg_en or freq_gen_cg_en or (per_cg_en and bool_to_ulogic_f(IO_CLK_SPEED = 0))) = '1') then
         clk_div <= std_ulogic_vector(unsigned(clk_div) + 1);
       end if;
     end if;
@@ -257,13 +383,17 @@ begin
   clk_gen(clk_div2048_c) <= clk_div(10) and (not clk_div_ff(10)); -- CLK/2048
   clk_gen(clk_div4096_c) <= clk_div(11) and (not clk_div_ff(11)); -- CLK/4096
 
+  -- peripheral clock domain devices --
+  per_cg_en <= timer_cg_en or uart_cg_en or spi_cg_en or wdt_cg_en or pwm_cg_en or twi_cg_en;
+
 
   -- The core of the problem: The CPU -----------------------------------------
   -- -----------------------------------------------------------------------------
   neo430_cpu_inst: neo430_cpu
   generic map (
     BOOTLD_USE  => BOOTLD_USE,      -- implement and use bootloader? (default=true)
-    IMEM_AS_ROM => IMEM_AS_ROM      -- implement IMEM as read-only memory?
+    IMEM_AS_ROM => IMEM_AS_ROM,     -- implement IMEM as read-only memory?
+    CFU_USE     => CFU_USE          -- implement CFU custom instructions?
   )
   port map (
     -- global control --
@@ -276,25 +406,101 @@ begin
     mem_addr_o => cpu_bus.addr,     -- address
     mem_data_o => cpu_bus.wdata,    -- write data
     mem_data_i => cpu_bus.rdata,    -- read data
+    mem_wait_i => cpu_bus.stall,    -- memory access not completed yet
     -- interrupt system --
-    irq_i      => irq              -- interrupt request lines
+    irq_i      => irq,             -- interrupt request lines
+    irq_ack_o  => irq_ack,         -- interrupt handler started
+    xirq_sel_i => xirq_sel,        -- external IRQ vector
+    -- custom instruction interface --
+    cfu_req_o  => cfu_req,         -- start custom instruction
+    cfu_fn_o   => cfu_fn,          -- function select
+    cfu_opa_o  => cfu_opa,         -- operand A (source register)
+    cfu_opb_o  => cfu_opb,         -- operand B (destination register)
+    cfu_res_i  => cfu_res,         -- result
+    cfu_ack_i  => cfu_ack          -- result valid
   );
 
+  -- IO read data --
+  io_rdata <= muldiv_rdata or wb_rdata or gpio_rdata or freq_gen_rdata or sysconfig_rdata or crc_rdata or
+              cfu_rdata or trng_rdata or exirq_rdata or bmu_rdata or wbs_rdata or mbox_rdata or xmem_io_rdata or
+              io_per_rdata;
+
+  -- optional IO read data pipeline register: removes the IO read data OR tree from the CPU's critical path, --
+  -- CPU IO read accesses are extended by one wait cycle --
+  io_read_pipeline: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      io_rd_ff <= io_rdata;
+      io_wait  <= cpu_bus.rd_en and (io_acc or bb_acc);
+    end if;
+  end process io_read_pipeline;
+
+  io_data       <= io_rd_ff when (io_rd_pipe_c = true) else io_rdata;
+  cpu_bus.stall <= (io_wait and bool_to_ulogic_f(io_rd_pipe_c)) or bb_rd or mem_wait or xb_wait;
+
   -- final CPU read data --
-  cpu_bus.rdata <= rom_rdata or ram_rdata or boot_rdata or muldiv_rdata or
-                   wb_rdata or uart_rdata or spi_rdata or gpio_rdata or freq_gen_rdata or
-                   timer_rdata or wdt_rdata or sysconfig_rdata or crc_rdata or
-                   cfu_rdata or pwm_rdata or twi_rdata or trng_rdata or exirq_rdata;
+  cpu_bus.rdata <= rom_rdata or ram_rdata or xmem_rdata or boot_rdata or xb_cpu_rdata when (bb_rd = '1') or (bb_wr = '1') else -- hide target register of alias read/write from CPU
+                   rom_rdata or ram_rdata or xmem_rdata or boot_rdata or xb_cpu_rdata or bb_rdata or io_data;
 
   -- interrupts: priority assignment --
-  irq(0) <= timer_irq;                      -- timer match (highest priority)
-  irq(1) <= uart_irq or spi_irq or twi_irq; -- serial IRQ
+  irq(0) <= xb_irq(0);                      -- timer match (highest priority)
+  irq(1) <= xb_irq(1) or wbs_irq or mbox_irq; -- serial IRQ (UART, SPI, TWI, WBS doorbell, MBOX)
   irq(2) <= gpio_irq;                       -- GPIO input pin change
   irq(3) <= ext_irq;                        -- external interrupt request (lowest priority)
 
 
   -- Main Memory (ROM/IMEM & RAM/DMEM) ----------------------------------------
   -- -----------------------------------------------------------------------------
+  -- optional wait states for slow memories (IMEM_WAIT/DMEM_WAIT > 0): the CPU is stalled for the according number of
+  -- cycles after each IMEM/DMEM access, while the memories are provided with the held access (repeated read/write)
+  -- - so the memory inputs are stable for WAIT+1 cycles, which allows multi-cycle path constraints --
+  mem_wait_gen: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      if (mem_wait_cnt = 0) then
+        mem_hold <= cpu_bus;
+        if ((cpu_bus.rd_en or cpu_bus.wr_en(0) or cpu_bus.wr_en(1)) = '1') then
+          if (cpu_bus.addr < std_ulogic_vector(unsigned(imem_base_c) + IMEM_SIZE)) then -- IMEM access
+            mem_wait_cnt <= IMEM_WAIT;
+          elsif (cpu_bus.addr >= dmem_base_c) and (cpu_bus.addr < std_ulogic_vector(unsigned(dmem_base_c) + DMEM_SIZE)) then -- DMEM access
+            mem_wait_cnt <= DMEM_WAIT + dmem_wbs_cnt; -- wait until slave port access has completed, then repeat
+          end if;
+        end if;
+      else
+        mem_wait_cnt <= mem_wait_cnt - 1;
+      end if;
+    end if;
+  end process mem_wait_gen;
+
+  mem_wait <= '0' when (mem_wait_cnt = 0) else '1';
+  mem_bus  <= cpu_bus when (mem_wait_cnt = 0) else mem_hold;
+
+  -- DMEM arbitration: the wishbone slave port (WBS_USE = true) gets the DMEM only in cycles without CPU DMEM access --
+  -- and keeps it for DMEM_WAIT+1 cycles; a CPU DMEM access during that time is stalled and repeated afterwards --
+  dmem_cpu_acc <= '1' when ((mem_bus.rd_en or mem_bus.wr_en(0) or mem_bus.wr_en(1)) = '1') and
+                           (mem_bus.addr >= dmem_base_c) and (mem_bus.addr < std_ulogic_vector(unsigned(dmem_base_c) + DMEM_SIZE)) else '0';
+
+  dmem_arbiter: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      dmem_wbs_ff  <= dmem_wbs;
+      wbs_mem_done <= dmem_wbs_last;
+      if (dmem_wbs_cnt /= 0) then
+        dmem_wbs_cnt <= dmem_wbs_cnt - 1;
+      elsif (dmem_wbs = '1') then
+        dmem_wbs_cnt <= DMEM_WAIT;
+      end if;
+    end if;
+  end process dmem_arbiter;
+
+  dmem_wbs      <= '1' when (WBS_USE = true) and ((dmem_wbs_cnt /= 0) or
+                                                  ((wbs_mem_req = '1') and (wbs_mem_done = '0') and (dmem_cpu_acc = '0'))) else '0';
+  dmem_wbs_last <= dmem_wbs when (dmem_wbs_cnt = 1) or ((dmem_wbs_cnt = 0) and (DMEM_WAIT = 0)) else '0';
+  dmem_bus      <= wbs_mem when (dmem_wbs = '1') else mem_bus;
+
+  -- hide read data of slave port accesses from CPU --
+  ram_rdata <= dmem_rdata when (dmem_wbs_ff = '0') else (others => '0');
+
   neo430_imem_inst: neo430_imem
   generic map (
     IMEM_SIZE   => IMEM_SIZE,       -- internal IMEM size in bytes, max 32kB (default=4kB)
@@ -303,11 +509,11 @@ begin
   )
   port map (
     clk_i  => clk_i,                -- global clock line
-    rden_i => cpu_bus.rd_en,        -- read enable
-    wren_i => cpu_bus.wr_en,        -- write enable
+    rden_i => mem_bus.rd_en,        -- read enable
+    wren_i => mem_bus.wr_en,        -- write enable
     upen_i => imem_up_en,           -- update enable
-    addr_i => cpu_bus.addr,         -- address
-    data_i => cpu_bus.wdata,        -- data in
+    addr_i => mem_bus.addr,         -- address
+    data_i => mem_bus.wdata,        -- data in
     data_o => rom_rdata             -- data out
   );
 
@@ -317,14 +523,48 @@ begin
   )
   port map (
     clk_i  => clk_i,                -- global clock line
-    rden_i => cpu_bus.rd_en,        -- read enable
-    wren_i => cpu_bus.wr_en,        -- write enable
-    addr_i => cpu_bus.addr,         -- address
-    data_i => cpu_bus.wdata,        -- data in
-    data_o => ram_rdata             -- data out
+    rden_i => dmem_bus.rd_en,       -- read enable
+    wren_i => dmem_bus.wr_en,       -- write enable
+    addr_i => dmem_bus.addr,        -- address
+    data_i => dmem_bus.wdata,       -- data in
+    data_o => dmem_rdata            -- data out
   );
 
 
+  -- Banked Far Memory (XMEM) -------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  -- memory window is accessed like the IMEM/DMEM (no wait states), bank/pointer registers via the IO space --
+  neo430_xmem_inst_true:
+  if (XMEM_SIZE /= 0) generate
+    neo430_xmem_inst: neo430_xmem
+    generic map (
+      XMEM_SIZE  => XMEM_SIZE,      -- far memory size in bytes, power of two, 16kB..1MB
+      IMEM_SIZE  => IMEM_SIZE       -- internal IMEM size in bytes, max 32kB
+    )
+    port map (
+      -- host access: control registers --
+      clk_i      => clk_i,          -- global clock line
+      rden_i     => io_rd_en,       -- read enable
+      wren_i     => io_wr_en,       -- write enable
+      addr_i     => io_addr,        -- address
+      data_i     => io_wdata,       -- data in
+      data_o     => xmem_io_rdata,  -- data out
+      -- host access: memory window --
+      win_rden_i => mem_bus.rd_en,  -- read enable
+      win_wren_i => mem_bus.wr_en,  -- write enable
+      win_addr_i => mem_bus.addr,   -- address
+      win_data_i => mem_bus.wdata,  -- data in
+      win_data_o => xmem_rdata      -- data out
+    );
+  end generate;
+
+  neo430_xmem_inst_false:
+  if (XMEM_SIZE = 0) generate
+    xmem_io_rdata <= (others => '0');
+    xmem_rdata    <= (others => '0');
+  end generate;
+
+
   -- Boot ROM -----------------------------------------------------------------
   -- -----------------------------------------------------------------------------
   neo430_boot_rom_inst_true:
@@ -347,8 +587,217 @@ begin
   -- IO Access? ---------------------------------------------------------------
   -- -----------------------------------------------------------------------------
   io_acc   <= '1' when (cpu_bus.addr(15 downto index_size_f(io_size_c)) = io_base_c(15 downto index_size_f(io_size_c))) else '0';
-  io_rd_en <= cpu_bus.rd_en and io_acc;
-  io_wr_en <= (cpu_bus.wr_en(0) or cpu_bus.wr_en(1)) and io_acc; -- use all accesses as full-word accesses
+  io_rd_en <= (cpu_bus.rd_en and (io_acc or bb_acc)) or bb_rmw(0);
+  io_wr_en <= ((cpu_bus.wr_en(0) or cpu_bus.wr_en(1)) and io_acc) or bb_wr; -- use all accesses as full-word accesses
+
+  -- IO address and write data: CPU or bit-band sequence --
+  io_addr  <= bb_adr_ff when (bb_rmw /= "000") else bb_target when (bb_acc = '1') else cpu_bus.addr;
+  io_wdata <= (io_data and (not bb_msk_ff)) or (bb_new and bb_msk_ff) when (bb_wr = '1') else cpu_bus.wdata;
+
+
+  -- Bit-Band and Atomic Modify Alias Windows (BITBAND) -----------------------
+  -- -----------------------------------------------------------------------------
+  -- Bit-band window: Each BYTE address of the alias window maps to one bit of the primary IO device registers
+  -- (0xFF80..0xFFFF): alias = bitband_base_c + 16*(word index of IO register) + bit. Reading an alias returns the
+  -- addressed bit in bit 0 of the according byte. Writing to an alias sets (bit 0 of written byte = 1) or clears
+  -- (= 0) the addressed bit. Word accesses affect two adjacent bits.
+  -- Atomic modify windows: Writing a bit mask to iomod_set/clr/tgl_base_c + (IO address - io_base_c) sets, clears
+  -- or toggles the according bits of the IO register (byte accesses only modify the written byte). These windows
+  -- are write-only and cover the complete IO area.
+  -- Alias writes are executed as read-modify-write sequence of the target register within the two cycles following
+  -- the CPU write (three cycles if io_rd_pipe_c = true). The CPU never accesses the IO area during these cycles
+  -- (instruction fetch or interrupt entry), so the sequence does not interfere with other IO accesses and is atomic
+  -- from the software point of view. Alias reads select the addressed bits in one additional (stalled) cycle.
+  -- Alias accesses to registers with read side effects (see io_rd_side_effect_f) are ignored (reads return zero).
+  bb_acc    <= '1' when (cpu_bus.addr(15 downto index_size_f(bitband_size_c)) = bitband_base_c(15 downto index_size_f(bitband_size_c))) and
+                        (io_rd_side_effect_f(bb_target) = '0') else '0';
+  bb_target <= io_base_c(15 downto 8) & '1' & cpu_bus.addr(9 downto 4) & '0';
+  am_acc    <= '1' when ((cpu_bus.addr(15 downto 8) = iomod_set_base_c(15 downto 8)) or
+                         (cpu_bus.addr(15 downto 8) = iomod_clr_base_c(15 downto 8)) or
+                         (cpu_bus.addr(15 downto 8) = iomod_tgl_base_c(15 downto 8))) and
+                        (io_rd_side_effect_f(am_target) = '0') else '0';
+  am_target <= io_base_c(15 downto 8) & cpu_bus.addr(7 downto 1) & '0';
+
+  bitband_rmw: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      -- alias read --
+      bb_rd_ff(0) <= cpu_bus.rd_en and bb_acc;
+      bb_rd_ff(1) <= bb_rd_ff(0);
+      if ((cpu_bus.rd_en and bb_acc) = '1') then
+        bb_bit_ff <= cpu_bus.addr(3 downto 1);
+      end if;
+      bb_rdata <= (others => '0');
+      if (bb_rd = '1') then -- select addressed bits from target register
+        bb_rdata(0) <= io_data(to_integer(unsigned(bb_bit_ff & '0')));
+        bb_rdata(8) <= io_data(to_integer(unsigned(bb_bit_ff & '1')));
+      end if;
+      -- alias write --
+      bb_rmw(0) <= (cpu_bus.wr_en(0) or cpu_bus.wr_en(1)) and (bb_acc or am_acc);
+      bb_rmw(1) <= bb_rmw(0);
+      bb_rmw(2) <= bb_rmw(1) and bool_to_ulogic_f(io_rd_pipe_c);
+      if (((cpu_bus.wr_en(0) or cpu_bus.wr_en(1)) and bb_acc) = '1') then -- bit-band
+        bb_adr_ff <= bb_target;
+        bb_tgl_ff <= '0';
+        bb_msk_ff <= (others => '0');
+        bb_val_ff <= (others => '0');
+        if (cpu_bus.wr_en(0) = '1') then -- even alias address
+          bb_msk_ff(to_integer(unsigned(cpu_bus.addr(3 downto 1) & '0'))) <= '1';
+          bb_val_ff(to_integer(unsigned(cpu_bus.addr(3 downto 1) & '0'))) <= cpu_bus.wdata(0);
+        end if;
+        if (cpu_bus.wr_en(1) = '1') then -- odd alias address
+          bb_msk_ff(to_integer(unsigned(cpu_bus.addr(3 downto 1) & '1'))) <= '1';
+          bb_val_ff(to_integer(unsigned(cpu_bus.addr(3 downto 1) & '1'))) <= cpu_bus.wdata(8);
+        end if;
+      elsif (((cpu_bus.wr_en(0) or cpu_bus.wr_en(1)) and am_acc) = '1') then -- atomic set/clear/toggle
+        bb_adr_ff <= am_target;
+        bb_tgl_ff <= bool_to_ulogic_f(cpu_bus.addr(15 downto 8) = iomod_tgl_base_c(15 downto 8));
+        bb_msk_ff <= (others => '0');
+        if (cpu_bus.wr_en(0) = '1') then
+          bb_msk_ff(07 downto 0) <= cpu_bus.wdata(07 downto 0);
+        end if;
+        if (cpu_bus.wr_en(1) = '1') then
+          bb_msk_ff(15 downto 8) <= cpu_bus.wdata(15 downto 8);
+        end if;
+        if (cpu_bus.addr(15 downto 8) = iomod_set_base_c(15 downto 8)) then
+          bb_val_ff <= (others => '1');
+        else
+          bb_val_ff <= (others => '0');
+        end if;
+      end if;
+    end if;
+  end process bitband_rmw;
+
+  -- alias read: target read data valid --
+  bb_rd <= bb_rd_ff(1) when (io_rd_pipe_c = true) else bb_rd_ff(0);
+  bb_wr <= bb_rmw(2)   when (io_rd_pipe_c = true) else bb_rmw(1);
+
+  -- new register value: masked bits are replaced --
+  bb_new <= (not io_data) when (bb_tgl_ff = '1') else bb_val_ff;
+
+
+  -- Peripheral Clock Domain (UART, SPI, TWI, PWM, TIMER, WDT) ----------------
+  -- -----------------------------------------------------------------------------
+  -- These devices are clocked by clk_io_i. If IO_CLK_SPEED = 0, clk_io_i is ignored (clk_i is used instead) and the devices
+  -- are directly connected to the IO bus. Otherwise, all accesses to these devices (including bit-band and atomic
+  -- modify alias accesses) are passed through the IO clock domain bridge, stalling the CPU until completion.
+  per_acc <= '1' when (io_addr(15 downto index_size_f(uart_size_c))     = uart_base_c(15 downto index_size_f(uart_size_c)))         or
+                      (io_addr(15 downto index_size_f(spi_size_c))      = spi_base_c(15 downto index_size_f(spi_size_c)))           or
+                      (io_addr(15 downto index_size_f(spi_ext_size_c))  = spi_ext_base_c(15 downto index_size_f(spi_ext_size_c)))   or
+                      (io_addr(15 downto index_size_f(timer_size_c))    = timer_base_c(15 downto index_size_f(timer_size_c)))       or
+                      (io_addr(15 downto index_size_f(wdt_size_c))      = wdt_base_c(15 downto index_size_f(wdt_size_c)))           or
+                      (io_addr(15 downto index_size_f(pwm_size_c))      = pwm_base_c(15 downto index_size_f(pwm_size_c)))           or
+                      (io_addr(15 downto index_size_f(twi_size_c))      = twi_base_c(15 downto index_size_f(twi_size_c)))           or
+                      (io_addr(15 downto index_size_f(twi_ext_size_c))  = twi_ext_base_c(15 downto index_size_f(twi_ext_size_c))) else '0';
+
+  per_rdata  <= uart_rdata or spi_rdata or timer_rdata or wdt_rdata or pwm_rdata or twi_rdata;
+  per_irq(0) <= timer_irq;
+  per_irq(1) <= uart_irq or spi_irq or twi_irq;
+
+  -- same clock: direct connection --
+  io_clock_shared:
+  if (IO_CLK_SPEED = 0) generate
+    clk_io       <= clk_i;
+    per_rd_en    <= io_rd_en;
+    per_wr_en    <= io_wr_en;
+    per_addr     <= io_addr;
+    per_wdata    <= io_wdata;
+    io_per_rdata <= per_rdata;
+    per_rst      <= ext_rst;
+    per_clk_gen  <= clk_gen;
+    xb_irq       <= per_irq;
+    wdt_rst      <= per_wdt_rst;
+    gpio_pwm     <= per_pwm;
+    xb_busy      <= '0';
+    xb_rdata     <= (others => '0');
+  end generate;
+
+  -- separate clock: IO clock domain bridge --
+  io_clock_separate:
+  if (IO_CLK_SPEED /= 0) generate
+    clk_io <= clk_io_i;
+
+    neo430_io_bridge_inst: neo430_io_bridge
+    port map (
+      -- host access (CPU clock domain) --
+      clk_i        => clk_i,        -- CPU clock line
+      rst_i        => ext_rst,      -- external reset, low-active, use as async
+      rden_i       => xb_rd_en,     -- read enable
+      wren_i       => xb_wr_en,     -- write enable
+      mden_i       => xb_md_en,     -- read-modify-write enable
+      addr_i       => io_addr,      -- address
+      data_i       => io_wdata,     -- data in
+      mmsk_i       => bb_msk_ff,    -- modify: bits to modify
+      mval_i       => bb_val_ff,    -- modify: new bit values
+      mtgl_i       => bb_tgl_ff,    -- modify: toggle bits instead
+      data_o       => xb_rdata,     -- data out
+      busy_o       => xb_busy,      -- access in progress
+      irq_o        => xb_irq,       -- interrupt requests
+      wdt_rst_o    => wdt_rst,      -- watchdog reset, low-active, use as async
+      pwm_o        => gpio_pwm,     -- GPIO PWM
+      -- device access (IO clock domain) --
+      clk_io_i     => clk_io,       -- IO clock line
+      io_rst_o     => per_rst,      -- external reset, low-active, use as async
+      io_rden_o    => per_rd_en,    -- read enable
+      io_wren_o    => per_wr_en,    -- write enable
+      io_addr_o    => per_addr,     -- address
+      io_data_o    => per_wdata,    -- data out
+      io_data_i    => per_rdata,    -- data in
+      io_irq_i     => per_irq,      -- interrupt requests
+      io_wdt_rst_i => per_wdt_rst,  -- watchdog reset, low-active
+      io_pwm_i     => per_pwm       -- GPIO PWM
+    );
+
+    io_per_rdata <= (others => '0'); -- read data is provided by the bridge
+
+    -- clock generator for the peripheral clock domain --
+    per_clock_generator: process(per_rst, clk_io)
+    begin
+      if (per_rst = '0') then
+        per_clk_div <= (others => '0');
+      elsif rising_edge(clk_io) then
+        if (per_cg_en = '1') then
+          per_clk_div <= std_ulogic_vector(unsigned(per_clk_div) + 1);
+        end if;
+      end if;
+    end process per_clock_generator;
+
+    per_clock_generator_buf: process(clk_io)
+    begin
+      if rising_edge(clk_io) then
+        per_clk_div_ff <= per_clk_div;
+      end if;
+    end process per_clock_generator_buf;
+
+    per_clk_gen(clk_div2_c)    <= per_clk_div(0)  and (not per_clk_div_ff(0));  -- CLK/2
+    per_clk_gen(clk_div4_c)    <= per_clk_div(1)  and (not per_clk_div_ff(1));  -- CLK/4
+    per_clk_gen(clk_div8_c)    <= per_clk_div(2)  and (not per_clk_div_ff(2));  -- CLK/8
+    per_clk_gen(clk_div64_c)   <= per_clk_div(5)  and (not per_clk_div_ff(5));  -- CLK/64
+    per_clk_gen(clk_div128_c)  <= per_clk_div(6)  and (not per_clk_div_ff(6));  -- CLK/128
+    per_clk_gen(clk_div1024_c) <= per_clk_div(9)  and (not per_clk_div_ff(9));  -- CLK/1024
+    per_clk_gen(clk_div2048_c) <= per_clk_div(10) and (not per_clk_div_ff(10)); -- CLK/2048
+    per_clk_gen(clk_div4096_c) <= per_clk_div(11) and (not per_clk_div_ff(11)); -- CLK/4096
+  end generate;
+
+  -- bridge accesses: CPU read/write, bit-band read or alias read-modify-write sequence --
+  xb_rd_en <= cpu_bus.rd_en and (io_acc or bb_acc) and per_acc;
+  xb_wr_en <= (cpu_bus.wr_en(0) or cpu_bus.wr_en(1)) and io_acc and per_acc;
+  xb_md_en <= bb_rmw(0) and per_acc;
+
+  -- stall CPU during bridge access (the alias read-modify-write sequence starts one cycle after the CPU write) --
+  xb_wait <= xb_busy or (xb_md_en and bool_to_ulogic_f(IO_CLK_SPEED /= 0));
+
+  -- bit-band read: select bits --
+  xb_access_type: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      if (xb_busy = '0') then
+        xb_bb <= bb_acc;
+      end if;
+    end if;
+  end process xb_access_type;
+
+  xb_cpu_rdata <= ("0000000" & xb_rdata(to_integer(unsigned(bb_bit_ff & '1'))) & "0000000" & xb_rdata(to_integer(unsigned(bb_bit_ff & '0')))) when (xb_bb = '1') else xb_rdata;
 
 
   -- Multiplier/Divider Unit (MULDIV) -----------------------------------------
@@ -361,8 +810,8 @@ begin
       clk_i  => clk_i,              -- global clock line
       rden_i => io_rd_en,           -- read enable
       wren_i => io_wr_en,           -- write enable
-      addr_i => cpu_bus.addr,       -- address
-      data_i => cpu_bus.wdata,      -- data in
+      addr_i => io_addr,            -- address
+      data_i => io_wdata,           -- data in
       data_o => muldiv_rdata        -- data out
     );
   end generate;
@@ -383,8 +832,8 @@ begin
       clk_i    => clk_i,            -- global clock line
       rden_i   => io_rd_en,         -- read enable
       wren_i   => io_wr_en,         -- write enable
-      addr_i   => cpu_bus.addr,     -- address
-      data_i   => cpu_bus.wdata,    -- data in
+      addr_i   => io_addr,          -- address
+      data_i   => io_wdata,         -- data in
       data_o   => wb_rdata,         -- data out
       -- wishbone interface --
       wb_adr_o => wb_adr_o,         -- address
@@ -410,6 +859,95 @@ begin
   end generate;
 
 
+  -- Wishbone Slave Port (WBS) ------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  neo430_wbs_inst_true:
+  if (WBS_USE = true) generate
+    neo430_wbs_inst: neo430_wb_slave
+    generic map (
+      DMEM_SIZE  => DMEM_SIZE       -- internal DMEM size in bytes
+    )
+    port map (
+      -- host access --
+      clk_i      => clk_i,          -- global clock line
+      rst_i      => sys_rst,        -- global reset, low-active, async
+      rden_i     => io_rd_en,       -- read enable
+      wren_i     => io_wr_en,       -- write enable
+      addr_i     => io_addr,        -- address
+      data_i     => io_wdata,       -- data in
+      data_o     => wbs_rdata,      -- data out
+      irq_o      => wbs_irq,        -- doorbell interrupt
+      -- DMEM access --
+      mem_req_o  => wbs_mem_req,    -- DMEM access request
+      mem_done_i => wbs_mem_done,   -- DMEM access completed, read data valid
+      mem_rden_o => wbs_mem.rd_en,  -- DMEM read enable
+      mem_wren_o => wbs_mem.wr_en,  -- DMEM write enable
+      mem_addr_o => wbs_mem.addr,   -- DMEM address
+      mem_data_o => wbs_mem.wdata,  -- DMEM write data
+      mem_data_i => dmem_rdata,     -- DMEM read data
+      -- wishbone slave interface --
+      wbs_adr_i  => wbs_adr_i,      -- address
+      wbs_dat_i  => wbs_dat_i,      -- write data
+      wbs_dat_o  => wbs_dat_o,      -- read data
+      wbs_we_i   => wbs_we_i,       -- read/write
+      wbs_sel_i  => wbs_sel_i,      -- byte enable
+      wbs_stb_i  => wbs_stb_i,      -- strobe
+      wbs_cyc_i  => wbs_cyc_i,      -- valid cycle
+      wbs_ack_o  => wbs_ack_o,      -- transfer acknowledge
+      wbs_irq_o  => wbs_irq_o       -- doorbell interrupt to host
+    );
+  end generate;
+
+  neo430_wbs_inst_false:
+  if (WBS_USE = false) generate
+    wbs_rdata     <= (others => '0');
+    wbs_irq       <= '0';
+    wbs_mem_req   <= '0';
+    wbs_mem.rd_en <= '0';
+    wbs_mem.wr_en <= (others => '0');
+    wbs_mem.addr  <= (others => '0');
+    wbs_mem.wdata <= (others => '0');
+    wbs_dat_o     <= (others => '0');
+    wbs_ack_o     <= '0';
+    wbs_irq_o     <= '0';
+  end generate;
+
+
+  -- Inter-Core Mailbox Port (MBOX) -------------------------------------------
+  -- -----------------------------------------------------------------------------
+  -- the mailbox itself (neo430_mailbox) is shared by several cores and lives outside of the processor --
+  neo430_mbox_port_true:
+  if (MBOX_USE = true) generate
+    mbox_acc   <= '1' when (io_addr(15 downto index_size_f(mbox_size_c)) = mbox_base_c(15 downto index_size_f(mbox_size_c))) else '0';
+    mbox_rd_o  <= io_rd_en and mbox_acc;
+    mbox_wr_o  <= io_wr_en and mbox_acc;
+    mbox_adr_o <= io_addr(index_size_f(mbox_size_c)-1 downto 1);
+    mbox_dat_o <= io_wdata;
+
+    mbox_read_ack: process(clk_i)
+    begin
+      if rising_edge(clk_i) then
+        mbox_rd_ff <= io_rd_en and mbox_acc;
+      end if;
+    end process mbox_read_ack;
+
+    mbox_rdata <= mbox_dat_i when (mbox_rd_ff = '1') else (others => '0');
+    mbox_irq   <= mbox_irq_i;
+  end generate;
+
+  neo430_mbox_port_false:
+  if (MBOX_USE = false) generate
+    mbox_acc   <= '0';
+    mbox_rd_ff <= '0';
+    mbox_rd_o  <= '0';
+    mbox_wr_o  <= '0';
+    mbox_adr_o <= (others => '0');
+    mbox_dat_o <= (others => '0');
+    mbox_rdata <= (others => '0');
+    mbox_irq   <= '0';
+  end generate;
+
+
   -- Universal Asynchronous Receiver & Transmitter (UART) ---------------------
   -- -----------------------------------------------------------------------------
   neo430_uart_inst_true:
@@ -417,15 +955,15 @@ begin
     neo430_uart_inst: neo430_uart
     port map (
       -- host access --
-      clk_i       => clk_i,         -- global clock line
-      rden_i      => io_rd_en,      -- read enable
-      wren_i      => io_wr_en,      -- write enable
-      addr_i      => cpu_bus.addr,  -- address
-      data_i      => cpu_bus.wdata, -- data in
+      clk_i       => clk_io,        -- global clock line
+      rden_i      => per_rd_en,     -- read enable
+      wren_i      => per_wr_en,     -- write enable
+      addr_i      => per_addr,      -- address
+      data_i      => per_wdata,     -- data in
       data_o      => uart_rdata,    -- data out
       -- clock generator --
       clkgen_en_o => uart_cg_en,    -- enable clock generator
-      clkgen_i    => clk_gen,
+      clkgen_i    => per_clk_gen,
       -- com lines --
       uart_txd_o  => uart_txd_o,
       uart_rxd_i  => uart_rxd_i,
@@ -450,20 +988,21 @@ begin
     neo430_spi_inst: neo430_spi
     port map (
       -- host access --
-      clk_i       => clk_i,         -- global clock line
-      rden_i      => io_rd_en,      -- read enable
-      wren_i      => io_wr_en,      -- write enable
-      addr_i      => cpu_bus.addr,  -- address
-      data_i      => cpu_bus.wdata, -- data in
+      clk_i       => clk_io,        -- global clock line
+      rden_i      => per_rd_en,     -- read enable
+      wren_i      => per_wr_en,     -- write enable
+      addr_i      => per_addr,      -- address
+      data_i      => per_wdata,     -- data in
       data_o      => spi_rdata,     -- data out
       -- clock generator --
       clkgen_en_o => spi_cg_en,     -- enable clock generator
-      clkgen_i    => clk_gen,
+      clkgen_i    => per_clk_gen,
       -- com lines --
       spi_sclk_o  => spi_sclk_o,    -- SPI serial clock
       spi_mosi_o  => spi_mosi_o,    -- SPI master out, slave in
       spi_miso_i  => spi_miso_i,    -- SPI master in, slave out
       spi_cs_o    => spi_cs_o,      -- SPI CS 0..5
+      spi_dq_io   => spi_dq_io,     -- SPI dual/quad data lines IO0..IO3
       -- interrupt --
       spi_irq_o   => spi_irq        -- transmission done interrupt
     );
@@ -476,6 +1015,7 @@ begin
     spi_sclk_o <= '0';
     spi_mosi_o <= '0';
     spi_cs_o   <= (others => '1');
+    spi_dq_io  <= (others => 'Z');
     spi_irq    <= '0';
   end generate;
 
@@ -490,8 +1030,8 @@ begin
       clk_i      => clk_i,          -- global clock line
       rden_i     => io_rd_en,       -- read enable
       wren_i     => io_wr_en,       -- write enable
-      addr_i     => cpu_bus.addr,   -- address
-      data_i     => cpu_bus.wdata,  -- data in
+      addr_i     => io_addr,        -- address
+      data_i     => io_wdata,       -- data in
       data_o     => gpio_rdata,     -- data out
       -- parallel io --
       gpio_o     => gpio_o,
@@ -518,15 +1058,15 @@ begin
   neo430_timer_inst: neo430_timer
     port map (
       -- host access --
-      clk_i       => clk_i,         -- global clock line
-      rden_i      => io_rd_en,      -- read enable
-      wren_i      => io_wr_en,      -- write enable
-      addr_i      => cpu_bus.addr,  -- address
-      data_i      => cpu_bus.wdata, -- data in
+      clk_i       => clk_io,        -- global clock line
+      rden_i      => per_rd_en,     -- read enable
+      wren_i      => per_wr_en,     -- write enable
+      addr_i      => per_addr,      -- address
+      data_i      => per_wdata,     -- data in
       data_o      => timer_rdata,   -- data out
       -- clock generator --
       clkgen_en_o => timer_cg_en,   -- enable clock generator
-      clkgen_i    => clk_gen,
+      clkgen_i    => per_clk_gen,
       -- interrupt --
       irq_o       => timer_irq      -- interrupt request
     );
@@ -547,26 +1087,26 @@ begin
     neo430_wdt_inst: neo430_wdt
     port map(
       -- host access --
-      clk_i       => clk_i,         -- global clock line
-      rst_i       => ext_rst,       -- external reset, low-active, use as async
-      rden_i      => io_rd_en,      -- read enable
-      wren_i      => io_wr_en,      -- write enable
-      addr_i      => cpu_bus.addr,  -- address
-      data_i      => cpu_bus.wdata, -- data in
+      clk_i       => clk_io,        -- global clock line
+      rst_i       => per_rst,       -- external reset, low-active, use as async
+      rden_i      => per_rd_en,     -- read enable
+      wren_i      => per_wr_en,     -- write enable
+      addr_i      => per_addr,      -- address
+      data_i      => per_wdata,     -- data in
       data_o      => wdt_rdata,     -- data out
       -- clock generator --
       clkgen_en_o => wdt_cg_en,     -- enable clock generator
-      clkgen_i    => clk_gen,       -- clock generator
+      clkgen_i    => per_clk_gen,   -- clock generator
       -- system reset --
-      rst_o       => wdt_rst        -- timeout reset, low-active, use as async
+      rst_o       => per_wdt_rst    -- timeout reset, low-active, use as async
     );
   end generate;
 
   neo430_wdt_inst_false:
   if (WDT_USE = false) generate
-    wdt_rdata <= (others => '0');
-    wdt_rst   <= '1';
-    wdt_cg_en <= '0';
+    wdt_rdata   <= (others => '0');
+    per_wdt_rst <= '1';
+    wdt_cg_en   <= '0';
   end generate;
 
 
@@ -580,8 +1120,8 @@ begin
       clk_i  => clk_i,              -- global clock line
       rden_i => io_rd_en,           -- read enable
       wren_i => io_wr_en,           -- write enable
-      addr_i => cpu_bus.addr,       -- address
-      data_i => cpu_bus.wdata,      -- data in
+      addr_i => io_addr,            -- address
+      data_i => io_wdata,           -- data in
       data_o => crc_rdata           -- data out
     );
   end generate;
@@ -602,12 +1142,19 @@ begin
       clk_i       => clk_i,         -- global clock line
       rden_i      => io_rd_en,      -- read enable
       wren_i      => io_wr_en,      -- write enable
-      addr_i      => cpu_bus.addr,  -- address
-      data_i      => cpu_bus.wdata, -- data in
+      addr_i      => io_addr,       -- address
+      data_i      => io_wdata,      -- data in
       data_o      => cfu_rdata,     -- data out
       -- clock generator --
       clkgen_en_o => cfu_cg_en,     -- enable clock generator
-      clkgen_i    => clk_gen
+      clkgen_i    => clk_gen,
+      -- custom instructions --
+      ci_req_i    => cfu_req,       -- start custom instruction
+      ci_fn_i     => cfu_fn,        -- function select
+      ci_opa_i    => cfu_opa,       -- operand A (source register)
+      ci_opb_i    => cfu_opb,       -- operand B (destination register)
+      ci_res_o    => cfu_res,       -- result
+      ci_ack_o    => cfu_ack        -- result valid
       -- add custom IOs below --
     );
   end generate;
@@ -616,6 +1163,8 @@ begin
   if (CFU_USE = false) generate
     cfu_cg_en <= '0';
     cfu_rdata <= (others => '0');
+    cfu_res   <= (others => '0');
+    cfu_ack   <= '1'; -- never stall the CPU
   end generate;
 
 
@@ -626,17 +1175,17 @@ begin
     neo430_pwm_inst: neo430_pwm
     port map(
       -- host access --
-      clk_i       => clk_i,         -- global clock line
-      rden_i      => io_rd_en,      -- read enable
-      wren_i      => io_wr_en,      -- write enable
-      addr_i      => cpu_bus.addr,  -- address
-      data_i      => cpu_bus.wdata, -- data in
+      clk_i       => clk_io,        -- global clock line
+      rden_i      => per_rd_en,     -- read enable
+      wren_i      => per_wr_en,     -- write enable
+      addr_i      => per_addr,      -- address
+      data_i      => per_wdata,     -- data in
       data_o      => pwm_rdata,     -- data out
       -- clock generator --
       clkgen_en_o => pwm_cg_en,     -- enable clock generator
-      clkgen_i    => clk_gen,
+      clkgen_i    => per_clk_gen,
       -- GPIO output PWM --
-      gpio_pwm_o  => gpio_pwm,
+      gpio_pwm_o  => per_pwm,
       -- pwm output channels --
       pwm_o       => pwm_o
     );
@@ -645,7 +1194,7 @@ begin
   neo430_pwm_inst_false:
   if (PWM_USE = false) generate
     pwm_cg_en <= '0';
-    gpio_pwm  <= '1';
+    per_pwm   <= '1';
     pwm_rdata <= (others => '0');
     pwm_o     <= (others => '0');
   end generate;
@@ -658,15 +1207,15 @@ begin
     neo430_twi_inst: neo430_twi
     port map (
       -- host access --
-      clk_i       => clk_i,         -- global clock line
-      rden_i      => io_rd_en,      -- read enable
-      wren_i      => io_wr_en,      -- write enable
-      addr_i      => cpu_bus.addr,  -- address
-      data_i      => cpu_bus.wdata, -- data in
+      clk_i       => clk_io,        -- global clock line
+      rden_i      => per_rd_en,     -- read enable
+      wren_i      => per_wr_en,     -- write enable
+      addr_i      => per_addr,      -- address
+      data_i      => per_wdata,     -- data in
       data_o      => twi_rdata,     -- data out
       -- clock generator --
       clkgen_en_o => twi_cg_en,     -- enable clock generator
-      clkgen_i    => clk_gen,
+      clkgen_i    => per_clk_gen,
       -- com lines --
       twi_sda_io  => twi_sda_io,    -- serial data line
       twi_scl_io  => twi_scl_io,    -- serial clock line
@@ -693,8 +1242,8 @@ begin
       clk_i       => clk_i,         -- global clock line
       rden_i      => io_rd_en,      -- read enable
       wren_i      => io_wr_en,      -- write enable
-      addr_i      => cpu_bus.addr,  -- address
-      data_i      => cpu_bus.wdata, -- data in
+      addr_i      => io_addr,       -- address
+      data_i      => io_wdata,      -- data in
       data_o      => trng_rdata     -- data out
     );
   end generate;
@@ -715,11 +1264,13 @@ begin
       clk_i     => clk_i,           -- global clock line
       rden_i    => io_rd_en,        -- read enable
       wren_i    => io_wr_en,        -- write enable
-      addr_i    => cpu_bus.addr,    -- address
-      data_i    => cpu_bus.wdata,   -- data in
+      addr_i    => io_addr,         -- address
+      data_i    => io_wdata,        -- data in
       data_o    => exirq_rdata,     -- data out
       -- cpu interrupt --
       cpu_irq_o => ext_irq,
+      cpu_ack_i => irq_ack(3),      -- CPU has started the interrupt handler
+      cpu_vec_o => xirq_sel,        -- vectored mode & IRQ source
       -- external interrupt lines --
       ext_irq_i => ext_irq_i,       -- IRQ
       ext_ack_o => ext_ack_o        -- acknowledge
@@ -731,6 +1282,7 @@ begin
     exirq_rdata <= (others => '0');
     ext_ack_o   <= (others => '0');
     ext_irq     <= '0';
+    xirq_sel    <= (others => '0');
   end generate;
 
 
@@ -744,8 +1296,8 @@ begin
       clk_i       => clk_i,           -- global clock line
       rden_i      => io_rd_en,        -- read enable
       wren_i      => io_wr_en,        -- write enable
-      addr_i      => cpu_bus.addr,    -- address
-      data_i      => cpu_bus.wdata,   -- data in
+      addr_i      => io_addr,         -- address
+      data_i      => io_wdata,        -- data in
       data_o      => freq_gen_rdata,  -- data out
       -- clock generator --
       clkgen_en_o => freq_gen_cg_en,  -- enable clock generator
@@ -763,16 +1315,41 @@ begin
   end generate;
 
 
+  -- Bit Manipulation Unit (BMU) ----------------------------------------------
+  -- -----------------------------------------------------------------------------
+  neo430_bmu_inst_true:
+  if (BMU_USE = true) generate
+    neo430_bmu_inst: neo430_bmu
+    port map(
+      -- host access --
+      clk_i  => clk_i,              -- global clock line
+      rden_i => io_rd_en,           -- read enable
+      wren_i => io_wr_en,           -- write enable
+      addr_i => io_addr,            -- address
+      data_i => io_wdata,           -- data in
+      data_o => bmu_rdata           -- data out
+    );
+  end generate;
+
+  neo430_bmu_inst_false:
+  if (BMU_USE = false) generate
+    bmu_rdata <= (others => '0');
+  end generate;
+
+
   -- System Configuration -----------------------------------------------------
   -- -----------------------------------------------------------------------------
   neo430_sysconfig_inst: neo430_sysconfig
   generic map (
     -- general configuration --
     CLOCK_SPEED  => CLOCK_SPEED,    -- main clock in Hz
+    IO_CLK_SPEED => IO_CLK_SPEED,   -- peripheral clock in Hz, 0 = main clock
     IMEM_SIZE    => IMEM_SIZE,      -- internal IMEM size in bytes
     DMEM_SIZE    => DMEM_SIZE,      -- internal DMEM size in bytes
+    XMEM_SIZE    => XMEM_SIZE,      -- banked far memory size in bytes
     -- additional configuration --
     USER_CODE    => USER_CODE,      -- custom user code
+    HART_ID      => HART_ID,        -- core ID in multi-core systems
     -- module configuration --
     MULDIV_USE   => MULDIV_USE,     -- implement multiplier/divider unit?
     WB32_USE     => WB32_USE,       -- implement WB32 unit?
@@ -788,6 +1365,9 @@ begin
     TRNG_USE     => TRNG_USE,       -- implement TRNG?
     EXIRQ_USE    => EXIRQ_USE,      -- implement EXIRQ?
     FREQ_GEN_USE => FREQ_GEN_USE,   -- implement FREQ_GEN?
+    BMU_USE      => BMU_USE,        -- implement BMU?
+    WBS_USE      => WBS_USE,        -- implement wishbone slave port?
+    MBOX_USE     => MBOX_USE,       -- implement inter-core mailbox port?
     -- boot configuration --
     BOOTLD_USE   => BOOTLD_USE,     -- implement and use bootloader?
     IMEM_AS_ROM  => IMEM_AS_ROM     -- implement IMEM as read-only memory?
@@ -796,8 +1376,8 @@ begin
     clk_i  => clk_i,                -- global clock line
     rden_i => io_rd_en,             -- read enable
     wren_i => io_wr_en,             -- write enable
-    addr_i => cpu_bus.addr,         -- address
-    data_i => cpu_bus.wdata,        -- data in
+    addr_i => io_addr,              -- address
+    data_i => io_wdata,             -- data in
     data_o => sysconfig_rdata       -- data out
   );
 
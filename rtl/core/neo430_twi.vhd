@@ -3,7 +3,9 @@
 -- # ********************************************************************************************* #
 -- # Supports START and STOP conditions, 8 bit data + ACK/NACK transfers and clock stretching.     #
 -- # Supports ACKs by the master. No multi-master support and no slave mode support yet!           #
--- # Interrupt: TWI_transfer_done                                                                  #
+-- # A command sequencer executes START/STOP/WRITE/READ commands from a FIFO autonomously and      #
+-- # stores received bytes in an RX FIFO (complete register-read transactions without the CPU).    #
+-- # Interrupt: TWI_transfer_done, TWI_sequence_done                                               #
 -- # ********************************************************************************************* #
 -- # BSD 3-Clause License                                                                          #
 -- #                                                                                               #
@@ -68,6 +70,7 @@ architecture neo430_twi_rtl of neo430_twi is
   -- IO space: module base address --
   constant hi_abb_c : natural := index_size_f(io_size_c)-1; -- high address boundary bit
   constant lo_abb_c : natural := index_size_f(twi_size_c); -- low address boundary bit
+  constant lo_abb_ext_c : natural := index_size_f(twi_ext_size_c); -- low address boundary bit (extension registers)
 
   -- control reg bits --
   constant ctrl_twi_en_c     : natural := 0; -- r/w: TWI enable
@@ -83,11 +86,68 @@ architecture neo430_twi_rtl of neo430_twi is
   -- data register flags --
   constant data_twi_ack_c    : natural := 15; -- r/-: Set if ACK received
 
+  -- sequencer control reg bits --
+  constant fct_seq_irq_c   : natural :=  0; -- r/w: interrupt when command sequence is done
+  constant fct_clr_c       : natural :=  1; -- -/w: clear command and RX FIFO and NACK flag
+  constant fct_size0_c     : natural :=  5; -- r/-: log2(FIFO depth) bit 0
+  constant fct_size1_c     : natural :=  6; -- r/-: log2(FIFO depth) bit 1
+  constant fct_size2_c     : natural :=  7; -- r/-: log2(FIFO depth) bit 2
+  constant fct_cmd_full_c  : natural :=  8; -- r/-: command FIFO is full
+  constant fct_rx_avail_c  : natural :=  9; -- r/-: RX FIFO data available
+  constant fct_seq_busy_c  : natural := 10; -- r/-: command sequence in progress
+  constant fct_nack_c      : natural := 11; -- r/-: NACK received during WRITE command, sequence aborted
+
+  -- sequencer commands (cmd(10:8)), cmd(7:0) = data for WRITE --
+  constant cmd_start_c     : std_ulogic_vector(2 downto 0) := "001"; -- generate (repeated) START condition
+  constant cmd_stop_c      : std_ulogic_vector(2 downto 0) := "010"; -- generate STOP condition
+  constant cmd_write_c     : std_ulogic_vector(2 downto 0) := "011"; -- send byte, sample ACK from slave
+  constant cmd_read_ack_c  : std_ulogic_vector(2 downto 0) := "100"; -- receive byte, send ACK
+  constant cmd_read_nack_c : std_ulogic_vector(2 downto 0) := "101"; -- receive byte, send NACK (last byte)
+
+  -- rx data register flags --
+  constant rxd_valid_c     : natural := 15; -- r/-: data valid (RX FIFO was not empty)
+
+  -- fifo configuration --
+  constant fifo_abb_c : natural := index_size_f(twi_fifo_size_c); -- fifo pointer size
+
   -- access control --
-  signal acc_en : std_ulogic; -- module access enable
-  signal addr   : std_ulogic_vector(15 downto 0); -- access address
-  signal wr_en  : std_ulogic; -- word write enable
-  signal rd_en  : std_ulogic; -- read enable
+  signal acc_en     : std_ulogic; -- module access enable
+  signal acc_ext_en : std_ulogic; -- module extension registers access enable
+  signal addr       : std_ulogic_vector(15 downto 0); -- access address
+  signal addr_ext   : std_ulogic_vector(15 downto 0); -- access address (extension registers)
+  signal wr_en      : std_ulogic; -- word write enable
+  signal rd_en      : std_ulogic; -- read enable
+  signal wr_ext_en  : std_ulogic; -- word write enable (extension registers)
+  signal rd_ext_en  : std_ulogic; -- read enable (extension registers)
+
+  -- command sequencer --
+  type cmd_fifo_t is array (0 to twi_fifo_size_c-1) of std_ulogic_vector(10 downto 0);
+  type rx_fifo_t  is array (0 to twi_fifo_size_c-1) of std_ulogic_vector(07 downto 0);
+  signal cmd_fifo_mem   : cmd_fifo_t;
+  signal cmd_fifo_w_pnt : std_ulogic_vector(fifo_abb_c downto 0);
+  signal cmd_fifo_r_pnt : std_ulogic_vector(fifo_abb_c downto 0);
+  signal cmd_fifo_we    : std_ulogic;
+  signal cmd_fifo_re    : std_ulogic;
+  signal cmd_fifo_clr   : std_ulogic;
+  signal cmd_fifo_empty : std_ulogic;
+  signal cmd_fifo_full  : std_ulogic;
+  signal cmd_fifo_rdata : std_ulogic_vector(10 downto 0);
+  signal rx_fifo_mem    : rx_fifo_t;
+  signal rx_fifo_w_pnt  : std_ulogic_vector(fifo_abb_c downto 0);
+  signal rx_fifo_r_pnt  : std_ulogic_vector(fifo_abb_c downto 0);
+  signal rx_fifo_we     : std_ulogic;
+  signal rx_fifo_re     : std_ulogic;
+  signal rx_fifo_clr    : std_ulogic;
+  signal rx_fifo_empty  : std_ulogic;
+  signal rx_fifo_full   : std_ulogic;
+  signal seq_irq_en     : std_ulogic; -- sequence done interrupt enable
+  signal seq_active     : std_ulogic; -- current operation was issued by the sequencer
+  signal seq_read       : std_ulogic; -- current sequencer operation is a READ
+  signal seq_write      : std_ulogic; -- current sequencer operation is a WRITE
+  signal seq_abort      : std_ulogic; -- NACK during WRITE: flush command FIFO
+  signal seq_nack       : std_ulogic; -- sticky NACK flag
+  signal seq_busy       : std_ulogic;
+  signal seq_busy_ff    : std_ulogic;
 
   -- twi clocking --
   signal twi_clk        : std_ulogic;
@@ -118,6 +178,11 @@ begin
   wr_en  <= acc_en and wren_i;
   rd_en  <= acc_en and rden_i;
 
+  acc_ext_en <= '1' when (addr_i(hi_abb_c downto lo_abb_ext_c) = twi_ext_base_c(hi_abb_c downto lo_abb_ext_c)) else '0';
+  addr_ext   <= twi_ext_base_c(15 downto lo_abb_ext_c) & addr_i(lo_abb_ext_c-1 downto 1) & '0'; -- word aligned
+  wr_ext_en  <= acc_ext_en and wren_i;
+  rd_ext_en  <= acc_ext_en and rden_i;
+
 
   -- Write access -------------------------------------------------------------
   -- -----------------------------------------------------------------------------
@@ -129,10 +194,100 @@ begin
           ctrl <= data_i(ctrl'left downto 0);
         end if;
       end if;
+      -- sequencer configuration, reset while TWI is disabled --
+      if (ctrl(ctrl_twi_en_c) = '0') then
+        seq_irq_en <= '0';
+      elsif (wr_ext_en = '1') and (addr_ext = twi_fct_addr_c) then
+        seq_irq_en <= data_i(fct_seq_irq_c);
+      end if;
     end if;
   end process wr_access;
 
 
+  -- Command FIFO -------------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  cmd_fifo_we  <= '1' when (wr_ext_en = '1') and (addr_ext = twi_cmd_addr_c) and (cmd_fifo_full = '0') else '0';
+  cmd_fifo_clr <= '1' when (ctrl(ctrl_twi_en_c) = '0') or (seq_abort = '1') or
+                           ((wr_ext_en = '1') and (addr_ext = twi_fct_addr_c) and (data_i(fct_clr_c) = '1')) else '0';
+
+  cmd_fifo_sync: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      if (cmd_fifo_clr = '1') then
+        cmd_fifo_w_pnt <= (others => '0');
+        cmd_fifo_r_pnt <= (others => '0');
+      else
+        if (cmd_fifo_we = '1') then
+          cmd_fifo_w_pnt <= std_ulogic_vector(unsigned(cmd_fifo_w_pnt) + 1);
+        end if;
+        if (cmd_fifo_re = '1') then
+          cmd_fifo_r_pnt <= std_ulogic_vector(unsigned(cmd_fifo_r_pnt) + 1);
+        end if;
+      end if;
+      if (cmd_fifo_we = '1') then
+        cmd_fifo_mem(to_integer(unsigned(cmd_fifo_w_pnt(fifo_abb_c-1 downto 0)))) <= data_i(10 downto 0);
+      end if;
+    end if;
+  end process cmd_fifo_sync;
+
+  -- status --
+  cmd_fifo_rdata <= cmd_fifo_mem(to_integer(unsigned(cmd_fifo_r_pnt(fifo_abb_c-1 downto 0))));
+  cmd_fifo_empty <= '1' when (cmd_fifo_r_pnt = cmd_fifo_w_pnt) else '0';
+  cmd_fifo_full  <= '1' when (cmd_fifo_r_pnt(fifo_abb_c) /= cmd_fifo_w_pnt(fifo_abb_c)) and
+                             (cmd_fifo_r_pnt(fifo_abb_c-1 downto 0) = cmd_fifo_w_pnt(fifo_abb_c-1 downto 0)) else '0';
+
+  -- next command can be executed (READs are stalled while the RX FIFO is full) --
+  cmd_fifo_re <= '1' when (arbiter = "100") and (wr_en = '0') and (cmd_fifo_empty = '0') and
+                          ((cmd_fifo_rdata(10) = '0') or (rx_fifo_full = '0')) else '0';
+
+
+  -- RX FIFO ------------------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  rx_fifo_re  <= '1' when (rd_ext_en = '1') and (addr_ext = twi_rxd_addr_c) and (rx_fifo_empty = '0') else '0';
+  rx_fifo_clr <= '1' when (ctrl(ctrl_twi_en_c) = '0') or ((wr_ext_en = '1') and (addr_ext = twi_fct_addr_c) and (data_i(fct_clr_c) = '1')) else '0';
+
+  rx_fifo_sync: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      if (rx_fifo_clr = '1') then
+        rx_fifo_w_pnt <= (others => '0');
+        rx_fifo_r_pnt <= (others => '0');
+      else
+        if (rx_fifo_we = '1') then
+          rx_fifo_w_pnt <= std_ulogic_vector(unsigned(rx_fifo_w_pnt) + 1);
+        end if;
+        if (rx_fifo_re = '1') then
+          rx_fifo_r_pnt <= std_ulogic_vector(unsigned(rx_fifo_r_pnt) + 1);
+        end if;
+      end if;
+      if (rx_fifo_we = '1') then
+        rx_fifo_mem(to_integer(unsigned(rx_fifo_w_pnt(fifo_abb_c-1 downto 0)))) <= twi_rtx_sreg(8 downto 1);
+      end if;
+    end if;
+  end process rx_fifo_sync;
+
+  -- status --
+  rx_fifo_empty <= '1' when (rx_fifo_r_pnt = rx_fifo_w_pnt) else '0';
+  rx_fifo_full  <= '1' when (rx_fifo_r_pnt(fifo_abb_c) /= rx_fifo_w_pnt(fifo_abb_c)) and
+                            (rx_fifo_r_pnt(fifo_abb_c-1 downto 0) = rx_fifo_w_pnt(fifo_abb_c-1 downto 0)) else '0';
+
+  -- received byte of a sequencer READ --
+  rx_fifo_we <= '1' when (arbiter = "111") and (twi_bitcnt = "1010") and (seq_read = '1') else '0';
+
+  -- sequence in progress --
+  seq_busy <= seq_active or (not cmd_fifo_empty);
+
+
+  -- FIFO Size Check ----------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  fifo_size_check: process(clk_i)
+  begin
+    if (is_power_of_two_f(twi_fifo_size_c, 7) = false) or (twi_fifo_size_c < 8) then
+      assert false report "TWI FIFO size (twi_fifo_size_c) has to be a power of two (min 8, max 128)!" severity error;
+    end if;
+  end process fifo_size_check;
+
+
   -- Clock Generation ---------------------------------------------------------
   -- -----------------------------------------------------------------------------
   -- clock generator enable --
@@ -172,15 +327,46 @@ begin
 
       -- defaults --
       twi_irq_o  <= '0';
+      seq_abort  <= '0';
       arbiter(2) <= ctrl(ctrl_twi_en_c); -- still activated?
 
+      -- sequencer status --
+      seq_busy_ff <= seq_busy;
+      if (seq_irq_en = '1') and (seq_busy = '0') and (seq_busy_ff = '1') then -- command sequence done
+        twi_irq_o <= '1';
+      end if;
+      if (rx_fifo_clr = '1') then
+        seq_nack <= '0';
+      end if;
+
       -- arbiter FSM --
       -- TWI bus signals are set/sampled using 4 clock phases
       case arbiter is
 
         when "100" => -- IDLE: waiting for requests, bus might be still claimed by this master if no STOP condition was generated
           twi_bitcnt <= (others => '0');
-          if (wr_en = '1') then
+          seq_active <= '0';
+          seq_read   <= '0';
+          seq_write  <= '0';
+          if (cmd_fifo_re = '1') then -- execute next command from sequencer
+            seq_active <= '1';
+            case cmd_fifo_rdata(10 downto 8) is
+              when cmd_start_c =>
+                arbiter(1 downto 0) <= "01";
+              when cmd_stop_c =>
+                arbiter(1 downto 0) <= "10";
+              when cmd_write_c =>
+                twi_rtx_sreg <= cmd_fifo_rdata(7 downto 0) & '1'; -- release SDA to sample ACK from slave
+                seq_write    <= '1';
+                arbiter(1 downto 0) <= "11";
+              when cmd_read_ack_c | cmd_read_nack_c =>
+                twi_rtx_sreg <= x"FF" & cmd_fifo_rdata(8); -- release SDA during data, send ACK (0) or NACK (1)
+                seq_read     <= '1';
+                arbiter(1 downto 0) <= "11";
+              when others => -- NOP
+                NULL;
+            end case;
+          elsif (wr_en = '1') then
             if (addr = twi_ctrl_addr_c) then
               if (data_i(ctrl_twi_start_c) = '1') then -- issue START condition
                 arbiter(1 downto 0) <= "01";
@@ -237,12 +423,19 @@ begin
 
           if (twi_bitcnt = "1010") then -- 8 data bits + 1 bit for ACK + 1 tick delay
             arbiter(1 downto 0) <= "00"; -- go back to IDLE
-            twi_irq_o <= ctrl(ctrl_twi_irq_en_c); -- fire IRQ if enabled
+            if (seq_active = '0') then
+              twi_irq_o <= ctrl(ctrl_twi_irq_en_c); -- fire IRQ if enabled
+            elsif (seq_write = '1') and (twi_rtx_sreg(0) = '1') then -- NACK: abort sequence and release bus
+              seq_nack  <= '1';
+              seq_abort <= '1';
+              arbiter(1 downto 0) <= "10"; -- STOP
+            end if;
           end if;
 
         when others => -- "0--" OFFLINE: TWI deactivated
-          twi_sda_o <= '1';
-          twi_scl_o <= '1';
+          twi_sda_o  <= '1';
+          twi_scl_o  <= '1';
+          seq_active <= '0';
           arbiter   <= ctrl(ctrl_twi_en_c) & "00"; -- stay here, go to idle when activated
 
       end case;
@@ -284,6 +477,18 @@ begin
           data_o(7 downto 0)        <= twi_rtx_sreg(8 downto 1);
           data_o(data_twi_ack_c)    <= not twi_rtx_sreg(0);
         end if;
+      elsif (rd_ext_en = '1') then
+        if (addr_ext = twi_fct_addr_c) then
+          data_o(fct_seq_irq_c)     <= seq_irq_en;
+          data_o(fct_size2_c downto fct_size0_c) <= std_ulogic_vector(to_unsigned(fifo_abb_c, 3));
+          data_o(fct_cmd_full_c)    <= cmd_fifo_full;
+          data_o(fct_rx_avail_c)    <= not rx_fifo_empty;
+          data_o(fct_seq_busy_c)    <= seq_busy;
+          data_o(fct_nack_c)        <= seq_nack;
+        elsif (addr_ext = twi_rxd_addr_c) then
+          data_o(7 downto 0)        <= rx_fifo_mem(to_integer(unsigned(rx_fifo_r_pnt(fifo_abb_c-1 downto 0))));
+          data_o(rxd_valid_c)       <= not rx_fifo_empty;
+        end if;
       end if;
     end if;
   end process rd_access;
@@ -0,0 +1,243 @@
+-- #################################################################################################
+-- # << NEO430 - Wishbone Slave Port >>                                                            #
+-- # ********************************************************************************************* #
+-- # Allows external Wishbone masters to read and write the processor's DMEM (zero-copy buffer     #
+-- # exchange). Each host access is executed in a free DMEM cycle, so the CPU keeps priority.      #
+-- # Accesses outside the DMEM address range and the doorbell registers are acknowledged without   #
+-- # effect. Doorbell registers provide interrupts in both directions: host -> CPU (db_in, CPU     #
+-- # IRQ) and CPU -> host (db_out, wbs_irq_o).                                                     #
+-- # ********************************************************************************************* #
+-- # BSD 3-Clause License                                                                          #
+-- #                                                                                               #
+-- # Copyright (c) 2020, Stephan Nolting. All rights reserved.                                     #
+-- #                                                                                               #
+-- # Redistribution and use in source and binary forms, with or without modification, are          #
+-- # permitted provided that the following conditions are met:                                     #
+-- #                                                                                               #
+-- # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+-- #    conditions and the following disclaimer.                                                   #
+-- #                                                                                               #
+-- # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+-- #    conditions and the following disclaimer in the documentation and/or other materials        #
+-- #    provided with the distribution.                                                            #
+-- #                                                                                               #
+-- # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+-- #    endorse or promote products derived from this software without specific prior written      #
+-- #    permission.                                                                                #
+-- #                                                                                               #
+-- # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+-- # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+-- # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+-- # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+-- # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+-- # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+-- # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+-- # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+-- # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+-- # ********************************************************************************************* #
+-- # The NEO430 Processor - https://github.com/stnolting/neo430                                    #
+-- #################################################################################################
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library neo430;
+use neo430.neo430_package.all;
+
+entity neo430_wb_slave is
+  generic (
+    DMEM_SIZE : natural := 2*1024 -- internal DMEM size in bytes
+  );
+  port (
+    -- host access --
+    clk_i      : in  std_ulogic; -- global clock line
+    rst_i      : in  std_ulogic; -- global reset, low-active, async
+    rden_i     : in  std_ulogic; -- read enable
+    wren_i     : in  std_ulogic; -- write enable
+    addr_i     : in  std_ulogic_vector(15 downto 0); -- address
+    data_i     : in  std_ulogic_vector(15 downto 0); -- data in
+    data_o     : out std_ulogic_vector(15 downto 0); -- data out
+    irq_o      : out std_ulogic; -- doorbell interrupt
+    -- DMEM access --
+    mem_req_o  : out std_ulogic; -- DMEM access request
+    mem_done_i : in  std_ulogic; -- DMEM access completed, read data valid
+    mem_rden_o : out std_ulogic; -- DMEM read enable
+    mem_wren_o : out std_ulogic_vector(01 downto 0); -- DMEM write enable
+    mem_addr_o : out std_ulogic_vector(15 downto 0); -- DMEM address
+    mem_data_o : out std_ulogic_vector(15 downto 0); -- DMEM write data
+    mem_data_i : in  std_ulogic_vector(15 downto 0); -- DMEM read data
+    -- wishbone slave interface --
+    wbs_adr_i  : in  std_ulogic_vector(15 downto 0); -- address
+    wbs_dat_i  : in  std_ulogic_vector(15 downto 0); -- write data
+    wbs_dat_o  : out std_ulogic_vector(15 downto 0); -- read data
+    wbs_we_i   : in  std_ulogic; -- read/write
+    wbs_sel_i  : in  std_ulogic_vector(01 downto 0); -- byte enable
+    wbs_stb_i  : in  std_ulogic; -- strobe
+    wbs_cyc_i  : in  std_ulogic; -- valid cycle
+    wbs_ack_o  : out std_ulogic; -- transfer acknowledge
+    wbs_irq_o  : out std_ulogic  -- doorbell interrupt to host
+  );
+end neo430_wb_slave;
+
+architecture neo430_wb_slave_rtl of neo430_wb_slave is
+
+  -- IO space: module base address --
+  constant hi_abb_c : natural := index_size_f(io_size_c)-1; -- high address boundary bit
+  constant lo_abb_c : natural := index_size_f(wbs_size_c); -- low address boundary bit
+
+  -- control reg bits --
+  constant ctrl_en_c     : natural :=  0; -- r/w: slave port enable
+  constant ctrl_irq_en_c : natural :=  1; -- r/w: doorbell (db_in) interrupt enable
+  constant ctrl_busy_c   : natural := 15; -- r/-: host DMEM access in progress
+
+  -- access control --
+  signal acc_en : std_ulogic; -- module access enable
+  signal addr   : std_ulogic_vector(15 downto 0); -- access address
+  signal wren   : std_ulogic;
+
+  -- accessible regs --
+  signal enable : std_ulogic;
+  signal irq_en : std_ulogic;
+  signal db_in  : std_ulogic_vector(15 downto 0); -- doorbells: host -> CPU
+  signal db_out : std_ulogic_vector(15 downto 0); -- doorbells: CPU -> host
+
+  -- host access --
+  signal wbs_dmem : std_ulogic; -- host accesses DMEM
+  signal wbs_word : std_ulogic_vector(15 downto 0); -- word-aligned host address
+  signal pending  : std_ulogic; -- host DMEM access in progress
+  signal ack      : std_ulogic;
+  signal mem_we   : std_ulogic;
+  signal mem_sel  : std_ulogic_vector(01 downto 0);
+
+begin
+
+  -- Access Control -----------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  acc_en <= '1' when (addr_i(hi_abb_c downto lo_abb_c) = wbs_base_c(hi_abb_c downto lo_abb_c)) else '0';
+  addr   <= wbs_base_c(15 downto lo_abb_c) & addr_i(lo_abb_c-1 downto 1) & '0'; -- word aligned
+  wren   <= acc_en and wren_i;
+
+  -- host address decoding --
+  wbs_dmem <= '1' when (wbs_adr_i >= dmem_base_c) and (wbs_adr_i < std_ulogic_vector(unsigned(dmem_base_c) + DMEM_SIZE)) else '0';
+  wbs_word <= wbs_adr_i(15 downto 1) & '0';
+
+
+  -- Register and Host Access -------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  rw_access: process(rst_i, clk_i)
+    variable db_in_v  : std_ulogic_vector(15 downto 0);
+    variable db_out_v : std_ulogic_vector(15 downto 0);
+  begin
+    if (rst_i = '0') then
+      enable    <= '0';
+      irq_en    <= '0';
+      db_in     <= (others => '0');
+      db_out    <= (others => '0');
+      pending   <= '0';
+      ack       <= '0';
+      irq_o     <= '0';
+      wbs_dat_o <= (others => '0');
+    elsif rising_edge(clk_i) then
+      ack      <= '0';
+      irq_o    <= '0';
+      db_in_v  := db_in;
+      db_out_v := db_out;
+
+      -- CPU write access --
+      if (wren = '1') then
+        if (addr = wbs_ctrl_addr_c) then
+          enable <= data_i(ctrl_en_c);
+          irq_en <= data_i(ctrl_irq_en_c);
+        end if;
+        if (addr = wbs_dbin_addr_c) then
+          db_in_v := db_in_v and (not data_i); -- write 1 to clear
+        end if;
+      end if;
+
+      -- host access --
+      if (pending = '0') then
+        -- a classic master still applies STB while ACK is set, so do not start a new access in that cycle --
+        if (wbs_cyc_i = '1') and (wbs_stb_i = '1') and (ack = '0') then
+          if (enable = '1') and (wbs_dmem = '1') then -- DMEM access: wait for a free DMEM cycle
+            pending <= '1';
+          else -- register or unmapped access: single cycle
+            ack       <= '1';
+            wbs_dat_o <= (others => '0');
+            if (enable = '1') then
+              if (wbs_word = wbs_dbin_addr_c) then
+                wbs_dat_o <= db_in;
+                if (wbs_we_i = '1') then
+                  db_in_v := db_in_v or wbs_dat_i; -- write 1 to set (after CPU clear: a new bell always wins)
+                  irq_o   <= irq_en and or_all_f(wbs_dat_i); -- ring!
+                end if;
+              elsif (wbs_word = wbs_dbout_addr_c) then
+                wbs_dat_o <= db_out;
+                if (wbs_we_i = '1') then
+                  db_out_v := db_out_v and (not wbs_dat_i); -- write 1 to clear
+                end if;
+              end if;
+            end if;
+          end if;
+        end if;
+      elsif (mem_done_i = '1') then -- DMEM access completed
+        pending   <= '0';
+        ack       <= '1';
+        wbs_dat_o <= mem_data_i;
+      end if;
+
+      -- CPU doorbell write --
+      if (wren = '1') and (addr = wbs_dbout_addr_c) then
+        db_out_v := db_out_v or data_i; -- write 1 to set (after host clear: a new bell always wins)
+      end if;
+
+      db_in  <= db_in_v;
+      db_out <= db_out_v;
+    end if;
+  end process rw_access;
+
+  -- host DMEM access request buffer --
+  wbs_request: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      if (pending = '0') then
+        mem_addr_o <= wbs_word;
+        mem_data_o <= wbs_dat_i;
+        mem_we     <= wbs_we_i;
+        mem_sel    <= wbs_sel_i;
+      end if;
+    end if;
+  end process wbs_request;
+
+  -- DMEM access --
+  mem_req_o  <= pending;
+  mem_rden_o <= not mem_we;
+  mem_wren_o <= mem_sel when (mem_we = '1') else "00";
+
+  -- host bus --
+  wbs_ack_o <= ack;
+  wbs_irq_o <= or_all_f(db_out);
+
+
+  -- Read Access --------------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  rd_access: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      data_o <= (others => '0');
+      if (rden_i = '1') and (acc_en = '1') then
+        if (addr = wbs_dbin_addr_c) then
+          data_o <= db_in;
+        elsif (addr = wbs_dbout_addr_c) then
+          data_o <= db_out;
+        else -- wbs_ctrl_addr_c
+          data_o(ctrl_en_c)     <= enable;
+          data_o(ctrl_irq_en_c) <= irq_en;
+          data_o(ctrl_busy_c)   <= pending;
+        end if;
+      end if;
+    end if;
+  end process rd_access;
+
+
+end neo430_wb_slave_rtl;
@@ -0,0 +1,208 @@
+-- #################################################################################################
+-- # << NEO430 - Banked Far Memory (XMEM) >>                                                       #
+-- # ********************************************************************************************* #
+-- # Additional internal RAM (XMEM_SIZE bytes, up to 1MB = 20-bit address space) beyond the 16-bit #
+-- # address space of the CPU. The far memory is accessed via a 16kB window (0x8000..0xBFFF)       #
+-- # mapped to one bank of the far memory (selected by the BANK register) - this is a normal main  #
+-- # memory access without wait states. Additionally, any far memory word can be accessed via a    #
+-- # 20-bit far pointer (PTR_LO/PTR_HI) and the DATA register, which increments the pointer by 2   #
+-- # after each access (linear block transfers). The IMEM is limited to 32kB when XMEM is used.    #
+-- # ********************************************************************************************* #
+-- # BSD 3-Clause License                                                                          #
+-- #                                                                                               #
+-- # Copyright (c) 2020, Stephan Nolting. All rights reserved.                                     #
+-- #                                                                                               #
+-- # Redistribution and use in source and binary forms, with or without modification, are          #
+-- # permitted provided that the following conditions are met:                                     #
+-- #                                                                                               #
+-- # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+-- #    conditions and the following disclaimer.                                                   #
+-- #                                                                                               #
+-- # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+-- #    conditions and the following disclaimer in the documentation and/or other materials        #
+-- #    provided with the distribution.                                                            #
+-- #                                                                                               #
+-- # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+-- #    endorse or promote products derived from this software without specific prior written      #
+-- #    permission.                                                                                #
+-- #                                                                                               #
+-- # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+-- # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+-- # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+-- # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+-- # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+-- # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+-- # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+-- # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+-- # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+-- # ********************************************************************************************* #
+-- # The NEO430 Processor - https://github.com/stnolting/neo430                                    #
+-- #################################################################################################
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library neo430;
+use neo430.neo430_package.all;
+
+entity neo430_xmem is
+  generic (
+    XMEM_SIZE : natural := 64*1024; -- far memory size in bytes, power of two, 16kB..1MB
+    IMEM_SIZE : natural := 4*1024   -- internal IMEM size in bytes, max 32kB
+  );
+  port (
+    -- host access: control registers --
+    clk_i      : in  std_ulogic; -- global clock line
+    rden_i     : in  std_ulogic; -- read enable
+    wren_i     : in  std_ulogic; -- write enable
+    addr_i     : in  std_ulogic_vector(15 downto 0); -- address
+    data_i     : in  std_ulogic_vector(15 downto 0); -- data in
+    data_o     : out std_ulogic_vector(15 downto 0); -- data out
+    -- host access: memory window --
+    win_rden_i : in  std_ulogic; -- read enable
+    win_wren_i : in  std_ulogic_vector(01 downto 0); -- write enable
+    win_addr_i : in  std_ulogic_vector(15 downto 0); -- address
+    win_data_i : in  std_ulogic_vector(15 downto 0); -- data in
+    win_data_o : out std_ulogic_vector(15 downto 0)  -- data out
+  );
+end neo430_xmem;
+
+architecture neo430_xmem_rtl of neo430_xmem is
+
+  -- IO space: module base address --
+  constant hi_abb_c : natural := index_size_f(io_size_c)-1; -- high address boundary bit
+  constant lo_abb_c : natural := index_size_f(xmem_size_c); -- low address boundary bit
+
+  -- memory configuration --
+  constant words_c    : natural := XMEM_SIZE/2; -- number of 16-bit words
+  constant word_abb_c : natural := index_size_f(words_c); -- word address width
+
+  -- access control --
+  signal acc_en  : std_ulogic; -- module access enable
+  signal addr    : std_ulogic_vector(15 downto 0); -- access address
+  signal wren    : std_ulogic; -- word write enable
+  signal rden    : std_ulogic; -- read enable
+  signal dat_acc : std_ulogic; -- access to DATA register
+  signal dat_rd  : std_ulogic; -- DATA register has been read
+  signal win_acc : std_ulogic; -- access to memory window
+  signal win_rd  : std_ulogic; -- memory window has been read
+
+  -- accessible registers --
+  signal bank  : std_ulogic_vector(05 downto 0); -- window bank select
+  signal ptr   : std_ulogic_vector(19 downto 0); -- far pointer
+  signal rdata : std_ulogic_vector(15 downto 0); -- register read data
+
+  -- memory port --
+  signal mem_adr   : std_ulogic_vector(18 downto 0); -- word address
+  signal mem_wren  : std_ulogic_vector(01 downto 0);
+  signal mem_wdata : std_ulogic_vector(15 downto 0);
+  signal mem_rdata : std_ulogic_vector(15 downto 0);
+
+  -- RAM --
+  type xmem_file_t is array (0 to words_c-1) of std_ulogic_vector(7 downto 0);
+  signal xmem_file_l : xmem_file_t;
+  signal xmem_file_h : xmem_file_t;
+
+  -- RAM attribute to inhibit bypass-logic - Intel only! --
+  attribute ramstyle : string;
+  attribute ramstyle of xmem_file_l : signal is "no_rw_check";
+  attribute ramstyle of xmem_file_h : signal is "no_rw_check";
+
+  -- RAM attribute to inhibit bypass-logic - Lattice ICE40up only! --
+  attribute syn_ramstyle : string;
+  attribute syn_ramstyle of xmem_file_l : signal is "no_rw_check";
+  attribute syn_ramstyle of xmem_file_h : signal is "no_rw_check";
+
+begin
+
+  -- Sanity Checks ------------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  assert not ((XMEM_SIZE < xmem_win_size_c) or (XMEM_SIZE > xmem_max_size_c) or (is_power_of_two_f(XMEM_SIZE/xmem_win_size_c, 16) = false))
+    report "NEO430 XMEM: XMEM_SIZE has to be a power of two (16kB..1MB)!" severity error;
+  assert not (IMEM_SIZE > (to_integer(unsigned(xmem_win_base_c)) - to_integer(unsigned(imem_base_c))))
+    report "NEO430 XMEM: IMEM overlaps with the far memory window! Max IMEM size is 32kB when using XMEM." severity error;
+
+
+  -- Access Control -----------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  acc_en  <= '1' when (addr_i(hi_abb_c downto lo_abb_c) = xmem_base_c(hi_abb_c downto lo_abb_c)) else '0';
+  addr    <= xmem_base_c(15 downto lo_abb_c) & addr_i(lo_abb_c-1 downto 1) & '0'; -- word aligned
+  wren    <= acc_en and wren_i;
+  rden    <= acc_en and rden_i;
+  dat_acc <= (wren or rden) when (addr = xmem_data_addr_c) else '0';
+
+  -- the CPU cannot access the window and the IO registers at the same time --
+  win_acc <= '1' when (win_addr_i(15 downto 14) = xmem_win_base_c(15 downto 14)) and
+                      ((win_rden_i or win_wren_i(0) or win_wren_i(1)) = '1') else '0';
+
+
+  -- Write Access -------------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  write_access: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      if (wren = '1') then
+        case addr is
+          when xmem_bank_addr_c  => bank <= data_i(05 downto 0);
+          when xmem_ptrlo_addr_c => ptr(15 downto 00) <= data_i;
+          when xmem_ptrhi_addr_c => ptr(19 downto 16) <= data_i(03 downto 0);
+          when others            => NULL;
+        end case;
+      end if;
+      if (dat_acc = '1') then -- auto-increment far pointer after DATA access
+        ptr <= std_ulogic_vector(unsigned(ptr) + 2);
+      end if;
+    end if;
+  end process write_access;
+
+
+  -- Memory Access ------------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  -- single memory port shared by window and DATA register --
+  mem_adr   <= (bank & win_addr_i(13 downto 1)) when (win_acc = '1') else ptr(19 downto 1);
+  mem_wren  <= win_wren_i when (win_acc = '1') else (others => (wren and dat_acc));
+  mem_wdata <= win_data_i when (win_acc = '1') else data_i;
+
+  xmem_file_access: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      if ((win_acc or dat_acc) = '1') then -- reduce switching activity when not accessed
+        if (mem_wren(0) = '1') then -- write low byte
+          xmem_file_l(to_integer(unsigned(mem_adr(word_abb_c-1 downto 0)))) <= mem_wdata(07 downto 0);
+        end if;
+        mem_rdata(07 downto 0) <= xmem_file_l(to_integer(unsigned(mem_adr(word_abb_c-1 downto 0))));
+        if (mem_wren(1) = '1') then -- write high byte
+          xmem_file_h(to_integer(unsigned(mem_adr(word_abb_c-1 downto 0)))) <= mem_wdata(15 downto 8);
+        end if;
+        mem_rdata(15 downto 8) <= xmem_file_h(to_integer(unsigned(mem_adr(word_abb_c-1 downto 0))));
+      end if;
+    end if;
+  end process xmem_file_access;
+
+
+  -- Read Access --------------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  read_access: process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      win_rd <= win_acc and win_rden_i;
+      dat_rd <= dat_acc and rden_i;
+      rdata  <= (others => '0');
+      if (rden = '1') then
+        case addr is
+          when xmem_bank_addr_c  => rdata(05 downto 0) <= bank;
+          when xmem_ptrlo_addr_c => rdata <= ptr(15 downto 00);
+          when xmem_ptrhi_addr_c => rdata(03 downto 0) <= ptr(19 downto 16);
+          when others            => rdata <= (others => '0'); -- xmem_data_addr_c: memory read data
+        end case;
+      end if;
+    end if;
+  end process read_access;
+
+  -- output gates --
+  data_o     <= mem_rdata when (dat_rd = '1') else rdata;
+  win_data_o <= mem_rdata when (win_rd = '1') else (others => '0');
+
+
+end neo430_xmem_rtl;
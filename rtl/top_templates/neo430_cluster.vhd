@@ -0,0 +1,295 @@
+-- #################################################################################################
+-- # << NEO430 - Multi-Core Cluster (neo430_cluster.vhd) >>                                        #
+-- # ********************************************************************************************* #
+-- # Instantiates NUM_CORES processors (neo430_top) with private IMEM and DMEM. All cores share a  #
+-- # round-robin arbitrated memory (SHMEM_SIZE bytes) attached to their WB32 Wishbone interfaces   #
+-- # and the inter-core mailbox (neo430_mailbox: messages, semaphores, doorbells). Each core reads #
+-- # its hart ID from SYSCONFIG (CPUID10 = HART_ID). The console UART and the GPIO port of core 0  #
+-- # are connected to the cluster's ports.                                                         #
+-- # ********************************************************************************************* #
+-- # BSD 3-Clause License                                                                          #
+-- #                                                                                               #
+-- # Copyright (c) 2020, Stephan Nolting. All rights reserved.                                     #
+-- #                                                                                               #
+-- # Redistribution and use in source and binary forms, with or without modification, are          #
+-- # permitted provided that the following conditions are met:                                     #
+-- #                                                                                               #
+-- # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+-- #    conditions and the following disclaimer.                                                   #
+-- #                                                                                               #
+-- # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+-- #    conditions and the following disclaimer in the documentation and/or other materials        #
+-- #    provided with the distribution.                                                            #
+-- #                                                                                               #
+-- # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+-- #    endorse or promote products derived from this software without specific prior written      #
+-- #    permission.                                                                                #
+-- #                                                                                               #
+-- # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+-- # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+-- # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+-- # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+-- # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+-- # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+-- # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+-- # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+-- # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+-- # ********************************************************************************************* #
+-- # The NEO430 Processor - https://github.com/stnolting/neo430                                    #
+-- #################################################################################################
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library neo430;
+use neo430.neo430_package.all;
+
+entity neo430_cluster is
+  generic (
+    -- general configuration --
+    CLOCK_SPEED : natural := 100000000; -- main clock in Hz
+    NUM_CORES   : natural := 2;         -- number of processor cores (1..8)
+    IMEM_SIZE   : natural := 4*1024;    -- private IMEM size of each core in bytes, max 48kB (default=4kB)
+    DMEM_SIZE   : natural := 2*1024;    -- private DMEM size of each core in bytes, max 12kB (default=2kB)
+    SHMEM_SIZE  : natural := 4*1024;    -- shared memory size in bytes, power of two (default=4kB)
+    -- additional configuration --
+    USER_CODE   : std_ulogic_vector(15 downto 0) := x"0000"; -- custom user code (all cores)
+    -- boot configuration --
+    BOOTLD_USE  : boolean := false      -- implement and use bootloader? (default=false)
+  );
+  port (
+    -- global control --
+    clk_i      : in  std_ulogic; -- global clock, rising edge
+    rst_i      : in  std_ulogic; -- global reset, async, LOW-active
+    -- parallel io (core 0) --
+    gpio_o     : out std_ulogic_vector(15 downto 0); -- parallel output
+    gpio_i     : in  std_ulogic_vector(15 downto 0); -- parallel input
+    -- serial com (core 0) --
+    uart_txd_o : out std_ulogic; -- UART send data
+    uart_rxd_i : in  std_ulogic  -- UART receive data
+  );
+end neo430_cluster;
+
+architecture neo430_cluster_rtl of neo430_cluster is
+
+  -- shared memory --
+  constant shmem_words_c : natural := SHMEM_SIZE/4;
+  type shmem_t is array (0 to shmem_words_c-1) of std_ulogic_vector(07 downto 0);
+  signal shmem_b0, shmem_b1, shmem_b2, shmem_b3 : shmem_t;
+
+  -- wishbone masters (one per core) --
+  type wb_adr_t is array (0 to NUM_CORES-1) of std_ulogic_vector(31 downto 0);
+  type wb_sel_t is array (0 to NUM_CORES-1) of std_ulogic_vector(03 downto 0);
+  signal wb_adr   : wb_adr_t;
+  signal wb_wdata : wb_adr_t;
+  signal wb_rdata : std_ulogic_vector(31 downto 0);
+  signal wb_sel   : wb_sel_t;
+  signal wb_we    : std_ulogic_vector(NUM_CORES-1 downto 0);
+  signal wb_cyc   : std_ulogic_vector(NUM_CORES-1 downto 0);
+  signal wb_ack   : std_ulogic_vector(NUM_CORES-1 downto 0);
+
+  -- shared memory arbiter --
+  signal arb_busy  : std_ulogic; -- access granted, executed in next cycle
+  signal arb_grant : natural range 0 to NUM_CORES-1; -- current master
+  signal arb_next  : natural range 0 to NUM_CORES-1; -- master with highest priority (round-robin)
+
+  -- core IO --
+  type gpio_t is array (0 to NUM_CORES-1) of std_ulogic_vector(15 downto 0);
+  signal gpio_out : gpio_t;
+  signal uart_txd : std_ulogic_vector(NUM_CORES-1 downto 0);
+
+  -- inter-core mailbox --
+  signal mbox_rd  : std_ulogic_vector(NUM_CORES-1 downto 0);
+  signal mbox_wr  : std_ulogic_vector(NUM_CORES-1 downto 0);
+  signal mbox_adr : std_ulogic_vector(NUM_CORES*3-1 downto 0);
+  signal mbox_wdt : std_ulogic_vector(NUM_CORES*16-1 downto 0);
+  signal mbox_rdt : std_ulogic_vector(NUM_CORES*16-1 downto 0);
+  signal mbox_irq : std_ulogic_vector(NUM_CORES-1 downto 0);
+
+begin
+
+  -- Sanity Checks ------------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  assert not ((NUM_CORES = 0) or (NUM_CORES > 8)) report "NEO430 CLUSTER: NUM_CORES has to be 1..8!" severity error;
+  assert not ((SHMEM_SIZE < 4) or (is_power_of_two_f(SHMEM_SIZE, 32) = false)) report "NEO430 CLUSTER: SHMEM_SIZE has to be a power of two!" severity error;
+
+
+  -- Processor Cores ----------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  -- all cores execute the same program; each core gets its hart ID via SYSCONFIG (HART_ID, CPUID10) --
+  neo430_cluster_cores:
+  for i in 0 to NUM_CORES-1 generate
+    neo430_top_inst: neo430_top
+    generic map (
+      -- general configuration --
+      CLOCK_SPEED  => CLOCK_SPEED,      -- main clock in Hz
+      IMEM_SIZE    => IMEM_SIZE,        -- internal IMEM size in bytes, max 48kB (default=4kB)
+      DMEM_SIZE    => DMEM_SIZE,        -- internal DMEM size in bytes, max 12kB (default=2kB)
+      -- additional configuration --
+      USER_CODE    => USER_CODE,        -- custom user code
+      HART_ID      => i,                -- core ID in multi-core systems
+      -- module configuration --
+      MULDIV_USE   => true,             -- implement multiplier/divider unit? (default=true)
+      WB32_USE     => true,             -- implement WB32 unit? (default=true) - shared memory access
+      WDT_USE      => true,             -- implement WBT? (default=true)
+      GPIO_USE     => (i = 0),          -- implement GPIO unit? (default=true)
+      TIMER_USE    => true,             -- implement timer? (default=true)
+      UART_USE     => (i = 0),          -- implement UART? (default=true)
+      CRC_USE      => false,            -- implement CRC unit? (default=true)
+      CFU_USE      => false,            -- implement custom functions unit? (default=false)
+      PWM_USE      => false,            -- implement PWM controller? (default=true)
+      TWI_USE      => false,            -- implement two wire serial interface? (default=true)
+      SPI_USE      => false,            -- implement SPI? (default=true)
+      TRNG_USE     => false,            -- implement TRNG? (default=false)
+      EXIRQ_USE    => false,            -- implement EXIRQ? (default=true)
+      FREQ_GEN_USE => false,            -- implement FREQ_GEN? (default=true)
+      BMU_USE      => false,            -- implement BMU? (default=false)
+      WBS_USE      => false,            -- implement wishbone slave port? (default=false)
+      MBOX_USE     => true,             -- implement inter-core mailbox port? (default=false)
+      -- boot configuration --
+      BOOTLD_USE   => BOOTLD_USE,       -- implement and use bootloader? (default=true)
+      IMEM_AS_ROM  => false             -- implement IMEM as read-only memory? (default=false)
+    )
+    port map (
+      -- global control --
+      clk_i      => clk_i,              -- global clock, rising edge
+      clk_io_i   => clk_i,              -- peripheral clock, same as global clock
+      rst_i      => rst_i,              -- global reset, async, low-active
+      -- gpio --
+      gpio_o     => gpio_out(i),        -- parallel output
+      gpio_i     => gpio_i,             -- parallel input
+      -- pwm channels --
+      pwm_o      => open,               -- pwm channels
+      -- arbitrary frequency generator --
+      freq_gen_o => open,               -- programmable frequency output
+      -- serial com --
+      uart_txd_o => uart_txd(i),        -- UART send data
+      uart_rxd_i => uart_rxd_i,         -- UART receive data
+      spi_sclk_o => open,               -- serial clock line
+      spi_mosi_o => open,               -- serial data line out
+      spi_miso_i => '0',                -- serial data line in
+      spi_cs_o   => open,               -- SPI CS 0..5
+      spi_dq_io  => open,               -- SPI dual/quad data lines IO0..IO3
+      twi_sda_io => open,               -- twi serial data line
+      twi_scl_io => open,               -- twi serial clock line
+      -- 32-bit wishbone interface (shared memory) --
+      wb_adr_o   => wb_adr(i),          -- address
+      wb_dat_i   => wb_rdata,           -- read data
+      wb_dat_o   => wb_wdata(i),        -- write data
+      wb_we_o    => wb_we(i),           -- read/write
+      wb_sel_o   => wb_sel(i),          -- byte enable
+      wb_stb_o   => open,               -- strobe (CYC is kept high until ACK)
+      wb_cyc_o   => wb_cyc(i),          -- valid cycle
+      wb_ack_i   => wb_ack(i),          -- transfer acknowledge
+      -- 16-bit wishbone slave interface --
+      wbs_adr_i  => x"0000",            -- address
+      wbs_dat_i  => x"0000",            -- write data
+      wbs_dat_o  => open,               -- read data
+      wbs_we_i   => '0',                -- read/write
+      wbs_sel_i  => "00",               -- byte enable
+      wbs_stb_i  => '0',                -- strobe
+      wbs_cyc_i  => '0',                -- valid cycle
+      wbs_ack_o  => open,               -- transfer acknowledge
+      wbs_irq_o  => open,               -- doorbell interrupt to host
+      -- inter-core mailbox interface --
+      mbox_rd_o  => mbox_rd(i),                    -- read enable
+      mbox_wr_o  => mbox_wr(i),                    -- write enable
+      mbox_adr_o => mbox_adr(i*3+2 downto i*3),    -- register (word) address
+      mbox_dat_o => mbox_wdt(i*16+15 downto i*16), -- write data
+      mbox_dat_i => mbox_rdt(i*16+15 downto i*16), -- read data
+      mbox_irq_i => mbox_irq(i),                   -- mailbox interrupt
+      -- external interrupts --
+      ext_irq_i  => x"00",              -- external interrupt request lines
+      ext_ack_o  => open                -- external interrupt request acknowledges
+    );
+  end generate;
+
+  -- console and parallel IO: core 0 only --
+  gpio_o     <= gpio_out(0);
+  uart_txd_o <= uart_txd(0);
+
+
+  -- Shared Memory Arbiter ----------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  -- round-robin arbitration: a granted access is executed in the next cycle and acknowledged one cycle later --
+  shmem_arbiter: process(rst_i, clk_i)
+    variable c_v     : natural range 0 to NUM_CORES-1;
+    variable found_v : boolean;
+  begin
+    if (rst_i = '0') then
+      arb_busy  <= '0';
+      arb_grant <= 0;
+      arb_next  <= 0;
+      wb_ack    <= (others => '0');
+    elsif rising_edge(clk_i) then
+      wb_ack <= (others => '0');
+      if (arb_busy = '0') then
+        found_v := false;
+        for k in 0 to NUM_CORES-1 loop
+          c_v := (arb_next + k) mod NUM_CORES;
+          -- CYC is still set in the cycle in which ACK is seen by the master --
+          if (found_v = false) and (wb_cyc(c_v) = '1') and (wb_ack(c_v) = '0') then
+            found_v   := true;
+            arb_grant <= c_v;
+            arb_busy  <= '1';
+          end if;
+        end loop;
+      else
+        wb_ack(arb_grant) <= wb_cyc(arb_grant); -- master might have aborted the transfer
+        arb_next <= (arb_grant + 1) mod NUM_CORES;
+        arb_busy <= '0';
+      end if;
+    end if;
+  end process shmem_arbiter;
+
+
+  -- Shared Memory ------------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  -- the shared memory is mirrored over the complete Wishbone address space --
+  shmem_access: process(clk_i)
+    variable addr_v : natural range 0 to shmem_words_c-1;
+  begin
+    if rising_edge(clk_i) then
+      addr_v := to_integer(unsigned(wb_adr(arb_grant)(index_size_f(SHMEM_SIZE)-1 downto 2)));
+      if (arb_busy = '1') and (wb_we(arb_grant) = '1') and (wb_cyc(arb_grant) = '1') then
+        if (wb_sel(arb_grant)(0) = '1') then
+          shmem_b0(addr_v) <= wb_wdata(arb_grant)(07 downto 00);
+        end if;
+        if (wb_sel(arb_grant)(1) = '1') then
+          shmem_b1(addr_v) <= wb_wdata(arb_grant)(15 downto 08);
+        end if;
+        if (wb_sel(arb_grant)(2) = '1') then
+          shmem_b2(addr_v) <= wb_wdata(arb_grant)(23 downto 16);
+        end if;
+        if (wb_sel(arb_grant)(3) = '1') then
+          shmem_b3(addr_v) <= wb_wdata(arb_grant)(31 downto 24);
+        end if;
+      end if;
+      wb_rdata <= shmem_b3(addr_v) & shmem_b2(addr_v) & shmem_b1(addr_v) & shmem_b0(addr_v);
+    end if;
+  end process shmem_access;
+
+
+  -- Inter-Core Mailbox -------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  neo430_mailbox_inst: neo430_mailbox
+  generic map (
+    NUM_CORES => NUM_CORES,             -- number of attached cores (1..8)
+    FIFO_SIZE => 4                      -- message FIFO depth per core (power of two, min 2)
+  )
+  port map (
+    -- global control --
+    clk_i => clk_i,                     -- global clock line
+    rst_i => rst_i,                     -- global reset, low-active, async
+    -- core ports --
+    rd_i  => mbox_rd,                   -- read enable
+    wr_i  => mbox_wr,                   -- write enable
+    adr_i => mbox_adr,                  -- register (word) address
+    dat_i => mbox_wdt,                  -- write data
+    dat_o => mbox_rdt,                  -- read data
+    irq_o => mbox_irq                   -- interrupt (message received / doorbell)
+  );
+
+
+end neo430_cluster_rtl;
@@ -72,6 +72,9 @@ begin
     CLOCK_SPEED  => 100000000,        -- main clock in Hz
     IMEM_SIZE    => 4*1024,           -- internal IMEM size in bytes, max 48kB (default=4kB)
     DMEM_SIZE    => 2*1024,           -- internal DMEM size in bytes, max 12kB (default=2kB)
+    IMEM_WAIT    => 0,                -- wait states for each IMEM access (default=0)
+    DMEM_WAIT    => 0,                -- wait states for each DMEM access (default=0)
+    XMEM_SIZE    => 0,                -- banked far memory size in bytes, 0 = none, 16kB..1MB (default=0)
     -- additional configuration --
     USER_CODE    => x"CAFE",          -- custom user code
     -- module configuration --
@@ -89,6 +92,9 @@ begin
     TRNG_USE     => false,            -- implement TRNG? (default=false)
     EXIRQ_USE    => true,             -- implement EXIRQ? (default=true)
     FREQ_GEN_USE => true,             -- implement FREQ_GEN? (default=true)
+    BMU_USE      => false,            -- implement BMU? (default=false)
+    WBS_USE      => false,            -- implement wishbone slave port? (default=false)
+    MBOX_USE     => false,            -- implement inter-core mailbox port? (default=false)
     -- boot configuration --
     BOOTLD_USE   => true,             -- implement and use bootloader? (default=true)
     IMEM_AS_ROM  => false             -- implement IMEM as read-only memory? (default=false)
@@ -96,6 +102,7 @@ begin
   port map (
     -- global control --
     clk_i      => clk_i,              -- global clock, rising edge
+    clk_io_i   => clk_i,              -- peripheral clock, same as global clock
     rst_i      => rst_int,            -- global reset, async, low-active
     -- gpio --
     gpio_o     => gpio_out,           -- parallel output
@@ -111,6 +118,7 @@ begin
     spi_mosi_o => open,               -- serial data line out
     spi_miso_i => '0',                -- serial data line in
     spi_cs_o   => open,               -- SPI CS
+    spi_dq_io  => open,               -- SPI dual/quad data lines IO0..IO3
     twi_sda_io => open,               -- twi serial data line
     twi_scl_io => open,               -- twi serial clock line
     -- 32-bit wishbone interface --
@@ -122,6 +130,23 @@ begin
     wb_stb_o   => open,               -- strobe
     wb_cyc_o   => open,               -- valid cycle
     wb_ack_i   => '0',                -- transfer acknowledge
+    -- 16-bit wishbone slave interface --
+    wbs_adr_i  => x"0000",            -- address
+    wbs_dat_i  => x"0000",            -- write data
+    wbs_dat_o  => open,               -- read data
+    wbs_we_i   => '0',                -- read/write
+    wbs_sel_i  => "00",               -- byte enable
+    wbs_stb_i  => '0',                -- strobe
+    wbs_cyc_i  => '0',                -- valid cycle
+    wbs_ack_o  => open,               -- transfer acknowledge
+    wbs_irq_o  => open,               -- doorbell interrupt to host
+    -- inter-core mailbox interface --
+    mbox_rd_o  => open,               -- read enable
+    mbox_wr_o  => open,               -- write enable
+    mbox_adr_o => open,               -- register (word) address
+    mbox_dat_o => open,               -- write data
+    mbox_dat_i => x"0000",            -- read data
+    mbox_irq_i => '0',                -- mailbox interrupt
     -- external interrupts --
     ext_irq_i  => "00000000",         -- external interrupt request lines
     ext_ack_o  => open                -- external interrupt request acknowledges
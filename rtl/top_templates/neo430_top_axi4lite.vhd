@@ -45,6 +45,9 @@ entity neo430_top_axi4lite is
     CLOCK_SPEED  : natural := 100000000; -- main clock in Hz
     IMEM_SIZE    : natural := 4*1024; -- internal IMEM size in bytes, max 32kB (default=4kB)
     DMEM_SIZE    : natural := 2*1024; -- internal DMEM size in bytes, max 28kB (default=2kB)
+    IMEM_WAIT    : natural := 0;      -- wait states for each IMEM access (default=0)
+    DMEM_WAIT    : natural := 0;      -- wait states for each DMEM access (default=0)
+    XMEM_SIZE    : natural := 0;      -- banked far memory size in bytes, 0 = none, 16kB..1MB (default=0)
     -- additional configuration --
     USER_CODE    : std_logic_vector(15 downto 0) := x"0000"; -- custom user code
     -- module configuration --
@@ -62,6 +65,7 @@ entity neo430_top_axi4lite is
     TRNG_USE     : boolean := false; -- implement TRNG? (default=false)
     EXIRQ_USE    : boolean := true; -- implement EXIRQ? (default=true)
     FREQ_GEN_USE : boolean := true; -- implement FREQ_GEN? (default=true)
+    BMU_USE      : boolean := false; -- implement bit manipulation unit? (default=false)
     -- boot configuration --
     BOOTLD_USE   : boolean := true; -- implement and use bootloader? (default=true)
     IMEM_AS_ROM  : boolean := false -- implement IMEM as read-only memory? (default=false)
@@ -82,6 +86,7 @@ entity neo430_top_axi4lite is
     spi_mosi_o    : out std_logic; -- serial data line out
     spi_miso_i    : in  std_logic; -- serial data line in
     spi_cs_o      : out std_logic_vector(05 downto 0); -- SPI CS
+    spi_dq_io     : inout std_logic_vector(03 downto 0); -- SPI dual/quad data lines IO0..IO3
     twi_sda_io    : inout std_logic; -- twi serial data line
     twi_scl_io    : inout std_logic; -- twi serial clock line
     -- external interrupts --
@@ -166,6 +171,9 @@ begin
     CLOCK_SPEED  => CLOCK_SPEED,      -- main clock in Hz
     IMEM_SIZE    => IMEM_SIZE,        -- internal IMEM size in bytes, max 48kB (default=4kB)
     DMEM_SIZE    => DMEM_SIZE,        -- internal DMEM size in bytes, max 12kB (default=2kB)
+    IMEM_WAIT    => IMEM_WAIT,        -- wait states for each IMEM access (default=0)
+    DMEM_WAIT    => DMEM_WAIT,        -- wait states for each DMEM access (default=0)
+    XMEM_SIZE    => XMEM_SIZE,        -- banked far memory size in bytes, 0 = none, 16kB..1MB (default=0)
     -- additional configuration --
     USER_CODE    => usrcode_c,        -- custom user code
     -- module configuration --
@@ -183,6 +191,9 @@ begin
     TRNG_USE     => TRNG_USE,         -- implement TRNG? (default=false)
     EXIRQ_USE    => EXIRQ_USE,        -- implement EXIRQ? (default=true)
     FREQ_GEN_USE => FREQ_GEN_USE,     -- implement FREQ_GEN? (default=true)
+    BMU_USE      => BMU_USE,          -- implement BMU? (default=false)
+    WBS_USE      => false,            -- implement wishbone slave port? (not available in this template)
+    MBOX_USE     => false,            -- implement inter-core mailbox port? (not available in this template)
     -- boot configuration --
     BOOTLD_USE   => BOOTLD_USE,       -- implement and use bootloader? (default=true)
     IMEM_AS_ROM  => IMEM_AS_ROM       -- implement IMEM as read-only memory? (default=false)
@@ -190,6 +201,7 @@ begin
   port map (
     -- global control --
     clk_i       => m_axi_aclk,        -- global clock, rising edge
+    clk_io_i    => m_axi_aclk,        -- peripheral clock, same as global clock
     rst_i       => m_axi_aresetn,     -- global reset, async, LOW-active
     -- parallel io --
     gpio_o      => gpio_o_int,        -- parallel output
@@ -205,6 +217,7 @@ begin
     spi_mosi_o  => spi_mosi_o_int,    -- serial data line out
     spi_miso_i  => spi_miso_i_int,    -- serial data line in
     spi_cs_o    => spi_cs_o_int,      -- SPI CS
+    spi_dq_io   => spi_dq_io,         -- SPI dual/quad data lines IO0..IO3
     twi_sda_io  => twi_sda_io,        -- twi serial data line
     twi_scl_io  => twi_scl_io,        -- twi serial clock line
     -- 32-bit wishbone interface --
@@ -216,6 +229,23 @@ begin
     wb_stb_o    => wb_core.stb,       -- strobe
     wb_cyc_o    => wb_core.cyc,       -- valid cycle
     wb_ack_i    => wb_core.ack,       -- transfer acknowledge
+    -- 16-bit wishbone slave interface (not used) --
+    wbs_adr_i   => x"0000",           -- address
+    wbs_dat_i   => x"0000",           -- write data
+    wbs_dat_o   => open,              -- read data
+    wbs_we_i    => '0',               -- read/write
+    wbs_sel_i   => "00",              -- byte enable
+    wbs_stb_i   => '0',               -- strobe
+    wbs_cyc_i   => '0',               -- valid cycle
+    wbs_ack_o   => open,              -- transfer acknowledge
+    wbs_irq_o   => open,              -- doorbell interrupt to host
+    -- inter-core mailbox interface --
+    mbox_rd_o   => open,              -- read enable
+    mbox_wr_o   => open,              -- write enable
+    mbox_adr_o  => open,              -- register (word) address
+    mbox_dat_o  => open,              -- write data
+    mbox_dat_i  => x"0000",           -- read data
+    mbox_irq_i  => '0',               -- mailbox interrupt
     -- interrupts --
     ext_irq_i   => irq_i_int,          -- external interrupt request line
     ext_ack_o   => irq_ack_o_int       -- external interrupt request acknowledge
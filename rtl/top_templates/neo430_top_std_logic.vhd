@@ -45,6 +45,9 @@ entity neo430_top_std_logic is
     CLOCK_SPEED  : natural := 100000000; -- main clock in Hz
     IMEM_SIZE    : natural := 4*1024; -- internal IMEM size in bytes, max 48kB (default=4kB)
     DMEM_SIZE    : natural := 2*1024; -- internal DMEM size in bytes, max 12kB (default=2kB)
+    IMEM_WAIT    : natural := 0;      -- wait states for each IMEM access (default=0)
+    DMEM_WAIT    : natural := 0;      -- wait states for each DMEM access (default=0)
+    XMEM_SIZE    : natural := 0;      -- banked far memory size in bytes, 0 = none, 16kB..1MB (default=0)
     -- additional configuration --
     USER_CODE    : std_logic_vector(15 downto 0) := x"0000"; -- custom user code
     -- module configuration --
@@ -62,6 +65,8 @@ entity neo430_top_std_logic is
     TRNG_USE     : boolean := false; -- implement TRNG? (default=false)
     EXIRQ_USE    : boolean := true; -- implement EXIRQ? (default=true)
     FREQ_GEN_USE : boolean := true; -- implement FREQ_GEN? (default=true)
+    BMU_USE      : boolean := false; -- implement bit manipulation unit? (default=false)
+    WBS_USE      : boolean := false; -- implement wishbone slave port (DMEM access)? (default=false)
     -- boot configuration --
     BOOTLD_USE   : boolean := true; -- implement and use bootloader? (default=true)
     IMEM_AS_ROM  : boolean := false -- implement IMEM as read-only memory? (default=false)
@@ -84,6 +89,7 @@ entity neo430_top_std_logic is
     spi_mosi_o  : out std_logic; -- serial data line out
     spi_miso_i  : in  std_logic; -- serial data line in
     spi_cs_o    : out std_logic_vector(05 downto 0); -- SPI CS
+    spi_dq_io   : inout std_logic_vector(03 downto 0); -- SPI dual/quad data lines IO0..IO3
     twi_sda_io  : inout std_logic; -- twi serial data line
     twi_scl_io  : inout std_logic; -- twi serial clock line
     -- 32-bit wishbone interface --
@@ -95,6 +101,16 @@ entity neo430_top_std_logic is
     wb_stb_o    : out std_logic; -- strobe
     wb_cyc_o    : out std_logic; -- valid cycle
     wb_ack_i    : in  std_logic; -- transfer acknowledge
+    -- 16-bit wishbone slave interface (external DMEM access) --
+    wbs_adr_i   : in  std_logic_vector(15 downto 0); -- address
+    wbs_dat_i   : in  std_logic_vector(15 downto 0); -- write data
+    wbs_dat_o   : out std_logic_vector(15 downto 0); -- read data
+    wbs_we_i    : in  std_logic; -- read/write
+    wbs_sel_i   : in  std_logic_vector(01 downto 0); -- byte enable
+    wbs_stb_i   : in  std_logic; -- strobe
+    wbs_cyc_i   : in  std_logic; -- valid cycle
+    wbs_ack_o   : out std_logic; -- transfer acknowledge
+    wbs_irq_o   : out std_logic; -- doorbell interrupt to host
     -- external interrupts --
     ext_irq_i   : in  std_logic_vector(07 downto 0); -- external interrupt request lines
     ext_ack_o   : out std_logic_vector(07 downto 0)  -- external interrupt request acknowledges
@@ -126,6 +142,15 @@ architecture neo430_top_std_logic_rtl of neo430_top_std_logic is
   signal wb_stb_o_int   : std_ulogic;
   signal wb_cyc_o_int   : std_ulogic;
   signal wb_ack_i_int   : std_ulogic;
+  signal wbs_adr_i_int  : std_ulogic_vector(15 downto 0);
+  signal wbs_dat_i_int  : std_ulogic_vector(15 downto 0);
+  signal wbs_dat_o_int  : std_ulogic_vector(15 downto 0);
+  signal wbs_we_i_int   : std_ulogic;
+  signal wbs_sel_i_int  : std_ulogic_vector(01 downto 0);
+  signal wbs_stb_i_int  : std_ulogic;
+  signal wbs_cyc_i_int  : std_ulogic;
+  signal wbs_ack_o_int  : std_ulogic;
+  signal wbs_irq_o_int  : std_ulogic;
   signal freq_gen_o_int : std_ulogic_vector(02 downto 0);
 
 begin
@@ -138,6 +163,9 @@ begin
     CLOCK_SPEED  => CLOCK_SPEED,      -- main clock in Hz
     IMEM_SIZE    => IMEM_SIZE,        -- internal IMEM size in bytes, max 48kB (default=4kB)
     DMEM_SIZE    => DMEM_SIZE,        -- internal DMEM size in bytes, max 12kB (default=2kB)
+    IMEM_WAIT    => IMEM_WAIT,        -- wait states for each IMEM access (default=0)
+    DMEM_WAIT    => DMEM_WAIT,        -- wait states for each DMEM access (default=0)
+    XMEM_SIZE    => XMEM_SIZE,        -- banked far memory size in bytes, 0 = none, 16kB..1MB (default=0)
     -- additional configuration --
     USER_CODE    => usrcode_c,        -- custom user code
     -- module configuration --
@@ -155,6 +183,9 @@ begin
     TRNG_USE     => TRNG_USE,         -- implement TRNG? (default=false)
     EXIRQ_USE    => EXIRQ_USE,        -- implement EXIRQ? (default=true)
     FREQ_GEN_USE => FREQ_GEN_USE,     -- implement FREQ_GEN? (default=true)
+    BMU_USE      => BMU_USE,          -- implement BMU? (default=false)
+    WBS_USE      => WBS_USE,          -- implement wishbone slave port? (default=false)
+    MBOX_USE     => false,            -- implement inter-core mailbox port? (not available in this template)
     -- boot configuration --
     BOOTLD_USE   => BOOTLD_USE,       -- implement and use bootloader? (default=true)
     IMEM_AS_ROM  => IMEM_AS_ROM       -- implement IMEM as read-only memory? (default=false)
@@ -162,6 +193,7 @@ begin
   port map (
     -- global control --
     clk_i      => clk_i_int,          -- global clock, rising edge
+    clk_io_i   => clk_i_int,          -- peripheral clock, same as global clock
     rst_i      => rst_i_int,          -- global reset, async, low-active
     -- parallel io --
     gpio_o     => gpio_o_int,         -- parallel output
@@ -177,6 +209,7 @@ begin
     spi_mosi_o => spi_mosi_o_int,     -- serial data line out
     spi_miso_i => spi_miso_i_int,     -- serial data line in
     spi_cs_o   => spi_cs_o_int,       -- SPI CS 0..7
+    spi_dq_io  => spi_dq_io,          -- SPI dual/quad data lines IO0..IO3
     twi_sda_io => twi_sda_io,         -- twi serial data line
     twi_scl_io => twi_scl_io,         -- twi serial clock line
     -- 32-bit wishbone interface --
@@ -188,6 +221,23 @@ begin
     wb_stb_o   => wb_stb_o_int,       -- strobe
     wb_cyc_o   => wb_cyc_o_int,       -- valid cycle
     wb_ack_i   => wb_ack_i_int,       -- transfer acknowledge
+    -- 16-bit wishbone slave interface --
+    wbs_adr_i  => wbs_adr_i_int,      -- address
+    wbs_dat_i  => wbs_dat_i_int,      -- write data
+    wbs_dat_o  => wbs_dat_o_int,      -- read data
+    wbs_we_i   => wbs_we_i_int,       -- read/write
+    wbs_sel_i  => wbs_sel_i_int,      -- byte enable
+    wbs_stb_i  => wbs_stb_i_int,      -- strobe
+    wbs_cyc_i  => wbs_cyc_i_int,      -- valid cycle
+    wbs_ack_o  => wbs_ack_o_int,      -- transfer acknowledge
+    wbs_irq_o  => wbs_irq_o_int,      -- doorbell interrupt to host
+    -- inter-core mailbox interface --
+    mbox_rd_o  => open,               -- read enable
+    mbox_wr_o  => open,               -- write enable
+    mbox_adr_o => open,               -- register (word) address
+    mbox_dat_o => open,               -- write data
+    mbox_dat_i => x"0000",            -- read data
+    mbox_irq_i => '0',                -- mailbox interrupt
     -- interrupts --
     ext_irq_i  => irq_i_int,          -- external interrupt request line
     ext_ack_o  => irq_ack_o_int       -- external interrupt request acknowledge
@@ -203,6 +253,12 @@ begin
   spi_miso_i_int <= std_ulogic(spi_miso_i);
   wb_dat_i_int   <= std_ulogic_vector(wb_dat_i);
   wb_ack_i_int   <= std_ulogic(wb_ack_i);
+  wbs_adr_i_int  <= std_ulogic_vector(wbs_adr_i);
+  wbs_dat_i_int  <= std_ulogic_vector(wbs_dat_i);
+  wbs_we_i_int   <= std_ulogic(wbs_we_i);
+  wbs_sel_i_int  <= std_ulogic_vector(wbs_sel_i);
+  wbs_stb_i_int  <= std_ulogic(wbs_stb_i);
+  wbs_cyc_i_int  <= std_ulogic(wbs_cyc_i);
   irq_i_int      <= std_ulogic_vector(ext_irq_i);
 
   gpio_o         <= std_logic_vector(gpio_o_int);
@@ -217,6 +273,9 @@ begin
   wb_sel_o       <= std_logic_vector(wb_sel_o_int);
   wb_stb_o       <= std_logic(wb_stb_o_int);
   wb_cyc_o       <= std_logic(wb_cyc_o_int);
+  wbs_dat_o      <= std_logic_vector(wbs_dat_o_int);
+  wbs_ack_o      <= std_logic(wbs_ack_o_int);
+  wbs_irq_o      <= std_logic(wbs_irq_o_int);
   ext_ack_o      <= std_logic_vector(irq_ack_o_int);
   freq_gen_o     <= std_logic_vector(freq_gen_o_int);
 
@@ -19,6 +19,10 @@ ghdl -a --work=neo430 $srcdir_core/neo430_application_image.vhd
 ghdl -a --work=neo430 $srcdir_core/neo430_bootloader_image.vhd
 ghdl -a --work=neo430 $srcdir_core/neo430_addr_gen.vhd
 ghdl -a --work=neo430 $srcdir_core/neo430_alu.vhd
+ghdl -a --work=neo430 $srcdir_core/neo430_bmu.vhd
+ghdl -a --work=neo430 $srcdir_core/neo430_wb_slave.vhd
+ghdl -a --work=neo430 $srcdir_core/neo430_mailbox.vhd
+ghdl -a --work=neo430 $srcdir_core/neo430_xmem.vhd
 ghdl -a --work=neo430 $srcdir_core/neo430_boot_rom.vhd
 ghdl -a --work=neo430 $srcdir_core/neo430_cfu.vhd
 ghdl -a --work=neo430 $srcdir_core/neo430_control.vhd
@@ -29,6 +33,7 @@ ghdl -a --work=neo430 $srcdir_core/neo430_exirq.vhd
 ghdl -a --work=neo430 $srcdir_core/neo430_freq_gen.vhd
 ghdl -a --work=neo430 $srcdir_core/neo430_gpio.vhd
 ghdl -a --work=neo430 $srcdir_core/neo430_imem.vhd
+ghdl -a --work=neo430 $srcdir_core/neo430_io_bridge.vhd
 ghdl -a --work=neo430 $srcdir_core/neo430_muldiv.vhd
 ghdl -a --work=neo430 $srcdir_core/neo430_pwm.vhd
 ghdl -a --work=neo430 $srcdir_core/neo430_reg_file.vhd
@@ -44,9 +49,13 @@ ghdl -a --work=neo430 $srcdir_core/neo430_wdt.vhd
 
 ghdl -a --work=neo430 $srcdir_top_templates/*.vhd $srcdir_sim/*.vhd
 
-# Elaborate top entity
+# Elaborate top entity and multi-core cluster testbench
 ghdl -e --work=neo430 neo430_top
+ghdl -e --work=neo430 neo430_cluster_tb
 
 # Run simulation
 ghdl -e --work=neo430 neo430_tb
 ghdl -r --work=neo430 neo430_tb --stop-time=20ms --ieee-asserts=disable-at-0 --assert-level=error
+
+# Run simulation again with separate peripheral clock (IO clock domain bridge)
+ghdl -r --work=neo430 neo430_tb -gIO_CLK_SEPARATE=true --stop-time=20ms --ieee-asserts=disable-at-0 --assert-level=error
@@ -0,0 +1,193 @@
+-- #################################################################################################
+-- # << NEO430 - Multi-core cluster testbench >>                                                   #
+-- # ********************************************************************************************* #
+-- # Instantiates the multi-core cluster (rtl/top_templates/neo430_cluster.vhd) with NUM_CORES     #
+-- # cores (set via the generic, e.g. ghdl -r neo430_cluster_tb -gNUM_CORES=4). All cores execute  #
+-- # the same application image (e.g. sw/example/mailbox_test or sw/example/prime_cluster); data   #
+-- # sent via the UART of core 0 is written to neo430_cluster.uart_tx.txt, the cycles while core 0 #
+-- # sets gpio_o(15) are written to neo430_cluster.benchmark.txt.                                  #
+-- # ********************************************************************************************* #
+-- # BSD 3-Clause License                                                                          #
+-- #                                                                                               #
+-- # Copyright (c) 2020, Stephan Nolting. All rights reserved.                                     #
+-- #                                                                                               #
+-- # Redistribution and use in source and binary forms, with or without modification, are          #
+-- # permitted provided that the following conditions are met:                                     #
+-- #                                                                                               #
+-- # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+-- #    conditions and the following disclaimer.                                                   #
+-- #                                                                                               #
+-- # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+-- #    conditions and the following disclaimer in the documentation and/or other materials        #
+-- #    provided with the distribution.                                                            #
+-- #                                                                                               #
+-- # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+-- #    endorse or promote products derived from this software without specific prior written      #
+-- #    permission.                                                                                #
+-- #                                                                                               #
+-- # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+-- # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+-- # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+-- # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+-- # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+-- # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+-- # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+-- # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+-- # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+-- # ********************************************************************************************* #
+-- # The NEO430 Processor - https://github.com/stnolting/neo430                                    #
+-- #################################################################################################
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+use ieee.math_real.all;
+
+library neo430;
+use neo430.neo430_package.all;
+use std.textio.all;
+
+entity neo430_cluster_tb is
+  generic (
+    NUM_CORES : natural := 2 -- number of processor cores (1..8)
+  );
+end neo430_cluster_tb;
+
+architecture neo430_cluster_tb_rtl of neo430_cluster_tb is
+
+  -- User Configuration ---------------------------------------------------------------------
+  -- -------------------------------------------------------------------------------------------
+  constant t_clock_c   : time := 10 ns; -- main clock period
+  constant f_clock_c   : real := 100000000.0; -- main clock in Hz
+  constant baud_rate_c : real := 19200.0; -- standard UART baudrate
+  -- -------------------------------------------------------------------------------------------
+
+  -- textio --
+  file file_uart_tx_out : text open write_mode is "neo430_cluster.uart_tx.txt";
+  file file_bench_out   : text open write_mode is "neo430_cluster.benchmark.txt";
+
+  -- internal configuration --
+  constant baud_val_c : real    := f_clock_c / baud_rate_c;
+  constant f_clk_c    : natural := natural(f_clock_c);
+
+  -- generators --
+  signal clk_gen, rst_gen : std_ulogic := '0';
+
+  -- cluster io (core 0) --
+  signal uart_txd : std_ulogic;
+  signal gpio_out : std_ulogic_vector(15 downto 0);
+
+  -- benchmark timer --
+  signal bench_ff  : std_ulogic := '0';
+  signal bench_cnt : natural := 0;
+
+  -- simulation uart receiver --
+  signal uart_rx_sync     : std_ulogic_vector(04 downto 0) := (others => '1');
+  signal uart_rx_busy     : std_ulogic := '0';
+  signal uart_rx_sreg     : std_ulogic_vector(08 downto 0) := (others => '0');
+  signal uart_rx_baud_cnt : real;
+  signal uart_rx_bitcnt   : natural;
+
+begin
+
+  -- Clock/Reset Generator ----------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  clk_gen <= not clk_gen after (t_clock_c/2);
+  rst_gen <= '0', '1' after 60*(t_clock_c/2);
+
+
+  -- Processor Cluster --------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  neo430_cluster_inst: entity neo430.neo430_cluster
+  generic map (
+    -- general configuration --
+    CLOCK_SPEED => f_clk_c,             -- main clock in Hz
+    NUM_CORES   => NUM_CORES,           -- number of processor cores (1..8)
+    IMEM_SIZE   => 16*1024,             -- private IMEM size of each core in bytes
+    DMEM_SIZE   => 2*1024,              -- private DMEM size of each core in bytes
+    SHMEM_SIZE  => 4*1024,              -- shared memory size in bytes
+    -- additional configuration --
+    USER_CODE   => x"4788",             -- custom user code
+    -- boot configuration --
+    BOOTLD_USE  => false                -- implement and use bootloader?
+  )
+  port map (
+    -- global control --
+    clk_i      => clk_gen,              -- global clock, rising edge
+    rst_i      => rst_gen,              -- global reset, async, low-active
+    -- parallel io (core 0) --
+    gpio_o     => gpio_out,             -- parallel output
+    gpio_i     => x"0000",              -- parallel input
+    -- serial com (core 0) --
+    uart_txd_o => uart_txd,             -- UART send data
+    uart_rxd_i => '1'                   -- UART receive data
+  );
+
+
+  -- Benchmark Timer ----------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  -- counts the cycles while core 0 sets gpio_out(15) (see sw/example/prime_cluster) --
+  bench_timer: process(clk_gen)
+    variable line_tmp : line;
+  begin
+    if rising_edge(clk_gen) then
+      bench_ff <= gpio_out(15);
+      if (gpio_out(15) = '1') then
+        if (bench_ff = '0') then
+          bench_cnt <= 0;
+        else
+          bench_cnt <= bench_cnt + 1;
+        end if;
+      elsif (bench_ff = '1') then -- done
+        write(line_tmp, string'("Cluster benchmark (") & integer'image(NUM_CORES) & " cores): " & integer'image(bench_cnt+1) & " cycles");
+        writeline(file_bench_out, line_tmp);
+        report "Cluster benchmark (" & integer'image(NUM_CORES) & " cores): " & integer'image(bench_cnt+1) & " cycles";
+      end if;
+    end if;
+  end process bench_timer;
+
+
+  -- Console UART Receiver (core 0) -------------------------------------------
+  -- -----------------------------------------------------------------------------
+  uart_rx_unit: process(clk_gen)
+    variable i        : integer;
+    variable line_tmp : line;
+  begin
+    if rising_edge(clk_gen) then
+      -- synchronizer --
+      uart_rx_sync <= uart_rx_sync(3 downto 0) & uart_txd;
+      -- arbiter --
+      if (uart_rx_busy = '0') then -- idle
+        uart_rx_baud_cnt <= round(0.5 * baud_val_c);
+        uart_rx_bitcnt   <= 9;
+        if (uart_rx_sync(4 downto 1) = "1100") then -- start bit? (falling edge)
+          uart_rx_busy <= '1';
+        end if;
+      else
+        if (uart_rx_baud_cnt = 0.0) then
+          if (uart_rx_bitcnt = 1) then
+            uart_rx_baud_cnt <= round(0.5 * baud_val_c);
+          else
+            uart_rx_baud_cnt <= round(baud_val_c);
+          end if;
+          if (uart_rx_bitcnt = 0) then
+            uart_rx_busy <= '0'; -- done
+            i := to_integer(unsigned(uart_rx_sreg(8 downto 1)));
+            if (i = 10) then -- Linux line break
+              writeline(file_uart_tx_out, line_tmp);
+            elsif (i >= 32) and (i < 127) then -- printable characters only
+              write(line_tmp, character'val(i));
+            end if;
+          else
+            uart_rx_sreg   <= uart_rx_sync(4) & uart_rx_sreg(8 downto 1);
+            uart_rx_bitcnt <= uart_rx_bitcnt - 1;
+          end if;
+        else
+          uart_rx_baud_cnt <= uart_rx_baud_cnt - 1.0;
+        end if;
+      end if;
+    end if;
+  end process uart_rx_unit;
+
+
+end neo430_cluster_tb_rtl;
@@ -3,6 +3,9 @@
 -- # ********************************************************************************************* #
 -- # This simple testbench instantiates the top entity of the NEO430 processors, generates clock   #
 -- # and reset signals and outputs data send via the processor's UART to the simulator console.    #
+-- # Set IO_CLK_SEPARATE (e.g. ghdl -r neo430_tb -gIO_CLK_SEPARATE=true) to run the peripheral     #
+-- # devices from a separate, asynchronous 75MHz clock (IO clock domain bridge). Set FAST_BOOT to  #
+-- # start the application (IMEM as ROM) via a boot ROM image built with fast boot enabled.        #
 -- # ********************************************************************************************* #
 -- # BSD 3-Clause License                                                                          #
 -- #                                                                                               #
@@ -45,6 +48,10 @@ use neo430.neo430_package.all;
 use std.textio.all;
 
 entity neo430_tb is
+  generic (
+    IO_CLK_SEPARATE : boolean := false; -- use separate peripheral clock (default=false)
+    FAST_BOOT       : boolean := false  -- boot via bootloader (fast boot from IMEM as ROM, default=false)
+  );
 end neo430_tb;
 
 architecture neo430_tb_rtl of neo430_tb is
@@ -54,14 +61,20 @@ architecture neo430_tb_rtl of neo430_tb is
   constant t_clock_c   : time := 10 ns; -- main clock period
   constant f_clock_c   : real := 100000000.0; -- main clock in Hz
   constant baud_rate_c : real := 19200.0; -- standard UART baudrate
+  constant t_clock_io_c : time := 13333 ps; -- peripheral clock period (if IO_CLK_SEPARATE = true)
+  constant f_clock_io_c : natural := 75000000; -- peripheral clock in Hz (if IO_CLK_SEPARATE = true)
+  constant lat_trials_c : natural := 32; -- number of IRQ latency measurements per benchmark phase
   -- -------------------------------------------------------------------------------------------
 
   -- textio --
-  file file_uart_tx_out : text open write_mode is "neo430.uart_tx.txt";
+  file file_uart_tx_out  : text open write_mode is "neo430.uart_tx.txt";
+  file file_irq_lat_out  : text open write_mode is "neo430.irq_latency.txt";
+  file file_startup_out  : text open write_mode is "neo430.startup.txt";
 
   -- internal configuration --
   constant baud_val_c : real    := f_clock_c / baud_rate_c;
   constant f_clk_c    : natural := natural(f_clock_c);
+  constant f_clk_io_c : natural := cond_sel_natural_f(IO_CLK_SEPARATE, f_clock_io_c, 0);
 
   -- reduced ASCII table --
   type ascii_t is array (0 to 94) of character;
@@ -73,11 +86,35 @@ architecture neo430_tb_rtl of neo430_tb is
 
   -- generators --
   signal clk_gen, rst_gen : std_ulogic := '0';
+  signal clk_io_gen       : std_ulogic := '0';
   signal irq, irq_ack     : std_ulogic_vector(7 downto 0);
 
   -- local signals --
   signal uart_txd : std_ulogic;
   signal spi_data : std_ulogic;
+  signal gpio_out : std_ulogic_vector(15 downto 0);
+  signal gpio_in  : std_ulogic_vector(15 downto 0) := (others => '0');
+  signal irq_all  : std_ulogic_vector(7 downto 0);
+
+  -- irq latency benchmark --
+  -- protocol (see sw/example/irq_latency): gpio_out(14:12) = benchmark phase (0 = inactive),
+  -- gpio_out(11) = marker, set by the first instruction of the ISR, cleared by the main program
+  type lat_state_t is (LAT_IDLE, LAT_WAIT, LAT_MEASURE);
+  signal lat_state  : lat_state_t := LAT_IDLE;
+  signal lat_phase  : std_ulogic_vector(2 downto 0) := "000";
+  signal lat_lfsr   : std_ulogic_vector(7 downto 0) := x"A5";
+  signal lat_delay  : natural;
+  signal lat_cnt    : natural;
+  signal lat_trials : natural;
+  signal lat_min    : natural;
+  signal lat_max    : natural;
+  signal lat_sum    : natural;
+  signal irq_lat    : std_ulogic_vector(7 downto 0) := (others => '0');
+
+  -- startup benchmark --
+  -- protocol (application built with NEO430_CRT0_SIM_MARKER=1): crt0 pulses gpio_out(15) right before calling main
+  signal startup_cnt  : natural := 0;
+  signal startup_done : boolean := false;
 
   -- simulation uart receiver --
   signal uart_rx_sync     : std_ulogic_vector(04 downto 0) := (others => '1');
@@ -95,6 +132,7 @@ begin
   -- Clock/Reset Generator ----------------------------------------------------
   -- -----------------------------------------------------------------------------
   clk_gen <= not clk_gen after (t_clock_c/2);
+  clk_io_gen <= not clk_io_gen after (t_clock_io_c/2); -- only used if IO_CLK_SEPARATE = true
   rst_gen <= '0', '1' after 60*(t_clock_c/2);
 
 
@@ -104,8 +142,12 @@ begin
   generic map (
     -- general configuration --
     CLOCK_SPEED  => f_clk_c,          -- main clock in Hz
+    IO_CLK_SPEED => f_clk_io_c,       -- peripheral clock in Hz, 0 = same as main clock (default=0)
     IMEM_SIZE    => 4*1024,           -- internal IMEM size in bytes, max 48kB (default=4kB)
     DMEM_SIZE    => 2*1024,           -- internal DMEM size in bytes, max 12kB (default=2kB)
+    IMEM_WAIT    => 0,                -- wait states for each IMEM access (default=0)
+    DMEM_WAIT    => 0,                -- wait states for each DMEM access (default=0)
+    XMEM_SIZE    => 0,                -- banked far memory size in bytes, 0 = none, 16kB..1MB (default=0)
     -- additional configuration --
     USER_CODE    => x"4788",          -- custom user code
     -- module configuration --
@@ -123,17 +165,21 @@ begin
     TRNG_USE     => false,            -- implement TRNG? (default=false) - CANNOT BE SIMULATED!
     EXIRQ_USE    => true,             -- implement EXIRQ? (default=true)
     FREQ_GEN_USE => true,             -- implement FREQ_GEN? (default=true)
+    BMU_USE      => true,             -- implement BMU? (default=false)
+    WBS_USE      => false,            -- implement wishbone slave port? (default=false)
+    MBOX_USE     => false,            -- implement inter-core mailbox port? (default=false)
     -- boot configuration --
-    BOOTLD_USE   => false,            -- implement and use bootloader? (default=true)
-    IMEM_AS_ROM  => false             -- implement IMEM as read-only memory? (default=false)
+    BOOTLD_USE   => FAST_BOOT,        -- implement and use bootloader? (default=true)
+    IMEM_AS_ROM  => FAST_BOOT         -- implement IMEM as read-only memory? (default=false)
   )
   port map (
     -- global control --
     clk_i      => clk_gen,            -- global clock, rising edge
+    clk_io_i   => clk_io_gen,         -- peripheral clock (ignored if IO_CLK_SPEED = 0)
     rst_i      => rst_gen,            -- global reset, async, low-active
     -- gpio --
-    gpio_o     => open,               -- parallel output
-    gpio_i     => x"0000",            -- parallel input
+    gpio_o     => gpio_out,           -- parallel output
+    gpio_i     => gpio_in,            -- parallel input
     -- pwm channels --
     pwm_o      => open,               -- pwm channels
     -- arbitrary frequency generator --
@@ -145,6 +191,7 @@ begin
     spi_mosi_o => spi_data,           -- serial data line out
     spi_miso_i => spi_data,           -- serial data line in
     spi_cs_o   => open,               -- SPI CS 0..5
+    spi_dq_io  => open,               -- SPI dual/quad data lines IO0..IO3
     twi_sda_io => twi_sda,            -- twi serial data line
     twi_scl_io => twi_scl,            -- twi serial clock line
     -- 32-bit wishbone interface --
@@ -156,8 +203,25 @@ begin
     wb_stb_o   => open,               -- strobe
     wb_cyc_o   => open,               -- valid cycle
     wb_ack_i   => '0',                -- transfer acknowledge
+    -- 16-bit wishbone slave interface --
+    wbs_adr_i  => x"0000",            -- address
+    wbs_dat_i  => x"0000",            -- write data
+    wbs_dat_o  => open,               -- read data
+    wbs_we_i   => '0',                -- read/write
+    wbs_sel_i  => "00",               -- byte enable
+    wbs_stb_i  => '0',                -- strobe
+    wbs_cyc_i  => '0',                -- valid cycle
+    wbs_ack_o  => open,               -- transfer acknowledge
+    wbs_irq_o  => open,               -- doorbell interrupt to host
+    -- inter-core mailbox interface --
+    mbox_rd_o  => open,               -- read enable
+    mbox_wr_o  => open,               -- write enable
+    mbox_adr_o => open,               -- register (word) address
+    mbox_dat_o => open,               -- write data
+    mbox_dat_i => x"0000",            -- read data
+    mbox_irq_i => '0',                -- mailbox interrupt
     -- external interrupts --
-    ext_irq_i  => irq,                -- external interrupt request lines
+    ext_irq_i  => irq_all,            -- external interrupt request lines
     ext_ack_o  => irq_ack             -- external interrupt request acknowledges
   );
 
@@ -178,6 +242,106 @@ begin
     wait;
   end process interrupt_gen;
 
+  irq_all <= irq or irq_lat;
+
+
+  -- Interrupt Latency Benchmark ----------------------------------------------
+  -- -----------------------------------------------------------------------------
+  -- Injects GPIO pin changes (phase 1) or EXIRQ channel 0 requests (phase 2, 3) at pseudo-random
+  -- points in time and measures the cycles until the ISR sets the marker output.
+  irq_latency: process(clk_gen)
+    variable line_tmp : line;
+    variable min_v, max_v, sum_v : natural;
+  begin
+    if rising_edge(clk_gen) then
+      lat_lfsr <= lat_lfsr(6 downto 0) & (lat_lfsr(7) xor lat_lfsr(5) xor lat_lfsr(4) xor lat_lfsr(3));
+      irq_lat  <= (others => '0');
+
+      -- new benchmark phase --
+      if (gpio_out(14 downto 12) /= lat_phase) then
+        lat_phase  <= gpio_out(14 downto 12);
+        lat_state  <= LAT_IDLE;
+        lat_trials <= 0;
+        lat_min    <= natural'high;
+        lat_max    <= 0;
+        lat_sum    <= 0;
+      else
+        case lat_state is
+
+          when LAT_IDLE => -- wait for main program to clear the marker
+            if (lat_phase /= "000") and (gpio_out(11) = '0') and (lat_trials < lat_trials_c) then
+              lat_delay <= to_integer(unsigned(lat_lfsr(5 downto 0))); -- 0..63 cycles
+              lat_state <= LAT_WAIT;
+            end if;
+
+          when LAT_WAIT => -- random delay, then trigger interrupt source
+            if (lat_delay = 0) then
+              if (lat_phase = "001") then
+                gpio_in(0) <= not gpio_in(0); -- GPIO pin change
+              else
+                irq_lat(0) <= '1'; -- EXIRQ channel 0
+              end if;
+              lat_cnt   <= 0;
+              lat_state <= LAT_MEASURE;
+            else
+              lat_delay <= lat_delay - 1;
+            end if;
+
+          when LAT_MEASURE => -- count cycles until ISR marker
+            if (gpio_out(11) = '1') then
+              min_v := lat_min;
+              max_v := lat_max;
+              sum_v := lat_sum + lat_cnt;
+              if (lat_cnt < min_v) then
+                min_v := lat_cnt;
+              end if;
+              if (lat_cnt > max_v) then
+                max_v := lat_cnt;
+              end if;
+              lat_trials <= lat_trials + 1;
+              lat_min    <= min_v;
+              lat_max    <= max_v;
+              lat_sum    <= sum_v;
+              if (lat_trials = lat_trials_c-1) then -- phase done, log results
+                write(line_tmp, string'("IRQ latency phase ") & integer'image(to_integer(unsigned(lat_phase))) &
+                                " (" & integer'image(lat_trials_c) & " trials): min=" & integer'image(min_v) &
+                                " avg=" & integer'image(sum_v / lat_trials_c) & " max=" & integer'image(max_v) & " cycles");
+                writeline(file_irq_lat_out, line_tmp);
+                report "IRQ latency phase " & integer'image(to_integer(unsigned(lat_phase))) & " done";
+              end if;
+              lat_state <= LAT_IDLE;
+            else
+              lat_cnt <= lat_cnt + 1;
+            end if;
+
+        end case;
+      end if;
+    end if;
+  end process irq_latency;
+
+
+  -- Startup Benchmark --------------------------------------------------------
+  -- -----------------------------------------------------------------------------
+  -- Counts the cycles from reset release until crt0 calls main (simulation marker: first pulse on gpio_out(15),
+  -- not used by the IRQ latency benchmark), including the bootloader if FAST_BOOT = true. Only reported if the
+  -- application was built with the marker.
+  startup_benchmark: process(clk_gen)
+    variable line_tmp : line;
+  begin
+    if rising_edge(clk_gen) then
+      if (rst_gen = '1') and (startup_done = false) then
+        if (gpio_out(15) = '1') then
+          write(line_tmp, string'("Cycles from reset to main: ") & integer'image(startup_cnt));
+          writeline(file_startup_out, line_tmp);
+          report "Cycles from reset to main: " & integer'image(startup_cnt);
+          startup_done <= true;
+        else
+          startup_cnt <= startup_cnt + 1;
+        end if;
+      end if;
+    end if;
+  end process startup_benchmark;
+
 
   -- Console UART Receiver ----------------------------------------------------
   -- -----------------------------------------------------------------------------
@@ -54,11 +54,25 @@
 #define AUTOBOOT_TIMEOUT 4     // countdown (seconds) to auto boot
 #define STATUS_LED       0     // GPIO.out(0) is status LED
 
+// Fast boot configuration: boot image from SPI flash right after reset - no UART, no banner, no countdown
+// If no valid image is found the bootloader continues with the normal boot sequence (console)
+// FAST_BOOT_EN/FORCE can also be set via the makefile, e.g. make CC_USER_FLAGS="-DFAST_BOOT_EN=1" all
+#ifndef FAST_BOOT_EN
+#define FAST_BOOT_EN     0     // 1: fast boot available (opt-in), 0: always use normal boot sequence
+#endif
+#ifndef FAST_BOOT_FORCE
+#define FAST_BOOT_FORCE  0     // 1: always fast boot, 0: fast boot only if strap pin is high
+#endif
+#define FAST_BOOT_PIN    15    // GPIO.in(15) is fast boot strap pin (tie to '1'/'0' for a fixed setup)
+
 // SPI flash hardware configuration
 #define SPI_FLASH_CS     0
+#define SPI_FLASH_QUAD   0 // 1: flash IO0..IO3 connected to spi_dq_io, use quad-output fast read for image loading (opt-in)
+                           // 0: flash connected to spi_mosi_o/spi_miso_i, use standard read
 
 // SPI flash commands
 #define SPI_FLASH_CMD_READ           0x03
+#define SPI_FLASH_CMD_FAST_READ_QUAD 0x6B
 #define SPI_FLASH_CMD_READ_STATUS    0x05
 #define SPI_FLASH_CMD_WRITE_ENABLE   0x06
 #define SPI_FLASH_CMD_PAGE_PROGRAM   0x02
@@ -84,20 +98,24 @@
 // Macros
 #define xstr(a) str(a)
 #define str(a) #a
-#define SPI_FLASH_SEL {SPI_CT |= 1 << (SPI_FLASH_CS+SPI_CT_CS_SEL0);}
+#define SPI_FLASH_SEL {BITBAND(SPI_CT, SPI_FLASH_CS+SPI_CT_CS_SEL0) = 1;}
+#define SPI_FLASH_QCT (SPI_FLASH_QUAD << SPI_QCT_DQ_EN) // default data line configuration
 
 // Function prototypes
 void     __attribute__((__interrupt__)) timer_irq_handler(void);
 void     __attribute__((__naked__)) start_app(void);
+void     __attribute__((__naked__)) launch_app(void);
 void     print_help(void);
 void     store_eeprom(void);
 void     eeprom_write_word(uint32_t a, uint16_t d);
 void     get_image(uint8_t src);
-uint16_t get_image_word(uint32_t a, uint8_t src);
+uint8_t  load_image(uint8_t src);
+uint16_t get_image_word(uint8_t src);
 void     __attribute__((__naked__)) system_error(uint8_t err_code);
 
 // Function prototypes - SPI flash
-uint8_t spi_flash_read_byte();
+void    spi_flash_read_start(uint32_t adr);
+void    spi_flash_read_stop(void);
 void    spi_flash_write_byte(uint32_t adr, uint8_t data);
 void    spi_flash_erase_sector(uint32_t base_adr);
 uint8_t spi_flash_read_status(void);
@@ -151,20 +169,45 @@ int main(void) {
 //IRQVEC_EXT    = 0; // unused
 //IRQVEC_SERIAL = 0; // unused
 
+  // set SPI config:
+  // enable SPI, no IRQ, MSB first, 8-bit mode, SPI clock mode 0, set SPI speed, disable all SPI CS lines (set high)
+  neo430_spi_enable(SPI_PRSC_8); // this also resets the SPI module
+#if (SPI_FLASH_QUAD != 0)
+  SPI_QCT = SPI_FLASH_QCT; // select flash data lines
+#endif
+
+
+  // ****************************************************************
+  // Fast boot: load and start image from SPI flash without any console output
+  // ****************************************************************
+#if (FAST_BOOT_EN != 0)
+  if ((FAST_BOOT_FORCE != 0) || ((GPIO_IN & (1<<FAST_BOOT_PIN)) != 0)) {
+    if ((SYS_FEATURES & (1<<SYS_IROM_EN)) != 0) { // application is already in IMEM
+      launch_app();
+    }
+    spi_flash_write_cmd((uint16_t)SPI_FLASH_CMD_RELEASE); // get SPI flash out of power down mode
+    register uint16_t i;
+    for (i=CLOCKSPEED_HI; i!=0; i--) { // wait ~100us (independent of clock speed) for flash wake-up
+      asm volatile ("nop");
+    }
+    spi_flash_read_start(SPI_FLASH_BOOT_ADR);
+    if (load_image(EEPROM_IMAGE_SPI) == 0) {
+      launch_app();
+    }
+    // no valid image: continue with normal boot sequence
+  }
+#endif
+
   // set Baud rate & init UART control register:
   // enable UART, no IRQs
   neo430_uart_setup(BAUD_RATE);
   neo430_uart_char_read(); // clear UART RX buffer
 
-  // set SPI config:
-  // enable SPI, no IRQ, MSB first, 8-bit mode, SPI clock mode 0, set SPI speed, disable all SPI CS lines (set high)
-  neo430_spi_enable(SPI_PRSC_8); // this also resets the SPI module
-
   // Timeout counter: init timer, irq tick @ ~1Hz (prescaler = 4096)
-  // THR = f_main / (1Hz + 4096) -1
+  // THR = f_io / (1Hz + 4096) -1
   TMR_CT = 0; // reset timer
   //uint32_t clock = CLOCKSPEED_32bit >> 14; // divide by 4096
-  TMR_THRES = (CLOCKSPEED_HI << 2) -1; // "fake" ;D
+  TMR_THRES = (IOCLOCKSPEED_HI << 2) -1; // "fake" ;D
   // enable timer, auto reset, enable IRQ, prsc = 1:2^16, start timer
   TMR_CT = (1<<TMR_CT_EN) | (1<<TMR_CT_ARST) | (1<<TMR_CT_IRQ) | ((16-1)<<TMR_CT_PRSC0) | (1<<TMR_CT_RUN);
   TIMEOUT_CNT = 0; // console timeout ticker
@@ -266,14 +309,24 @@ void __attribute__((__interrupt__)) timer_irq_handler(void) {
  * ------------------------------------------------------------ */
 void __attribute__((__naked__)) start_app(void) {
 
-  // put SPI flah into power-down mode
-  spi_flash_write_cmd((uint16_t)SPI_FLASH_CMD_POWER_DOWN);
-
   neo430_uart_br_print("Booting...\n\n");
 
   // wait for UART to finish transmitting
   while ((UART_CT & (1<<UART_CT_TX_BUSY)) != 0);
 
+  launch_app();
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Start application in IMEM without any console output
+ * INFO "naked" since this is final...
+ * ------------------------------------------------------------ */
+void __attribute__((__naked__)) launch_app(void) {
+
+  // put SPI flah into power-down mode
+  spi_flash_write_cmd((uint16_t)SPI_FLASH_CMD_POWER_DOWN);
+
   // deactivate IRQs, no more write access to IMEM, clear all pending IRQs
   asm volatile ("mov %0, r2" : : "i" (1<<Q_FLAG));
 
@@ -357,7 +410,6 @@ void eeprom_write_word(uint32_t a, uint16_t d) {
 /* ------------------------------------------------------------
  * INFO Get IMEM image from SPI EEPROM at SPI.CS0 or from UART
  * PARAM src Image source 0: UART, 1: SPI_EEPROM
- * RETURN error code (0 if successful)
  * ------------------------------------------------------------ */
 void get_image(uint8_t src) {
 
@@ -372,64 +424,85 @@ void get_image(uint8_t src) {
   }
   else { //if (src == EEPROM_IMAGE_SPI)// boot from EEPROM
     neo430_uart_br_print("Loading...");
+    spi_flash_read_start(SPI_FLASH_BOOT_ADR); // image is read as one continuous stream
   }
 
-  // check if valid image
-  if (get_image_word(SPI_FLASH_BOOT_ADR + 0, src) != 0xCAFE) { // signature
-    system_error(ERROR_EXECUTABLE);
+  // transfer and check image
+  uint8_t err = load_image(src);
+  if (err != 0) {
+    system_error(err);
   }
+  neo430_uart_br_print("OK");
+}
 
-  // image size and checksum
-  uint16_t size = get_image_word(SPI_FLASH_BOOT_ADR + 2, src); // size in bytes
-  uint16_t check = get_image_word(SPI_FLASH_BOOT_ADR + 4, src); // XOR checksum
-  uint16_t end = IMEM_SIZE;
-  if (size > end) {
-    system_error(ERROR_SIZE);
-  }
 
-  // transfer program data
-  uint16_t *pnt = (uint16_t*)0x0000;
-  uint16_t checksum = 0x0000;
-  uint16_t d = 0, i = 0;
-  while (i < size/2) { // in words
-    d = get_image_word(SPI_FLASH_BOOT_ADR + 2*i + 6, src);
-    checksum ^= d;
-    pnt[i++] = d;
-  }
+/* ------------------------------------------------------------
+ * INFO Transfer IMEM image from SPI EEPROM or UART (no console output)
+ * INFO SPI_EEPROM stream has to be started before, it is stopped in any case
+ * PARAM src Image source 0: UART, 1: SPI_EEPROM
+ * RETURN error code (0 if successful)
+ * ------------------------------------------------------------ */
+uint8_t load_image(uint8_t src) {
 
-  // clear rest of IMEM
-  while(i < end/2) { // in words
-    pnt[i++] = 0x0000;
-  }
+  uint8_t err = 0;
 
-  // error during transfer?
-  if (checksum == check) {
-    neo430_uart_br_print("OK");
+  // check if valid image
+  if (get_image_word(src) != 0xCAFE) { // signature
+    err = ERROR_EXECUTABLE;
   }
   else {
-    system_error(ERROR_CHECKSUM);
+    // image size and checksum
+    uint16_t size = get_image_word(src); // size in bytes
+    uint16_t check = get_image_word(src); // XOR checksum
+    uint16_t end = IMEM_SIZE;
+    if (size > end) {
+      err = ERROR_SIZE;
+    }
+    else {
+      // transfer program data
+      uint16_t *pnt = (uint16_t*)0x0000;
+      uint16_t checksum = 0x0000;
+      uint16_t d = 0, i = 0;
+      while (i < size/2) { // in words
+        d = get_image_word(src);
+        checksum ^= d;
+        pnt[i++] = d;
+      }
+
+      // clear rest of IMEM
+      while(i < end/2) { // in words
+        pnt[i++] = 0x0000;
+      }
+
+      // error during transfer?
+      if (checksum != check) {
+        err = ERROR_CHECKSUM;
+      }
+    }
   }
+
+  spi_flash_read_stop(); // end of stream
+  return err;
 }
 
 
 /* ------------------------------------------------------------
- * INFO Get image word from SPI_EEPROM or UART
- * PARAM a source address (24 bit effective)
+ * INFO Get next image word from SPI_EEPROM or UART
+ * INFO Reads are consecutive for both sources, SPI_EEPROM stream has to be started before
  * PARAM src: 0: UART, 1: SPI_EEPROM
  * RETURN accessed data word
  * ------------------------------------------------------------ */
-uint16_t get_image_word(uint32_t a, uint8_t src) {
+uint16_t get_image_word(uint8_t src) {
 
   uint8_t c0 = 0, c1 = 0;
 
-  // reads have to be consecutive when reading from the UART
   if (src == UART_IMAGE) { // get image data via UART
     c0 = (uint8_t)neo430_uart_getc();
     c1 = (uint8_t)neo430_uart_getc();
   }
-  else {// if (src == EEPROM_IMAGE_SPI) { // get image data from SPI EEPROM
-    c0 = spi_flash_read_byte(a+0);
-    c1 = spi_flash_read_byte(a+1);
+  else {// if (src == EEPROM_IMAGE_SPI) { // get image data from SPI EEPROM stream
+    c0 = (uint8_t)neo430_spi_trans(0);
+    c1 = (uint8_t)neo430_spi_trans(0);
   }
 
   //uint16_t r = (((uint16_t)c0) << 8) | (((uint16_t)c1) << 0);
@@ -462,9 +535,11 @@ void __attribute__((__naked__)) system_error(uint8_t err_code){
 // *************************************************************************************
 
 /* ------------------------------------------------------------
- * Read single byte from flash (24-bit adress)
+ * Start continuous read stream from flash (24-bit adress)
+ * Each following neo430_spi_trans(0) returns the next data byte
+ * Quad mode: 0x6B needs no QE bit on N25Q/MT25Q devices, other vendors may require it
  * ------------------------------------------------------------ */
-uint8_t spi_flash_read_byte(uint32_t adr) {
+void spi_flash_read_start(uint32_t adr) {
 
   uint16_t adr_lo;
   uint16_t adr_mi;
@@ -473,16 +548,31 @@ uint8_t spi_flash_read_byte(uint32_t adr) {
 
   SPI_FLASH_SEL;
 
+#if (SPI_FLASH_QUAD != 0)
+  neo430_spi_trans((uint16_t)SPI_FLASH_CMD_FAST_READ_QUAD);
+#else
   neo430_spi_trans((uint16_t)SPI_FLASH_CMD_READ);
+#endif
   // no masking required, SPI unit in 8 bit mode ignores upper 8 bits
   neo430_spi_trans(adr_hi);
   neo430_spi_trans(adr_mi);
   neo430_spi_trans(adr_lo);
-  uint16_t data = neo430_spi_trans(0);
+#if (SPI_FLASH_QUAD != 0)
+  neo430_spi_trans(0); // 8 dummy cycles
+  SPI_QCT = SPI_FLASH_QCT | (SPI_IO_QUAD_RD << SPI_QCT_MODE0); // data phase: 4 bits per SPI clock
+#endif
+}
 
-  neo430_spi_cs_dis();
 
-  return (uint8_t)data;
+/* ------------------------------------------------------------
+ * End read stream, back to single data line mode
+ * ------------------------------------------------------------ */
+void spi_flash_read_stop(void) {
+
+  neo430_spi_cs_dis();
+#if (SPI_FLASH_QUAD != 0)
+  SPI_QCT = SPI_FLASH_QCT;
+#endif
 }
 
 
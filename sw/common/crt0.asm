@@ -36,50 +36,53 @@
   .section .text
   .p2align 1,0
 
-
-__crt0_begin:
 ; -----------------------------------------------------------
-; Get required system info
+; Configuration (override via assembler option "--defsym")
 ; -----------------------------------------------------------
-    mov  #0xC000, r8 ; = DMEM (RAM) base address
-    mov  &0xFFFA, r1 ; = DMEM (RAM) size in byte
+; NEO430_CRT0_SIM_MARKER = 1: pulse GPIO output 15 right before main is called (simulation only,
+; used by the testbench to count the cycles from reset to main)
+.ifndef NEO430_CRT0_SIM_MARKER
+  .set NEO430_CRT0_SIM_MARKER, 0
+.endif
 
 
+__crt0_begin:
 ; -----------------------------------------------------------
 ; Minimal required hardware setup
 ; -----------------------------------------------------------
-    mov  #0, r2           ; clear status register & disable interrupts
-    add  r8, r1           ; r1 = stack pointer = end of RAM
-    sub  #2, r1           ; address of last entry of stack
-    mov  #0x4700, &0xFFB8 ; deactivate watchdog
+    mov  #0, r2             ; clear status register & disable interrupts
+    mov  &0xFFFA, r1        ; = DMEM (RAM) size in byte
+    add  #(0xC000-2), r1    ; stack pointer = address of last entry of stack (end of RAM)
+    mov  #0x4700, &0xFFB8   ; deactivate watchdog
 
 
 ; -----------------------------------------------------------
 ; Initialize all IO device registers (set to zero)
 ; -----------------------------------------------------------
-; This loop does not trigger any operations as the CTRL registers, which are located
-; at offset 0 of the according device, are set to zero resulting in disabling the
-; specific device.
-    mov  #0xFF80, r9 ; beginning of IO section
-__crt0_clr_io:
-      tst  r9 ; until the end -> wrap-around to 0
-      jeq  __crt0_clr_io_end
-      mov  #0, 0(r9) ; clear entry
-      incd r9
-      jmp  __crt0_clr_io
-__crt0_clr_io_end:
+; This does not trigger any operations as the CTRL registers, which are located
+; at offset 0 of the according device, are cleared first resulting in disabling the
+; specific device. Registers that trigger an operation on any write access are
+; skipped: XMEM data register (0xFF3E) and mailbox port message/semaphore/doorbell registers (0xFF74..0xFF7E).
+    mov  #0xFF00, r8
+    mov  #0xFF3E, r9
+    call #__crt0_clr
+    mov  #0xFF40, r8
+    mov  #0xFF74, r9
+    call #__crt0_clr
+    mov  #0xFF80, r8
+    mov  #0x0000, r9        ; until the end -> wrap-around to 0
+    call #__crt0_clr
 
 
 ; -----------------------------------------------------------
-; Clear complete DMEM (including .bss section)
+; Clear IRQ vectors (first 24 bytes of DMEM) and .bss section
 ; -----------------------------------------------------------
-__crt0_clr_dmem:
-      cmp  r8, r1 ; base address equal to end of RAM?
-      jeq  __crt0_clr_dmem_end
-      mov  #0, 0(r8) ; clear entry
-      incd r8
-      jmp  __crt0_clr_dmem
-__crt0_clr_dmem_end:
+    mov  #0xC000, r8
+    mov  #0xC018, r9
+    call #__crt0_clr
+    mov  #__bss_start, r8
+    mov  #__bss_end, r9
+    call #__crt0_clr
 
 
 ; -----------------------------------------------------------
@@ -88,15 +91,48 @@ __crt0_clr_dmem_end:
     mov  #__data_start_rom, r5
     mov  #__data_end_rom, r6
     mov  #__data_start, r7
-__crt0_cpy_data:
+    mov  r6, r10
+    sub  r5, r10            ; size in bytes
+    bit  #2, r10            ; odd number of words?
+    jz   __crt0_cpy_data_2
+      mov  @r5+, 0(r7)
+      incd r7
+__crt0_cpy_data_2:
+    bit  #4, r10            ; two more words?
+    jz   __crt0_cpy_data
+      mov  @r5+, 0(r7)
+      mov  @r5+, 2(r7)
+      add  #4, r7
+__crt0_cpy_data:            ; remaining size is a multiple of 8 bytes
       cmp  r5, r6
       jeq  __crt0_cpy_data_end
       mov  @r5+, 0(r7)
-      incd r7
+      mov  @r5+, 2(r7)
+      mov  @r5+, 4(r7)
+      mov  @r5+, 6(r7)
+      add  #8, r7
       jmp  __crt0_cpy_data
 __crt0_cpy_data_end:
 
 
+; -----------------------------------------------------------
+; Copy initialized .xmem_data section from ROM to far memory bank 0 (via XMEM far pointer)
+; -----------------------------------------------------------
+    mov  #__xmem_data_start_rom, r5
+    mov  #__xmem_data_end_rom, r6
+    cmp  r5, r6
+    jeq  __crt0_cpy_xmem_end
+    mov  #__xmem_data_start, r7
+    sub  #0x8000, r7        ; window address -> far address (bank 0)
+    mov  r7, &0xFF3A        ; XMEM_PTRLO
+    mov  #0, &0xFF3C        ; XMEM_PTRHI
+__crt0_cpy_xmem:
+      mov  @r5+, &0xFF3E    ; XMEM_DATA (far pointer += 2)
+      cmp  r5, r6
+      jne  __crt0_cpy_xmem
+__crt0_cpy_xmem_end:
+
+
 ; -----------------------------------------------------------
 ; Re-init SR and clear all pending IRQs from buffer
 ; -----------------------------------------------------------
@@ -104,20 +140,19 @@ __crt0_cpy_data_end:
 
 
 ; -----------------------------------------------------------
-; Initialize all remaining registers
+; Initialize main's arguments (all other registers are set up by the compiler)
+; -----------------------------------------------------------
+    mov  #0, r12 ; argc = 0
+    mov  #0, r13 ; argv = NULL
+
+
+; -----------------------------------------------------------
+; Simulation marker (only if NEO430_CRT0_SIM_MARKER = 1)
 ; -----------------------------------------------------------
-    mov  #0, r4
-;   mov  #0, r5 ; -- is already initialized
-;   mov  #0, r6 ; -- is already initialized
-;   mov  #0, r7 ; -- is already initialized
-;   mov  #0, r8 ; -- is already initialized
-;   mov  #0, r9 ; -- is already initialized
-    mov  #0, r10
-    mov  #0, r11
-    mov  #0, r12 ; set argc = 0
-    mov  #0, r13
-    mov  #0, r14
-    mov  #0, r15
+.if NEO430_CRT0_SIM_MARKER != 0
+    bis  #0x8000, &0xFFAC   ; GPIO output 15 = 1
+    bic  #0x8000, &0xFFAC   ; GPIO output 15 = 0
+.endif
 
 
 ; -----------------------------------------------------------
@@ -136,5 +171,35 @@ __crt0_this_is_the_end:
     mov  #(1<<4), r2 ; set CPU to sleep mode
     nop
 
+
+; -----------------------------------------------------------
+; Clear memory area [r8, r9) - unrolled, ascending order
+; r8: start address, r9: end address (word-aligned), modifies r8, r10
+; -----------------------------------------------------------
+__crt0_clr:
+    mov  r9, r10
+    sub  r8, r10            ; size in bytes
+    bit  #2, r10            ; odd number of words?
+    jz   __crt0_clr_2
+      mov  #0, 0(r8)
+      incd r8
+__crt0_clr_2:
+    bit  #4, r10            ; two more words?
+    jz   __crt0_clr_8
+      mov  #0, 0(r8)
+      mov  #0, 2(r8)
+      add  #4, r8
+__crt0_clr_8:               ; remaining size is a multiple of 8 bytes
+      cmp  r8, r9
+      jeq  __crt0_clr_end
+      mov  #0, 0(r8)
+      mov  #0, 2(r8)
+      mov  #0, 4(r8)
+      mov  #0, 6(r8)
+      add  #8, r8
+      jmp  __crt0_clr_8
+__crt0_clr_end:
+    ret
+
 .Lfe0:
     .size	__crt0_begin, .Lfe0-__crt0_begin
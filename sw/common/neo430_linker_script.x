@@ -36,10 +36,13 @@ OUTPUT_ARCH(msp430)
 
 
 /* Relevant address space layout */
+/* The first 24 bytes of DMEM are reserved for the CPU IRQ vectors and the EXIRQ vector table */
+/* xmem: window to one 16kB bank of the banked far memory (only if XMEM_SIZE /= 0, IMEM max 32kB) */
 MEMORY
 {
   rom  (rx) : ORIGIN = 0x0000, LENGTH = 0x1000
-  ram (rwx) : ORIGIN = 0xC008, LENGTH = 0x0800 - 8
+  xmem (rw) : ORIGIN = 0x8000, LENGTH = 0x4000
+  ram (rwx) : ORIGIN = 0xC018, LENGTH = 0x0800 - 24
 }
 
 /* Final executable layout */
@@ -162,6 +165,18 @@ SECTIONS
 
     /* ----------------------------------- */
 
+  /* banked far memory window: initialized data, bank 0 (stored behind .data, copied via the far pointer by crt0) */
+  .xmem_data :
+  {
+    . = ALIGN(2);
+    PROVIDE(__xmem_data_start = .);
+    *(.xmem_data .xmem_data.*)
+    . = ALIGN(2);
+    PROVIDE(__xmem_data_end = .);
+  } > xmem AT > rom
+
+    /* ----------------------------------- */
+
   .bss :
   {
     . = ALIGN(2);
@@ -190,6 +205,18 @@ SECTIONS
     end = .;
   } > ram
 
+    /* ----------------------------------- */
+
+  /* banked far memory window: uninitialized data only (not loaded by image_gen/bootloader, not cleared by crt0), bank 0 */
+  .xmem (NOLOAD):
+  {
+    . = ALIGN(2);
+    PROVIDE(__xmem_start = .);
+    *(.xmem .xmem.*)
+    . = ALIGN(2);
+    PROVIDE(__xmem_end = .);
+  } > xmem
+
   .MP430.attributes 0 :
   {
     KEEP (*(.MSP430.attributes))
@@ -238,6 +265,8 @@ PROVIDE(__data_start_rom  = _etext);
 PROVIDE(__data_end_rom    = _etext + SIZEOF(.data));
 PROVIDE(__romdatastart    = __data_start_rom);
 PROVIDE(__romdatacopysize = SIZEOF(.data));
+PROVIDE(__xmem_data_start_rom = LOADADDR(.xmem_data));
+PROVIDE(__xmem_data_end_rom   = LOADADDR(.xmem_data) + SIZEOF(.xmem_data));
 PROVIDE(__bsssize         = SIZEOF(.bss));
 
 }
@@ -98,6 +98,15 @@ int main(void) {
   CFU_REG7 = test_data16[7];
   verify16("CFU_REG7", CFU_REG7, test_data16[7]);
 
+
+  neo430_uart_br_print("\nTesting custom instructions (default CFU functions)...\n");
+
+  uint16_t a = test_data16[5], b = test_data16[2];
+  verify16("CI0 (avg)", NEO430_CFU_INSTR(0, a, b), (uint16_t)(((uint32_t)a + b) >> 1));
+  verify16("CI1 (min)", NEO430_CFU_INSTR(1, a, b), (a < b) ? a : b);
+  verify16("CI2 (max)", NEO430_CFU_INSTR(2, a, b), (a > b) ? a : b);
+  verify16("CI3 (sat)", NEO430_CFU_INSTR(3, 0xF000, 0x2000), 0xFFFF);
+
   return 0;
 }
 
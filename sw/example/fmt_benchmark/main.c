@@ -0,0 +1,177 @@
+// #################################################################################################
+// #  < Decimal formatting benchmark >                                                             #
+// # ********************************************************************************************* #
+// # Measures the cycles per call of the division-free decimal formatting core (neo430_utoa) and   #
+// # compares it with a classic x%10, x/10 conversion using the compiler's division routines.      #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2020, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEO430 Processor - https://github.com/stnolting/neo430                                    #
+// #################################################################################################
+
+
+// Libraries
+#include <stdint.h>
+#include <neo430.h>
+
+// Configuration
+#define BAUD_RATE 19200
+#define RUNS      8 // calls per measurement (each call is timed individually)
+
+// Function prototypes
+void itoa_reference(uint32_t x, char *res);
+void benchmark(uint32_t x);
+void timer_start(void);
+uint32_t timer_stop(void);
+
+// Test values
+const uint32_t values[6] = {0, 7, 1234, 65535, 1000000, 4294967295UL};
+
+
+/* ------------------------------------------------------------
+ * INFO Main function
+ * ------------------------------------------------------------ */
+int main(void) {
+
+  uint16_t i;
+
+  // setup UART
+  neo430_uart_setup(BAUD_RATE);
+
+  // intro text
+  neo430_uart_br_print("\nDecimal formatting benchmark\n\n");
+
+  // check if TIMER present
+  if (!(SYS_FEATURES & (1<<SYS_TIMER_EN))) {
+    neo430_uart_br_print("Error! No TIMER unit synthesized!");
+    return 1;
+  }
+
+  if (NX_FEATURES & (1<<NX_DADD_EN)) {
+    neo430_uart_br_print("Conversion core: BCD (DADD)\n\n");
+  }
+  else {
+    neo430_uart_br_print("Conversion core: subtract powers of ten\n\n");
+  }
+
+  neo430_uart_br_print("value:      neo430_utoa / x%10,x/10 reference [cycles per call]\n");
+
+  for (i=0; i<6; i++) {
+    benchmark(values[i]);
+  }
+
+  neo430_uart_br_print("\nDone.\n");
+
+  return 0;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Measure cycles per call for one value
+ * PARAM x Value to convert
+ * ------------------------------------------------------------ */
+void benchmark(uint32_t x) {
+
+  char buf[11];
+  uint16_t i;
+  uint32_t t_core = 0, t_ref = 0, t_ovh;
+
+  // measurement overhead
+  timer_start();
+  t_ovh = timer_stop();
+
+  // the 16-bit timer covers max 131070 cycles, so every call is timed individually
+  for (i=0; i<RUNS; i++) {
+    // formatting core
+    timer_start();
+    neo430_utoa(x, 1, buf);
+    t_core += timer_stop() - t_ovh;
+
+    // reference implementation (libgcc divisions)
+    timer_start();
+    itoa_reference(x, buf);
+    t_ref += timer_stop() - t_ovh;
+  }
+
+  neo430_utoa(x, 1, buf);
+  neo430_printf("%s: %n / %n\n", buf, t_core / RUNS, t_ref / RUNS);
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Start cycle measurement (timer runs at CLK/2)
+ * ------------------------------------------------------------ */
+void timer_start(void) {
+
+  TMR_THRES = 0xFFFF;
+  TMR_CT = (1<<TMR_CT_EN) | (TMR_PRSC_2<<TMR_CT_PRSC0); // enable and reset
+  TMR_CT = (1<<TMR_CT_EN) | (1<<TMR_CT_RUN) | (TMR_PRSC_2<<TMR_CT_PRSC0); // start counting
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Stop cycle measurement
+ * RETURN Elapsed cycles (max 131070, the timer must not wrap around)
+ * ------------------------------------------------------------ */
+uint32_t timer_stop(void) {
+
+  uint16_t cnt = TMR_CNT;
+  TMR_CT = 0;
+  return (uint32_t)cnt << 1;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Reference conversion: 10 digits via x%10 and x/10,
+ * INFO then reversal (previous neo430_itoa implementation)
+ * PARAM x Value to convert
+ * PARAM res Pointer to result buffer (11 elements)
+ * ------------------------------------------------------------ */
+void itoa_reference(uint32_t x, char *res) {
+
+  char buffer1[11];
+  uint16_t i, j;
+
+  for (i=0; i<10; i++) {
+    buffer1[i] = '0' + (char)(x%10);
+    x /= 10;
+  }
+
+  for (i=9; i!=0; i--) {
+    if (buffer1[i] != '0')
+      break;
+  }
+
+  j = 0;
+  do {
+    res[j++] = buffer1[i];
+  } while (i--);
+
+  res[j] = '\0';
+}
@@ -276,7 +276,7 @@ uint8_t get_neighborhood(uint8_t u, int16_t x, int16_t y){
 
 
 /* ------------------------------------------------------------
- * INFO Population count
+ * INFO Population count (counts eight cells at once)
  * RETURN 16-bit number of living cells in universe u
  * ------------------------------------------------------------ */
 uint16_t pop_count(uint8_t u) {
@@ -284,9 +284,9 @@ uint16_t pop_count(uint8_t u) {
   uint16_t x, y, cnt;
 
   cnt = 0;
-  for (x=0; x<NUM_CELLS_X; x++) {
+  for (x=0; x<NUM_CELLS_X/8; x++) {
     for (y=0; y<NUM_CELLS_Y; y++) {
-      cnt += (uint16_t)get_cell(u, x, y);
+      cnt += neo430_popcount((uint16_t)universe[u][x][y]);
     }
   }
 
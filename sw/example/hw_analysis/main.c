@@ -64,19 +64,29 @@ int main(void) {
   // HW version
   neo430_printf("Hardware version: 0x%x\n", HW_VERSION);
 
-  // HW user code
+  // HW user code and hart ID
   neo430_printf("User code:        0x%x\n", USER_CODE);
+  neo430_printf("Hart ID:          %u\n", HART_ID);
   
   // Clock speed
   uint32_t clock = CLOCKSPEED_32bit;
   neo430_printf("Clock speed:      %n Hz\n", clock);
 
+  // Peripheral clock speed
+  clock = IOCLOCKSPEED_32bit;
+  neo430_printf("Peripheral clock: %n Hz\n", clock);
+
   // ROM/IMEM
   neo430_printf("IMEM/ROM:         %u bytes @ 0x%x\n", IMEM_SIZE, IMEM_ADDR_BASE);
 
   // RAM/DMEM
   neo430_printf("DMEM/RAM:         %u bytes @ 0x%x\n", DMEM_SIZE, DMEM_ADDR_BASE);
 
+  // banked far memory
+  if (NX_FEATURES & (1<<NX_XMEM_EN)) {
+    neo430_printf("XMEM (banked):    %u kB @ 0x%x (window)\n", XMEM_SIZE_KB, XMEM_ADDR_BASE);
+  }
+
   // UART baud rate
   neo430_printf("UART Baud rate:   %n\n", neo430_uart_get_baudrate());
 
@@ -164,6 +174,49 @@ int main(void) {
   neo430_printf("- Low-Power Implementation: ");
   print_state2(nx & (1<<NX_LOWPOWER_EN));
 
+  // DADD instruction
+  neo430_printf("- DADD instruction:         ");
+  print_state2(nx & (1<<NX_DADD_EN));
+
+  // MSP430X multi-bit shifts
+  neo430_printf("- Multi-bit shifts (430X):  ");
+  print_state2(nx & (1<<NX_XSHIFT_EN));
+
+  // MSP430X PUSHM/POPM
+  neo430_printf("- PUSHM/POPM (430X):        ");
+  print_state2(nx & (1<<NX_PUSHM_EN));
+
+  // bit manipulation unit
+  neo430_printf("- Bit manipulation unit:    ");
+  print_state(nx & (1<<NX_BMU_EN));
+
+  // wishbone slave port
+  neo430_printf("- Wishbone slave port:      ");
+  print_state(nx & (1<<NX_WBS_EN));
+  neo430_printf("- Inter-core mailbox port:  ");
+  print_state(nx & (1<<NX_MBOX_EN));
+
+  // separate peripheral clock
+  neo430_printf("- Separate IO clock:        ");
+  print_state2(nx & (1<<NX_IO_CLK_EN));
+
+  // dual-read-port register file
+  neo430_printf("- Dual-port register file:  ");
+  print_state2(nx & (1<<NX_DUAL_RF_EN));
+
+  // shadow register bank
+  neo430_printf("- Shadow reg. bank IRQs:    ");
+  if ((nx >> NX_SHADOW_TIMER) & 15) {
+    if (nx & (1<<NX_SHADOW_TIMER)) neo430_printf("TIMER ");
+    if (nx & (1<<NX_SHADOW_SER))   neo430_printf("SERIAL ");
+    if (nx & (1<<NX_SHADOW_GPIO))  neo430_printf("GPIO ");
+    if (nx & (1<<NX_SHADOW_EXT))   neo430_printf("EXT");
+    neo430_printf("\n");
+  }
+  else {
+    neo430_printf("none\n");
+  }
+
 
   // Exit
   // --------------------------------------------
@@ -0,0 +1,201 @@
+// #################################################################################################
+// #  < IRQ latency benchmark >                                                                    #
+// # ********************************************************************************************* #
+// # Measures the interrupt latency (trigger to first ISR instruction) of the GPIO pin-change IRQ, #
+// # the EXIRQ controller with software dispatcher and the EXIRQ controller in vectored mode.      #
+// # The interrupt sources are triggered by the testbench (sim/neo430_tb.vhd), which also does     #
+// # the actual measurement and logs min/avg/max to neo430.irq_latency.txt. Install this program   #
+// # into the IMEM image (make install) and run the simulation for at least 50ms.                  #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2020, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEO430 Processor - https://github.com/stnolting/neo430                                    #
+// #################################################################################################
+
+
+// Libraries
+#include <stdint.h>
+#include <neo430.h>
+#include <neo430_exirq.h>
+
+// Configuration
+#define BAUD_RATE 19200
+#define TRIALS    32 // measurements per phase, has to match lat_trials_c in sim/neo430_tb.vhd
+
+// Benchmark protocol (GPIO output)
+#define PHASE_LSB  12 // phase id (bits 14:12): 1 = GPIO, 2 = EXIRQ (software dispatch), 3 = EXIRQ (vectored)
+#define MARKER_BIT 11 // set by the first instruction of the ISR, cleared by main (GPIO output 15 is the crt0 startup marker)
+
+// Global variables
+volatile uint16_t isr_cnt;
+
+// Set marker: GPIO_OUTPUT |= (1 << MARKER_BIT), has to be the very first instruction of each handler
+#define SET_MARKER "bis #0x0800, &0xFFAC"
+
+// Function prototypes
+void __attribute__((naked)) gpio_irq_handler(void);
+void __attribute__((__interrupt__, used)) gpio_irq_body(void);
+void exirq_ch0_handler(void);
+void __attribute__((naked)) exirq_ch0_vec_handler(void);
+void __attribute__((__interrupt__, used)) exirq_ch0_vec_body(void);
+void run_phase(uint16_t phase);
+
+
+/* ------------------------------------------------------------
+ * INFO Main function
+ * ------------------------------------------------------------ */
+int main(void) {
+
+  // setup UART
+  neo430_uart_setup(BAUD_RATE);
+
+  // intro text
+  neo430_uart_br_print("\nIRQ latency benchmark\n"
+                       "Results are logged by the testbench to neo430.irq_latency.txt\n");
+
+  // check if GPIO present
+  if (!(SYS_FEATURES & (1<<SYS_GPIO_EN))) {
+    neo430_uart_br_print("Error! No GPIO unit synthesized!");
+    return 1;
+  }
+
+  GPIO_OUTPUT = 0; // benchmark inactive
+
+  neo430_eint();
+
+
+  // phase 1: GPIO pin-change interrupt
+  IRQVEC_GPIO = (uint16_t)(&gpio_irq_handler);
+  GPIO_IRQMASK = 0x0001; // input pin 0 only
+  run_phase(1);
+  GPIO_IRQMASK = 0;
+
+
+  if (SYS_FEATURES & (1<<SYS_EXIRQ_EN)) {
+
+    struct neo430_exirq_config_t exirq_config;
+    uint8_t i;
+    for (i=1; i<8; i++) {
+      exirq_config.address[i] = 0; // unused
+    }
+    exirq_config.enable = 0b00000001; // channel 0 only
+
+    // phase 2: EXIRQ channel 0, software dispatcher
+    exirq_config.address[0] = (uint16_t)(&exirq_ch0_handler);
+    neo430_exirq_config(exirq_config);
+    neo430_exirq_enable();
+    run_phase(2);
+
+    // phase 3: EXIRQ channel 0, hardware-vectored dispatch
+    exirq_config.address[0] = (uint16_t)(&exirq_ch0_vec_handler);
+    neo430_exirq_config_vectored(exirq_config);
+    neo430_exirq_enable();
+    run_phase(3);
+
+    neo430_exirq_disable();
+  }
+
+  neo430_dint();
+  GPIO_OUTPUT = 0; // benchmark inactive
+
+  neo430_uart_br_print("Done.\n");
+
+  return 0;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Run one benchmark phase: the testbench triggers the
+ * INFO interrupt source at pseudo-random points in time while
+ * INFO the CPU executes a background workload
+ * PARAM phase Benchmark phase id (1..7)
+ * ------------------------------------------------------------ */
+void run_phase(uint16_t phase) {
+
+  volatile uint16_t workload = 1;
+  uint16_t last = 0;
+
+  isr_cnt = 0;
+  GPIO_OUTPUT = phase << PHASE_LSB; // start phase, marker cleared
+
+  while (last < TRIALS) {
+    // background workload: mix of short and long instructions
+    workload = (workload << 1) ^ (workload >> 3) ^ last;
+
+    if (isr_cnt != last) { // ISR has been executed
+      last = isr_cnt;
+      GPIO_OUTPUT &= ~(1 << MARKER_BIT); // ready for next trigger
+    }
+  }
+}
+
+
+/* ------------------------------------------------------------
+ * INFO GPIO pin-change interrupt entry: sets the marker before
+ * INFO any compiler-generated prologue, then jumps to the actual
+ * INFO handler (which saves the context and returns via RETI)
+ * ------------------------------------------------------------ */
+void __attribute__((naked)) gpio_irq_handler(void) {
+
+  asm volatile (SET_MARKER "\n\t"
+                "br #gpio_irq_body");
+}
+
+void __attribute__((__interrupt__, used)) gpio_irq_body(void) {
+
+  isr_cnt++;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO EXIRQ channel 0 handler (called by software dispatcher)
+ * INFO The measured latency includes the dispatcher
+ * ------------------------------------------------------------ */
+void exirq_ch0_handler(void) {
+
+  asm volatile (SET_MARKER);
+  isr_cnt++;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO EXIRQ channel 0 interrupt entry (called directly by the
+ * INFO CPU): sets the marker before any compiler-generated
+ * INFO prologue, then jumps to the actual handler
+ * ------------------------------------------------------------ */
+void __attribute__((naked)) exirq_ch0_vec_handler(void) {
+
+  asm volatile (SET_MARKER "\n\t"
+                "br #exirq_ch0_vec_body");
+}
+
+void __attribute__((__interrupt__, used)) exirq_ch0_vec_body(void) {
+
+  isr_cnt++;
+}
@@ -0,0 +1,195 @@
+// #################################################################################################
+// #  < Inter-core mailbox test >                                                                  #
+// # ********************************************************************************************* #
+// # Inter-core mailbox test for multi-core clusters (sim/neo430_cluster_tb.vhd). All cores run    #
+// # this program: core 0 sends commands to all other cores and checks their replies (ping,        #
+// # hardware semaphores, doorbells), the other cores execute the commands.                        #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2020, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEO430 Processor - https://github.com/stnolting/neo430                                    #
+// #################################################################################################
+
+// Libraries
+#include <stdint.h>
+#include <neo430.h>
+
+// Configuration
+#define BAUD_RATE 19200
+
+// Commands (bits 15:12 of a message)
+#define CMD_PING 1 // reply with message + 1
+#define CMD_LOCK 2 // try to lock semaphore (bits 3:0), reply with result
+#define CMD_FREE 3 // release semaphore (bits 3:0), reply when done
+
+// Function prototypes
+void worker(void);
+uint16_t command(uint8_t core, uint16_t msg);
+
+
+/* ------------------------------------------------------------
+ * INFO Main function
+ * ------------------------------------------------------------ */
+int main(void) {
+
+  uint8_t i, num;
+  uint16_t err = 0, err_sem;
+
+  // only core 0 has a console
+  if (neo430_mailbox_core_id() != 0) {
+    worker();
+  }
+
+  // setup UART
+  neo430_uart_setup(BAUD_RATE);
+
+  if (neo430_mailbox_available() == 0) {
+    neo430_uart_br_print("Error! No mailbox port synthesized!");
+    return 1;
+  }
+
+  num = neo430_mailbox_num_cores();
+  neo430_printf("\nInter-core mailbox test (%u cores)\n", (uint16_t)num);
+
+  // message round trip to all other cores
+  for (i=1; i<num; i++) {
+    if (command(i, (CMD_PING<<12) | i) != ((CMD_PING<<12) | i) + 1) {
+      neo430_printf("Ping core %u: FAILED\n", (uint16_t)i);
+      err++;
+    }
+  }
+
+  // semaphore 0: owned by core 0, core 1 must not get it
+  if (num > 1) {
+    err_sem = err;
+    if (neo430_mailbox_trylock(0) == 0) {
+      err++;
+    }
+    if (command(1, (CMD_LOCK<<12) | 0) != ((CMD_LOCK<<12) | 0)) {
+      err++;
+    }
+    neo430_mailbox_unlock(0);
+    if (command(1, (CMD_LOCK<<12) | 0) != ((CMD_LOCK<<12) | 1)) {
+      err++;
+    }
+    if (neo430_mailbox_trylock(0) != 0) { // now owned by core 1
+      err++;
+    }
+    command(1, (CMD_FREE<<12) | 0);
+    if (neo430_mailbox_trylock(0) == 0) {
+      err++;
+    }
+    neo430_mailbox_unlock(0);
+    if (err != err_sem) {
+      neo430_uart_br_print("Semaphores: FAILED\n");
+    }
+  }
+
+  // send overrun: fill own receive FIFO, then write to the send buffer while it is still busy
+  MBOX_DST = 0;
+  do {
+    MBOX_TX = 0;
+  } while ((MBOX_CT & (1<<MBOX_CT_TX_BUSY)) == 0);
+  MBOX_TX = 0; // dropped
+  err_sem = err;
+  if ((MBOX_CT & (1<<MBOX_CT_TX_OVR)) == 0) {
+    err++;
+  }
+  MBOX_CT |= (1<<MBOX_CT_TX_OVR); // clear overrun flag
+  if (MBOX_CT & (1<<MBOX_CT_TX_OVR)) {
+    err++;
+  }
+  while (MBOX_CT & ((1<<MBOX_CT_RX_AVAIL) | (1<<MBOX_CT_TX_BUSY))) { // drain receive FIFO
+    neo430_mailbox_receive(0);
+  }
+  if (err != err_sem) {
+    neo430_uart_br_print("TX overrun: FAILED\n");
+  }
+
+  // doorbell: ring ourselves
+  neo430_mailbox_ring(1<<0);
+  if (neo430_mailbox_get_doorbells() != (1<<0)) {
+    neo430_uart_br_print("Doorbell: FAILED\n");
+    err++;
+  }
+
+  if (err) {
+    neo430_printf("MBOX test FAILED (%u errors)\n", err);
+  }
+  else {
+    neo430_uart_br_print("MBOX test OK\n");
+  }
+
+  return 0;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Send command to core and wait for its reply
+ * PARAM core: Destination core ID
+ * PARAM msg: Command message
+ * RETURN Reply message
+ * ------------------------------------------------------------ */
+uint16_t command(uint8_t core, uint16_t msg) {
+
+  uint8_t src;
+
+  neo430_mailbox_send(core, msg);
+  return neo430_mailbox_receive(&src);
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Command loop of all cores but core 0
+ * ------------------------------------------------------------ */
+void worker(void) {
+
+  uint8_t src;
+  uint16_t msg, arg;
+
+  while (1) {
+    msg = neo430_mailbox_receive(&src);
+    arg = msg & 0x0FFF;
+
+    switch (msg >> 12) {
+      case CMD_PING:
+        neo430_mailbox_send(src, msg + 1);
+        break;
+      case CMD_LOCK:
+        neo430_mailbox_send(src, (CMD_LOCK<<12) | neo430_mailbox_trylock((uint8_t)arg));
+        break;
+      case CMD_FREE:
+        neo430_mailbox_unlock((uint8_t)arg);
+        neo430_mailbox_send(src, msg);
+        break;
+      default:
+        break;
+    }
+  }
+}
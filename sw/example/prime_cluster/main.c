@@ -0,0 +1,131 @@
+// #################################################################################################
+// #  < Parallel prime numbers example for multi-core clusters >                                   #
+// # ********************************************************************************************* #
+// # Counts the prime numbers below PRIME_LIMIT on all cores of a multi-core cluster               #
+// # (rtl/top_templates/neo430_cluster.vhd). The candidates are distributed by hart ID, each core  #
+// # stores its result in the shared memory and reports completion via the mailbox. Core 0 sets    #
+// # gpio_o(15) during the computation, so the cluster testbench (sim/neo430_cluster_tb.vhd) can   #
+// # show the speed-up for different numbers of cores.                                             #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2020, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEO430 Processor - https://github.com/stnolting/neo430                                    #
+// #################################################################################################
+
+// Libraries
+#include <stdint.h>
+#include <neo430.h>
+
+// Configuration
+#define BAUD_RATE   19200
+#define PRIME_LIMIT 1024 // count odd prime numbers in [3, PRIME_LIMIT)
+#define SHMEM_BASE  0x00000000UL // results: one 32-bit word per core
+
+// Function prototypes
+uint16_t count_primes(uint8_t hart, uint8_t num);
+
+
+/* ------------------------------------------------------------
+ * INFO Main function
+ * ------------------------------------------------------------ */
+int main(void) {
+
+  uint8_t hart = (uint8_t)HART_ID;
+  uint8_t num = neo430_mailbox_num_cores();
+  uint8_t i, src;
+  uint16_t res, total;
+
+  // worker cores: wait for start command, compute, store result, report to core 0
+  if (hart != 0) {
+    neo430_mailbox_receive(&src);
+    res = count_primes(hart, num);
+    neo430_wishbone32_write32(SHMEM_BASE + 4*(uint32_t)hart, (uint32_t)res);
+    neo430_mailbox_send(0, hart);
+    while (1) {
+      neo430_sleep();
+    }
+  }
+
+  // setup UART
+  neo430_uart_setup(BAUD_RATE);
+  neo430_printf("\nParallel prime numbers (%u cores)\n", (uint16_t)num);
+
+  // start benchmark
+  GPIO_OUTPUT = 1<<15;
+  for (i=1; i<num; i++) {
+    neo430_mailbox_send(i, 0);
+  }
+
+  res = count_primes(0, num);
+  neo430_wishbone32_write32(SHMEM_BASE, (uint32_t)res);
+
+  // wait for all other cores
+  for (i=1; i<num; i++) {
+    neo430_mailbox_receive(&src);
+  }
+  GPIO_OUTPUT = 0;
+
+  // collect results from shared memory
+  total = 0;
+  for (i=0; i<num; i++) {
+    res = (uint16_t)neo430_wishbone32_read32(SHMEM_BASE + 4*(uint32_t)i);
+    neo430_printf("Core %u: %u primes\n", (uint16_t)i, res);
+    total += res;
+  }
+  neo430_printf("Total: %u odd primes below %u\n", total, (uint16_t)PRIME_LIMIT);
+
+  return 0;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Count odd prime numbers of this core's share: candidates
+ * INFO 3+2k with k = hart, hart+num, hart+2*num, ...
+ * PARAM hart: Own core ID
+ * PARAM num: Number of cores
+ * RETURN Number of prime numbers found
+ * ------------------------------------------------------------ */
+uint16_t count_primes(uint8_t hart, uint8_t num) {
+
+  uint16_t n, i, cnt = 0;
+  uint8_t is_prime;
+
+  for (n=3+2*(uint16_t)hart; n<PRIME_LIMIT; n+=2*(uint16_t)num) {
+    is_prime = 1;
+    for (i=3; i*i<=n; i+=2) {
+      if (n%i == 0) {
+        is_prime = 0;
+        break;
+      }
+    }
+    cnt += is_prime;
+  }
+
+  return cnt;
+}
@@ -165,7 +165,7 @@ void set_speed(void) {
   }
 
   // print new clock frequency
-  uint32_t clock = CLOCKSPEED_32bit;
+  uint32_t clock = IOCLOCKSPEED_32bit;
   switch (prsc) {
     case 0: clock = clock / 2; break;
     case 1: clock = clock / 4; break;
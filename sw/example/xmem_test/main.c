@@ -0,0 +1,159 @@
+// #################################################################################################
+// #  < Banked far memory (XMEM) test >                                                            #
+// # ********************************************************************************************* #
+// # Fills the complete banked far memory via the auto-incrementing far pointer and verifies the   #
+// # data via the bank window (and vice versa). Also uses a table placed in the .xmem section.     #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2020, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEO430 Processor - https://github.com/stnolting/neo430                                    #
+// #################################################################################################
+
+// Libraries
+#include <stdint.h>
+#include <neo430.h>
+
+// Configuration
+#define BAUD_RATE 19200
+
+// Tables in the XMEM window (bank 0)
+uint16_t xtable[256] NEO430_XMEM;
+uint16_t xinit[4] NEO430_XMEM_DATA = {0x0123, 0x4567, 0x89AB, 0xCDEF};
+
+// Function prototypes
+uint16_t pattern(uint32_t addr);
+
+
+/* ------------------------------------------------------------
+ * INFO Main function
+ * ------------------------------------------------------------ */
+int main(void) {
+
+  uint32_t size, addr;
+  uint16_t i, err = 0;
+  volatile uint16_t *win;
+
+  // setup UART
+  neo430_uart_setup(BAUD_RATE);
+
+  if (neo430_xmem_available() == 0) {
+    neo430_uart_br_print("Error! No banked far memory (XMEM) synthesized!");
+    return 1;
+  }
+
+  size = neo430_xmem_size();
+  neo430_printf("\nBanked far memory (XMEM) test: %n bytes, %u banks\n", size, (uint16_t)(size / XMEM_WIN_SIZE));
+
+  // initialized table in .xmem_data section (copied by crt0), check before the memory is overwritten
+  neo430_uart_br_print("Section .xmem_data: ");
+  if ((xinit[0] != 0x0123) || (xinit[1] != 0x4567) || (xinit[2] != 0x89AB) || (xinit[3] != 0xCDEF)) {
+    neo430_uart_br_print("FAILED\n");
+    err++;
+  }
+  else {
+    neo430_uart_br_print("OK\n");
+  }
+
+  // write pattern via far pointer (one block transfer), check via window
+  neo430_uart_br_print("Far pointer -> window: ");
+  XMEM_PTR_32bit = 0;
+  for (addr=0; addr<size; addr+=2) {
+    XMEM_DATA = pattern(addr);
+  }
+  for (addr=0; addr<size; addr+=2) {
+    win = (volatile uint16_t*)neo430_xmem_map(addr);
+    if (*win != pattern(addr)) {
+      err++;
+    }
+  }
+  if (err) {
+    neo430_printf("FAILED (%u errors)\n", err);
+  }
+  else {
+    neo430_uart_br_print("OK\n");
+  }
+
+  // write inverted pattern via window, check via far pointer
+  neo430_uart_br_print("Window -> far pointer: ");
+  i = err;
+  for (addr=0; addr<size; addr+=2) {
+    win = (volatile uint16_t*)neo430_xmem_map(addr);
+    *win = ~pattern(addr);
+  }
+  for (addr=0; addr<size; addr+=2) {
+    if (neo430_xmem_read16(addr) != (uint16_t)(~pattern(addr))) {
+      err++;
+    }
+  }
+  if (err != i) {
+    neo430_printf("FAILED (%u errors)\n", err - i);
+  }
+  else {
+    neo430_uart_br_print("OK\n");
+  }
+
+  // table in .xmem section (bank 0), byte access via window
+  neo430_uart_br_print("Section .xmem: ");
+  i = err;
+  neo430_xmem_set_bank(0);
+  for (addr=0; addr<256; addr++) {
+    xtable[addr] = (uint16_t)addr;
+  }
+  ((volatile uint8_t*)xtable)[1] = 0xA5; // high byte of xtable[0]
+  if ((neo430_xmem_read16((uint32_t)((uint16_t)xtable - XMEM_ADDR_BASE)) != 0xA500) ||
+      (neo430_xmem_read16((uint32_t)((uint16_t)&xtable[255] - XMEM_ADDR_BASE)) != 255)) {
+    err++;
+  }
+  if (err != i) {
+    neo430_uart_br_print("FAILED\n");
+  }
+  else {
+    neo430_uart_br_print("OK\n");
+  }
+
+  if (err) {
+    neo430_uart_br_print("XMEM test FAILED\n");
+  }
+  else {
+    neo430_uart_br_print("XMEM test OK\n");
+  }
+
+  return 0;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Test pattern for far address
+ * PARAM addr: 20-bit far address
+ * RETURN Pattern word (includes bank and offset)
+ * ------------------------------------------------------------ */
+uint16_t pattern(uint32_t addr) {
+
+  return (uint16_t)(addr >> 14) ^ (uint16_t)addr ^ 0x5A00;
+}
@@ -60,6 +60,7 @@ union  int64_u { int64_t  int64; int32_t  int32[sizeof(int64_t)/4]; int16_t int1
 #define I_FLAG 3  // r/w: global interrupt enable
 #define S_FLAG 4  // r/w: sleep
 #define P_FLAG 5  // r/w: parity (if enabled for synthesis)
+#define B_FLAG 6  // r/w: shadow register bank select (if enabled for synthesis)
 #define V_FLAG 8  // r/w: overflow
 #define Q_FLAG 14 // -/w: clear pending IRQ buffer when set
 #define R_FLAG 15 // r/w: allow write-access to IMEM
@@ -67,8 +68,10 @@ union  int64_u { int64_t  int64; int32_t  int32[sizeof(int64_t)/4]; int16_t int1
 
 // ----------------------------------------------------------------------------
 // Processor peripheral/IO devices
-// Beginning of IO area: 0xFF80
-// Size of IO area: 128 bytes
+// Beginning of IO area: 0xFF00
+// Size of IO area: 256 bytes
+// 0xFF80..0xFFFF: primary device registers
+// 0xFF00..0xFF7F: device extension registers
 // ----------------------------------------------------------------------------
 #define REG8  (volatile uint8_t*)        // memory-mapped register
 #define REG16 (volatile uint16_t*)       // memory-mapped register
@@ -82,8 +85,33 @@ union  int64_u { int64_t  int64; int32_t  int32[sizeof(int64_t)/4]; int16_t int1
 // Start of memory sections
 // ----------------------------------------------------------------------------
 #define IMEM_ADDR_BASE 0x0000 // r/(w)/x: instruction memory
+#define XMEM_ADDR_BASE 0x8000 // r/w/x:   banked far memory window (XMEM_SIZE > 0 only)
 #define DMEM_ADDR_BASE 0xC000 // r/w/x:   data memory
 #define BTLD_ADDR_BASE 0xF000 // r/-/x:   bootloader memory
+#define BBND_ADDR_BASE 0xF800 // r/w/-:   bit-band alias window
+#define IOST_ADDR_BASE 0xFC00 // -/w/-:   IO set-bits alias window
+#define IOCL_ADDR_BASE 0xFD00 // -/w/-:   IO clear-bits alias window
+#define IOTG_ADDR_BASE 0xFE00 // -/w/-:   IO toggle-bits alias window
+
+
+// ----------------------------------------------------------------------------
+// Bit-band alias window: one byte per bit of the primary IO registers (0xFF80..0xFFFF)
+// Reading returns the bit state, writing 1/0 atomically sets/clears the bit (hardware read-modify-write)
+// Only use for registers that read back what was written (e.g. GPIO_OUTPUT, SPI_CT, TMR_CT, UART_CT)
+// Alias accesses to registers with read side effects (UART_RTX, SPI_RTX, TRNG_CT) are ignored (read as zero)
+// ----------------------------------------------------------------------------
+#define BITBAND(reg, bit) (*(REG8 (BBND_ADDR_BASE + ((((uint16_t)&(reg)) & 0x7E) << 3) + (bit))))
+
+
+// ----------------------------------------------------------------------------
+// Atomic set/clear/toggle alias windows of the complete IO area (0xFF00..0xFFFF), write-only
+// Writing a bit mask atomically sets/clears/toggles the according register bits (hardware read-modify-write)
+// Only use for registers that read back what was written (see BITBAND)
+// Accesses to registers with read side effects (see BITBAND, TWI_RXD, XMEM_DATA, mailbox) are ignored
+// ----------------------------------------------------------------------------
+#define IO_SET(reg) (*(REG16 (IOST_ADDR_BASE + (((uint16_t)&(reg)) & 0xFF))))
+#define IO_CLR(reg) (*(REG16 (IOCL_ADDR_BASE + (((uint16_t)&(reg)) & 0xFF))))
+#define IO_TGL(reg) (*(REG16 (IOTG_ADDR_BASE + (((uint16_t)&(reg)) & 0xFF))))
 
 
 // ----------------------------------------------------------------------------
@@ -94,6 +122,16 @@ union  int64_u { int64_t  int64; int32_t  int32[sizeof(int64_t)/4]; int16_t int1
 #define IRQVEC_GPIO   (*(REG16 (DMEM_ADDR_BASE + 4))) // r/w: gpio pin change
 #define IRQVEC_EXT    (*(REG16 (DMEM_ADDR_BASE + 6))) // r/w: external IRQ
 
+// EXIRQ vector table, used in vectored mode (EXIRQ_CT_VEC set) instead of IRQVEC_EXT
+#define IRQVEC_EXT0   (*(REG16 (DMEM_ADDR_BASE +  8))) // r/w: external IRQ channel 0
+#define IRQVEC_EXT1   (*(REG16 (DMEM_ADDR_BASE + 10))) // r/w: external IRQ channel 1
+#define IRQVEC_EXT2   (*(REG16 (DMEM_ADDR_BASE + 12))) // r/w: external IRQ channel 2
+#define IRQVEC_EXT3   (*(REG16 (DMEM_ADDR_BASE + 14))) // r/w: external IRQ channel 3
+#define IRQVEC_EXT4   (*(REG16 (DMEM_ADDR_BASE + 16))) // r/w: external IRQ channel 4
+#define IRQVEC_EXT5   (*(REG16 (DMEM_ADDR_BASE + 18))) // r/w: external IRQ channel 5
+#define IRQVEC_EXT6   (*(REG16 (DMEM_ADDR_BASE + 20))) // r/w: external IRQ channel 6
+#define IRQVEC_EXT7   (*(REG16 (DMEM_ADDR_BASE + 22))) // r/w: external IRQ channel 7
+
 
 // ----------------------------------------------------------------------------
 // Unsigned Multiplier/Divider Unit (MULDIV)
@@ -169,6 +207,10 @@ union  int64_u { int64_t  int64; int32_t  int32[sizeof(int64_t)/4]; int16_t int1
 #define UART_CT  (*(REG16 0xFFA0)) // r/w: control register
 #define UART_RTX (*(REG16 0xFFA2)) // r/w: receive/transmit register
 
+#define UART_CT_SET (*(REG16 0xFCA0)) // -/w: set control register bits (atomic)
+#define UART_CT_CLR (*(REG16 0xFDA0)) // -/w: clear control register bits (atomic)
+#define UART_CT_TGL (*(REG16 0xFEA0)) // -/w: toggle control register bits (atomic)
+
 // UART control register
 #define UART_CT_BAUD0     0 // r/w: baud config bit 0
 #define UART_CT_BAUD1     1 // r/w: baud config bit 1
@@ -207,6 +249,10 @@ union  int64_u { int64_t  int64; int32_t  int32[sizeof(int64_t)/4]; int16_t int1
 #define SPI_CT  (*(REG16 0xFFA4)) // r/w: control register
 #define SPI_RTX (*(REG16 0xFFA6)) // r/w: receive/transmit register
 
+#define SPI_CT_SET (*(REG16 0xFCA4)) // -/w: set control register bits (atomic)
+#define SPI_CT_CLR (*(REG16 0xFDA4)) // -/w: clear control register bits (atomic)
+#define SPI_CT_TGL (*(REG16 0xFEA4)) // -/w: toggle control register bits (atomic)
+
 // SPI control register
 #define SPI_CT_CS_SEL0  0 // r/w: spi CS 0
 #define SPI_CT_CS_SEL1  1 // r/w: spi CS 1
@@ -223,7 +269,7 @@ union  int64_u { int64_t  int64; int32_t  int32[sizeof(int64_t)/4]; int16_t int1
 #define SPI_CT_DIR     12 // r/w: shift direction (0: MSB first, 1: LSB first)
 #define SPI_CT_SIZE    13 // r/w: 0 = 8-bit, 1 = 16-bit
 // ...
-#define SPI_CT_BUSY    15 // r/-: spi transceiver is busy
+#define SPI_CT_BUSY    15 // r/-: spi transceiver is busy (including pending FIFO/burst frames)
 
 // clock prescalers 
 #define SPI_PRSC_2    0 // CLK/2
@@ -235,6 +281,42 @@ union  int64_u { int64_t  int64; int32_t  int32[sizeof(int64_t)/4]; int16_t int1
 #define SPI_PRSC_2048 6 // CLK/2048
 #define SPI_PRSC_4096 7 // CLK/4096
 
+// SPI extension registers
+#define SPI_FCT  (*(REG16 0xFF40)) // r/w: FIFO control/status register
+#define SPI_TLEN (*(REG16 0xFF42)) // r/w: burst length (number of dummy frames to send)
+#define SPI_QCT  (*(REG16 0xFF44)) // r/w: data line mode (dual/quad) control register
+//#define reserved (*(REG16 0xFF46)) // reserved
+
+// SPI FIFO control/status register
+#define SPI_FCT_TXE_IRQ   0 // r/w: interrupt when TX FIFO becomes empty
+#define SPI_FCT_RXH_IRQ   1 // r/w: interrupt when RX FIFO becomes at least half full
+#define SPI_FCT_DONE_IRQ  2 // r/w: interrupt when burst is done (TX FIFO empty, TLEN = 0, transceiver idle)
+#define SPI_FCT_TX_CLR    3 // -/w: clear TX FIFO and TLEN
+#define SPI_FCT_RX_CLR    4 // -/w: clear RX FIFO and overrun flag
+#define SPI_FCT_SIZE0     5 // r/-: log2(FIFO depth) bit 0
+#define SPI_FCT_SIZE1     6 // r/-: log2(FIFO depth) bit 1
+#define SPI_FCT_SIZE2     7 // r/-: log2(FIFO depth) bit 2
+#define SPI_FCT_TX_EMPTY  8 // r/-: TX FIFO is empty
+#define SPI_FCT_TX_FULL   9 // r/-: TX FIFO is full
+#define SPI_FCT_RX_AVAIL 10 // r/-: RX FIFO data available
+#define SPI_FCT_RX_HALF  11 // r/-: RX FIFO is at least half full
+#define SPI_FCT_RX_FULL  12 // r/-: RX FIFO is full
+#define SPI_FCT_RX_OVR   13 // r/-: RX FIFO overrun (data lost)
+#define SPI_FCT_RX_EN    14 // r/w: push received frames into RX FIFO (0: SPI_RTX returns last received frame)
+
+// SPI data line mode control register
+#define SPI_QCT_MODE0 0 // r/w: data line mode bit 0 (00: single, 01: dual, 1-: quad)
+#define SPI_QCT_MODE1 1 // r/w: data line mode bit 1
+#define SPI_QCT_WR    2 // r/w: drive data lines in dual/quad mode (0: read, 1: write)
+#define SPI_QCT_DQ_EN 3 // r/w: use spi_dq_io lines (IO0..IO3) instead of spi_mosi_o/spi_miso_i
+
+// SPI data line modes (SPI_QCT bits 2..0), dual/quad modes are always MSB first
+#define SPI_IO_SINGLE  0 // standard SPI (IO0 = MOSI, IO1 = MISO)
+#define SPI_IO_DUAL_RD 1 // dual read (IO0..IO1 are inputs)
+#define SPI_IO_QUAD_RD 2 // quad read (IO0..IO3 are inputs)
+#define SPI_IO_DUAL_WR 5 // dual write (IO0..IO1 are outputs)
+#define SPI_IO_QUAD_WR 6 // quad write (IO0..IO3 are outputs)
+
 
 // ----------------------------------------------------------------------------
 // General Purpose Inputs/Outputs (GPIO)
@@ -244,6 +326,10 @@ union  int64_u { int64_t  int64; int32_t  int32[sizeof(int64_t)/4]; int16_t int1
 #define GPIO_OUTPUT  (*(REG16 0xFFAC)) // r/w: parallel output
 //#define reserved   (*(REG16 0xFFAE)) // reserved
 
+#define GPIO_OUTPUT_SET (*(REG16 0xFCAC)) // -/w: set output bits (atomic)
+#define GPIO_OUTPUT_CLR (*(REG16 0xFDAC)) // -/w: clear output bits (atomic)
+#define GPIO_OUTPUT_TGL (*(REG16 0xFEAC)) // -/w: toggle output bits (atomic)
+
 
 // ----------------------------------------------------------------------------
 // High-Precision Timer (TIMER)
@@ -253,6 +339,10 @@ union  int64_u { int64_t  int64; int32_t  int32[sizeof(int64_t)/4]; int16_t int1
 #define TMR_THRES  (*(REG16 0xFFB4)) // -/w: threshold register
 //#define reserved (*(REG16 0xFFB6)) // reserved
 
+#define TMR_CT_SET (*(REG16 0xFCB0)) // -/w: set control register bits (atomic)
+#define TMR_CT_CLR (*(REG16 0xFDB0)) // -/w: clear control register bits (atomic)
+#define TMR_CT_TGL (*(REG16 0xFEB0)) // -/w: toggle control register bits (atomic)
+
 // Timer control register
 #define TMR_CT_EN     0 // r/w: timer unit global enable
 #define TMR_CT_ARST   1 // r/w: auto reset on match
@@ -383,6 +473,33 @@ union  int64_u { int64_t  int64; int32_t  int32[sizeof(int64_t)/4]; int16_t int1
 // TWI data register flags
 #define TWI_DT_ACK    15 // r/-: ACK received
 
+// TWI extension registers (command sequencer)
+#define TWI_FCT (*(REG16 0xFF48)) // r/w: sequencer control/status register
+#define TWI_CMD (*(REG16 0xFF4A)) // -/w: command FIFO
+#define TWI_RXD (*(ROM16 0xFF4C)) // r/-: RX FIFO (reading pops one byte)
+//#define reserved (*(REG16 0xFF4E)) // reserved
+
+// TWI sequencer control/status register
+#define TWI_FCT_SEQ_IRQ   0 // r/w: interrupt when command sequence is done
+#define TWI_FCT_CLR       1 // -/w: clear command and RX FIFO and NACK flag
+#define TWI_FCT_SIZE0     5 // r/-: log2(FIFO depth) bit 0
+#define TWI_FCT_SIZE1     6 // r/-: log2(FIFO depth) bit 1
+#define TWI_FCT_SIZE2     7 // r/-: log2(FIFO depth) bit 2
+#define TWI_FCT_CMD_FULL  8 // r/-: command FIFO is full
+#define TWI_FCT_RX_AVAIL  9 // r/-: RX FIFO data available
+#define TWI_FCT_SEQ_BUSY 10 // r/-: command sequence in progress
+#define TWI_FCT_NACK     11 // r/-: NACK received during WRITE command, sequence aborted (STOP generated)
+
+// TWI sequencer commands
+#define TWI_CMD_START     (1<<8) // generate (repeated) START condition
+#define TWI_CMD_STOP      (2<<8) // generate STOP condition
+#define TWI_CMD_WRITE     (3<<8) // send byte (OR with data byte), sample ACK from slave
+#define TWI_CMD_READ_ACK  (4<<8) // receive byte, send ACK
+#define TWI_CMD_READ_NACK (5<<8) // receive byte, send NACK (last byte)
+
+// TWI RX FIFO data register flags
+#define TWI_RXD_VALID 15 // r/-: data valid (RX FIFO was not empty)
+
 
 // ----------------------------------------------------------------------------
 // True Random Number Generator (TRNG)
@@ -426,7 +543,8 @@ union  int64_u { int64_t  int64; int32_t  int32[sizeof(int64_t)/4]; int16_t int1
 // ----------------------------------------------------------------------------
 // External Interrupts Controller (EXIRQ)
 // ----------------------------------------------------------------------------
-#define EXIRQ_CT (*(REG16 0xFFEE)) // r/w: control register
+#define EXIRQ_CT   (*(REG16 0xFFEE)) // r/w: control register
+#define EXIRQ_PRIO (*(REG16 0xFF50)) // r/w: channel priority register (extension register)
 
 // EXIRQ control register
 #define EXIRQ_CT_SEL0         0 // r/w: IRQ source bit 0 / SW_IRQ select
@@ -435,6 +553,7 @@ union  int64_u { int64_t  int64; int32_t  int32[sizeof(int64_t)/4]; int16_t int1
 #define EXIRQ_CT_EN           3 // r/w: unit enable
 #define EXIRQ_CT_SW_IRQ       4 // -/w: use irq_sel as SW IRQ trigger, auto-clears
 #define EXIRQ_CT_ACK_IRQ      5 // -/w: use irq_sel as ACK select, auto-clears
+#define EXIRQ_CT_VEC          6 // r/w: vectored mode: CPU calls handler from IRQVEC_EXTx directly, auto-ACK
 // ...
 #define EXIRQ_CT_IRQ0_EN      8 // r/w: Enable IRQ channel 0
 #define EXIRQ_CT_IRQ1_EN      9 // r/w: Enable IRQ channel 1
@@ -445,6 +564,75 @@ union  int64_u { int64_t  int64; int32_t  int32[sizeof(int64_t)/4]; int16_t int1
 #define EXIRQ_CT_IRQ6_EN     14 // r/w: Enable IRQ channel 6
 #define EXIRQ_CT_IRQ7_EN     15 // r/w: Enable IRQ channel 7
 
+// EXIRQ priority register: set bit n to prefer channel n over all channels without PRIO bit
+// within the same priority level channel 0 has the highest priority
+
+
+// ----------------------------------------------------------------------------
+// Bit Manipulation Unit (BMU)
+// ----------------------------------------------------------------------------
+#define BMU_POPC (*(REG16 0xFF58)) // r/w: write: operand, read: population count of operand
+#define BMU_CLZ  (*(REG16 0xFF5A)) // r/w: write: operand, read: number of leading zeros of operand
+#define BMU_CTZ  (*(REG16 0xFF5C)) // r/w: write: operand, read: number of trailing zeros of operand
+#define BMU_BREV (*(REG16 0xFF5E)) // r/w: write: operand, read: bit-reversed operand
+
+
+// ----------------------------------------------------------------------------
+// Wishbone Slave Port (WBS)
+// ----------------------------------------------------------------------------
+#define WBS_CT    (*(REG16 0xFF68)) // r/w: control register
+#define WBS_DBIN  (*(REG16 0xFF6A)) // r/c: doorbells host -> CPU, write 1 to clear
+#define WBS_DBOUT (*(REG16 0xFF6C)) // r/w: doorbells CPU -> host, write 1 to set (cleared by host)
+
+// WBS control register
+#define WBS_CT_EN      0 // r/w: slave port enable (external DMEM access)
+#define WBS_CT_IRQ_EN  1 // r/w: doorbell interrupt enable (uses the serial IRQ vector)
+#define WBS_CT_BUSY   15 // r/-: external DMEM access in progress
+
+
+// ----------------------------------------------------------------------------
+// Inter-Core Mailbox Port (MBOX) - registers are implemented by the shared neo430_mailbox
+// ----------------------------------------------------------------------------
+#define MBOX_CT   (*(REG16 0xFF70)) // r/w: control/status register
+#define MBOX_DST  (*(REG16 0xFF72)) // r/w: destination core ID of next message
+#define MBOX_TX   (*(REG16 0xFF74)) // -/w: send message (dropped while MBOX_CT_TX_BUSY is set, see MBOX_CT_TX_OVR)
+#define MBOX_RX   (*(REG16 0xFF76)) // r/-: oldest received message, reading removes it
+#define MBOX_SRC  (*(REG16 0xFF78)) // r/-: sender ID of oldest received message
+#define MBOX_LOCK (*(REG16 0xFF7A)) // r/w: write: try to lock semaphore #, read: semaphores owned by this core
+#define MBOX_FREE (*(REG16 0xFF7C)) // r/w: write: release semaphore #, read: all locked semaphores
+#define MBOX_BELL (*(REG16 0xFF7E)) // r/w: write: ring doorbells of cores (mask), read: pending doorbells (cleared)
+
+// MBOX control register
+#define MBOX_CT_RX_IRQ    0 // r/w: fire interrupt when a message has been received
+#define MBOX_CT_DB_IRQ    1 // r/w: fire interrupt when another core rings the doorbell
+#define MBOX_CT_RX_AVAIL  2 // r/-: received message available
+#define MBOX_CT_TX_BUSY   3 // r/-: last message has not been delivered yet (destination FIFO full)
+#define MBOX_CT_TX_OVR    4 // r/c: a message written while TX_BUSY was set has been dropped, write 1 to clear
+#define MBOX_CT_ID0       8 // r/-: own core ID bit 0
+#define MBOX_CT_ID1       9 // r/-: own core ID bit 1
+#define MBOX_CT_ID2      10 // r/-: own core ID bit 2
+#define MBOX_CT_NUM0     12 // r/-: number of cores - 1, bit 0
+#define MBOX_CT_NUM1     13 // r/-: number of cores - 1, bit 1
+#define MBOX_CT_NUM2     14 // r/-: number of cores - 1, bit 2
+
+// MBOX source register
+#define MBOX_SRC_VALID   15 // r/-: message available, sender ID in bits 2:0
+
+
+// ----------------------------------------------------------------------------
+// Banked Far Memory (XMEM)
+// ----------------------------------------------------------------------------
+#define XMEM_BANK  (*(REG16 0xFF38)) // r/w: bank of the far memory mapped to the window (bits 5:0)
+#define XMEM_PTRLO (*(REG16 0xFF3A)) // r/w: far pointer bits 15:0
+#define XMEM_PTRHI (*(REG16 0xFF3C)) // r/w: far pointer bits 19:16 (bits 3:0)
+#define XMEM_DATA  (*(REG16 0xFF3E)) // r/w: word at far pointer, pointer += 2 after each access
+
+// XMEM - 32-bit register access
+#define XMEM_PTR_32bit (*(REG32 (&XMEM_PTRLO))) // r/w: 20-bit far pointer
+
+// XMEM window (XMEM_ADDR_BASE): one bank of the far memory, IMEM is limited to 32kB when XMEM is synthesized
+#define XMEM_WIN_SIZE 0x4000 // window (= bank) size in bytes
+
 
 // ----------------------------------------------------------------------------
 // System Configuration (SYSCONFIG)
@@ -457,6 +645,10 @@ union  int64_u { int64_t  int64; int32_t  int32[sizeof(int64_t)/4]; int16_t int1
 #define CPUID5 (*(ROM16 0xFFFA)) // r/-: DMEM/RAM size in bytes
 #define CPUID6 (*(ROM16 0xFFFC)) // r/-: clock speed (in Hz) low part
 #define CPUID7 (*(ROM16 0xFFFE)) // r/-: clock speed (in Hz) high part
+#define CPUID8 (*(ROM16 0xFF60)) // r/-: peripheral clock speed (in Hz) low part (extension register)
+#define CPUID9 (*(ROM16 0xFF62)) // r/-: peripheral clock speed (in Hz) high part (extension register)
+#define CPUID10 (*(ROM16 0xFF64)) // r/-: hart ID, core ID in multi-core systems (extension register)
+#define CPUID11 (*(ROM16 0xFF66)) // r/-: banked far memory (XMEM) size in kB (extension register)
 
 // Aliases
 #define HW_VERSION    CPUID0 // r/-: HW version number
@@ -467,9 +659,14 @@ union  int64_u { int64_t  int64; int32_t  int32[sizeof(int64_t)/4]; int16_t int1
 #define DMEM_SIZE     CPUID5 // r/-: DMEM/RAM size in bytes
 #define CLOCKSPEED_LO CPUID6 // r/-: clock speed (in Hz) low part
 #define CLOCKSPEED_HI CPUID7 // r/-: clock speed (in Hz) high part
+#define IOCLOCKSPEED_LO CPUID8 // r/-: peripheral clock speed (UART, SPI, TWI, PWM, TIMER, WDT) low part
+#define IOCLOCKSPEED_HI CPUID9 // r/-: peripheral clock speed (UART, SPI, TWI, PWM, TIMER, WDT) high part
+#define HART_ID       CPUID10 // r/-: core ID in multi-core systems (0 = single core / primary core)
+#define XMEM_SIZE_KB  CPUID11 // r/-: banked far memory size in kB
 
 // SysConfig - 32-bit register access
-#define CLOCKSPEED_32bit (*(ROM32 (&CLOCKSPEED_LO))) // r/-: clock speed (in Hz)
+#define CLOCKSPEED_32bit   (*(ROM32 (&CLOCKSPEED_LO)))   // r/-: clock speed (in Hz)
+#define IOCLOCKSPEED_32bit (*(ROM32 (&IOCLOCKSPEED_LO))) // r/-: peripheral clock speed (in Hz)
 
 // SYS features
 #define SYS_MULDIV_EN    0 // r/-: MULDIV synthesized
@@ -493,6 +690,19 @@ union  int64_u { int64_t  int64; int32_t  int32[sizeof(int64_t)/4]; int16_t int1
 #define NX_DSP_MUL_EN   0 // r/-: using DSP-blocks for MULDIV.multiplier
 #define NX_XALU_EN      1 // r/-: implement eXtended ALU functions
 #define NX_LOWPOWER_EN  2 // r/-: use low-power implementation (experimental!)
+#define NX_DADD_EN      3 // r/-: DADD instruction (BCD addition) implemented
+#define NX_XSHIFT_EN    4 // r/-: MSP430X multi-bit shifts (RRCM/RRAM/RLAM/RRUM) and register-mode extension words (RPT, ZC) implemented
+#define NX_PUSHM_EN     5 // r/-: MSP430X multi-register push/pop instructions (PUSHM/POPM) implemented
+#define NX_SHADOW_TIMER 6 // r/-: timer IRQ handler uses shadow register bank
+#define NX_SHADOW_SER   7 // r/-: uart/spi/twi IRQ handler uses shadow register bank
+#define NX_SHADOW_GPIO  8 // r/-: gpio IRQ handler uses shadow register bank
+#define NX_SHADOW_EXT   9 // r/-: external IRQ handler uses shadow register bank
+#define NX_BMU_EN      10 // r/-: bit manipulation unit (BMU) synthesized
+#define NX_IO_CLK_EN   11 // r/-: peripheral devices use separate clock (see IOCLOCKSPEED)
+#define NX_DUAL_RF_EN  12 // r/-: dual-read-port register file (faster register-to-register ALU operations)
+#define NX_WBS_EN      13 // r/-: wishbone slave port (WBS) synthesized
+#define NX_MBOX_EN     14 // r/-: inter-core mailbox port (MBOX) synthesized
+#define NX_XMEM_EN     15 // r/-: banked far memory (XMEM) synthesized
 
 
 // ----------------------------------------------------------------------------
@@ -504,11 +714,14 @@ union  int64_u { int64_t  int64; int32_t  int32[sizeof(int64_t)/4]; int16_t int1
 // ----------------------------------------------------------------------------
 // Include all IO library headers
 // ----------------------------------------------------------------------------
+#include "neo430_bmu.h"
+#include "neo430_cfg.h"
 #include "neo430_cpu.h"
 #include "neo430_crc.h"
 #include "neo430_exirq.h"
 #include "neo430_freq_gen.h"
 #include "neo430_gpio.h"
+#include "neo430_mailbox.h"
 #include "neo430_muldiv.h"
 #include "neo430_pwm.h"
 #include "neo430_spi.h"
@@ -516,8 +729,10 @@ union  int64_u { int64_t  int64; int32_t  int32[sizeof(int64_t)/4]; int16_t int1
 #include "neo430_trng.h"
 #include "neo430_twi.h"
 #include "neo430_uart.h"
+#include "neo430_wbs.h"
 #include "neo430_wdt.h"
 #include "neo430_wishbone.h"
+#include "neo430_xmem.h"
 
 
 #endif // neo430_h
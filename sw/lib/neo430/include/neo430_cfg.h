@@ -0,0 +1,124 @@
+// #################################################################################################
+// #  < neo430_cfg.h - Compile-time peripheral configuration >                                     #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2020, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEO430 Processor - https://github.com/stnolting/neo430                                    #
+// #################################################################################################
+#ifndef neo430_cfg_h
+#define neo430_cfg_h
+
+// Constant expressions that compute peripheral register values at compile time from a known clock
+// frequency. Use these instead of the *_setup / *_config_* / *_set_freq functions (which read the
+// clock speed from the SYSCONFIG module and search the configuration at runtime) if the clock is known.
+// The clock frequencies can be defined via the makefile, e.g.:
+// CC_USER_FLAGS+=-DNEO430_CLOCK_SPEED=100000000UL
+// NEO430_IOCLOCK_SPEED defaults to NEO430_CLOCK_SPEED (no separate peripheral clock).
+// All macros produce constants - no code is generated for the computation.
+
+#if defined(NEO430_CLOCK_SPEED) && !defined(NEO430_IOCLOCK_SPEED)
+  #define NEO430_IOCLOCK_SPEED NEO430_CLOCK_SPEED
+#endif
+
+// Clock prescaler select (0..7) -> right shift relative to CLK/2 (2, 4, 8, 64, 128, 1024, 2048, 4096)
+#define NEO430_CFG_PRSC_SHIFT(p) ((p)==0 ? 0 : (p)==1 ? 1 : (p)==2 ? 2 : (p)==3 ? 5 : (p)==4 ? 6 : (p)==5 ? 9 : (p)==6 ? 10 : 11)
+
+// Smallest prescaler select (0..7) that brings value x (at CLK/2) below limit
+#define NEO430_CFG_PRSC_FIT(x, limit) \
+  ((((x) >> NEO430_CFG_PRSC_SHIFT(0)) < (limit)) ? 0 : \
+   (((x) >> NEO430_CFG_PRSC_SHIFT(1)) < (limit)) ? 1 : \
+   (((x) >> NEO430_CFG_PRSC_SHIFT(2)) < (limit)) ? 2 : \
+   (((x) >> NEO430_CFG_PRSC_SHIFT(3)) < (limit)) ? 3 : \
+   (((x) >> NEO430_CFG_PRSC_SHIFT(4)) < (limit)) ? 4 : \
+   (((x) >> NEO430_CFG_PRSC_SHIFT(5)) < (limit)) ? 5 : \
+   (((x) >> NEO430_CFG_PRSC_SHIFT(6)) < (limit)) ? 6 : 7)
+
+
+// UART: control register value (UART enabled, no IRQs) for baud rate b at peripheral clock f_io
+// same configuration as neo430_uart_setup(b)
+#define NEO430_CFG_UART_DIV(f_io, b) ((uint32_t)(f_io) / (2UL*(uint32_t)(b)))
+#define NEO430_CFG_UART_PRSC(f_io, b) NEO430_CFG_PRSC_FIT(NEO430_CFG_UART_DIV(f_io, b), 256UL)
+#define NEO430_CFG_UART_CT(f_io, b) \
+  ((uint16_t)((1U<<UART_CT_EN) | ((uint16_t)NEO430_CFG_UART_PRSC(f_io, b) << UART_CT_PRSC0) | \
+   ((uint16_t)((NEO430_CFG_UART_DIV(f_io, b) >> NEO430_CFG_PRSC_SHIFT(NEO430_CFG_UART_PRSC(f_io, b))) & 0xFF) << UART_CT_BAUD0)))
+
+
+// TIMER: prescaler select and threshold value for timer (tick) frequency f at peripheral clock f_io
+// same configuration as neo430_timer_config_freq(f, &thres)
+#define NEO430_CFG_TIMER_TICKS(f_io, f) (((uint32_t)(f_io) / (uint32_t)(f)) >> 1)
+#define NEO430_CFG_TIMER_PRSC(f_io, f) NEO430_CFG_PRSC_FIT(NEO430_CFG_TIMER_TICKS(f_io, f), 0x10000UL)
+#define NEO430_CFG_TIMER_THRES(f_io, f) \
+  ((uint16_t)(NEO430_CFG_TIMER_TICKS(f_io, f) >> NEO430_CFG_PRSC_SHIFT(NEO430_CFG_TIMER_PRSC(f_io, f))))
+
+
+// FREQ_GEN: prescaler select and tuning word for NCO output frequency f at main clock f_cpu
+// f_out = ((f_cpu / nco_prsc) * tuning_word[15:0]) / 2^17
+// uses the largest prescaler that keeps the tuning word in 16 bit (= finest resolution), rounded to nearest
+#define NEO430_CFG_FREQ_GEN_TW_RAW(f_cpu, f, p) \
+  ((((uint64_t)(f) << (18 + NEO430_CFG_PRSC_SHIFT(p))) + ((uint32_t)(f_cpu) / 2)) / (uint32_t)(f_cpu))
+#define NEO430_CFG_FREQ_GEN_PRSC(f_cpu, f) \
+  ((NEO430_CFG_FREQ_GEN_TW_RAW(f_cpu, f, 7) <= 0xFFFF) ? 7 : \
+   (NEO430_CFG_FREQ_GEN_TW_RAW(f_cpu, f, 6) <= 0xFFFF) ? 6 : \
+   (NEO430_CFG_FREQ_GEN_TW_RAW(f_cpu, f, 5) <= 0xFFFF) ? 5 : \
+   (NEO430_CFG_FREQ_GEN_TW_RAW(f_cpu, f, 4) <= 0xFFFF) ? 4 : \
+   (NEO430_CFG_FREQ_GEN_TW_RAW(f_cpu, f, 3) <= 0xFFFF) ? 3 : \
+   (NEO430_CFG_FREQ_GEN_TW_RAW(f_cpu, f, 2) <= 0xFFFF) ? 2 : \
+   (NEO430_CFG_FREQ_GEN_TW_RAW(f_cpu, f, 1) <= 0xFFFF) ? 1 : 0)
+#define NEO430_CFG_FREQ_GEN_TW(f_cpu, f) \
+  ((uint16_t)NEO430_CFG_FREQ_GEN_TW_RAW(f_cpu, f, NEO430_CFG_FREQ_GEN_PRSC(f_cpu, f)))
+
+
+// Range checks for constant arguments (the runtime functions fail/saturate instead)
+#define NEO430_CFG_UART_OK(f_io, b) ((NEO430_CFG_UART_DIV(f_io, b) != 0) && \
+  ((NEO430_CFG_UART_DIV(f_io, b) >> NEO430_CFG_PRSC_SHIFT(7)) < 256UL))
+#define NEO430_CFG_TIMER_OK(f_io, f) ((NEO430_CFG_TIMER_TICKS(f_io, f) != 0) && \
+  ((NEO430_CFG_TIMER_TICKS(f_io, f) >> NEO430_CFG_PRSC_SHIFT(7)) < 0x10000UL))
+
+
+// Single-store setup using the compile-time clock frequencies (only available if NEO430_CLOCK_SPEED is defined)
+// Arguments have to be constant expressions; out-of-range values are rejected at compile time.
+#ifdef NEO430_CLOCK_SPEED
+  // enable UART with baud rate b, no IRQs
+  #define NEO430_UART_SETUP(b) do { \
+    _Static_assert(NEO430_CFG_UART_OK(NEO430_IOCLOCK_SPEED, b), "NEO430_UART_SETUP: baud rate out of range"); \
+    UART_CT = 0; \
+    UART_CT = NEO430_CFG_UART_CT(NEO430_IOCLOCK_SPEED, b); \
+  } while(0)
+  // set timer threshold and prescaler for tick frequency f (keeps the other TMR_CT bits)
+  #define NEO430_TIMER_CONFIG_FREQ(f) do { \
+    _Static_assert(NEO430_CFG_TIMER_OK(NEO430_IOCLOCK_SPEED, f), "NEO430_TIMER_CONFIG_FREQ: frequency out of range (f > f_io/2 or too low)"); \
+    TMR_THRES = NEO430_CFG_TIMER_THRES(NEO430_IOCLOCK_SPEED, f); \
+    TMR_CT = (TMR_CT & ~(7<<TMR_CT_PRSC0)) | (NEO430_CFG_TIMER_PRSC(NEO430_IOCLOCK_SPEED, f) << TMR_CT_PRSC0); \
+  } while(0)
+  // set tuning word and prescaler of NCO channel ch for output frequency f
+  #define NEO430_FREQ_GEN_SET_FREQ(ch, f) \
+    neo430_freq_gen_set(ch, NEO430_CFG_FREQ_GEN_TW(NEO430_CLOCK_SPEED, f), NEO430_CFG_FREQ_GEN_PRSC(NEO430_CLOCK_SPEED, f))
+#endif
+
+#endif // neo430_cfg_h
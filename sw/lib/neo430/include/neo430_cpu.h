@@ -35,6 +35,25 @@
 #ifndef neo430_cpu_h
 #define neo430_cpu_h
 
+// Interrupt handler running on the shadow register bank (CPU IRQ channel has to be enabled in
+// shadow_rf_irq_c, check NX_FEATURES): a naked entry that only consists of "call #<name>_body" and "reti",
+// so there is no register save/restore sequence around the body. R4..R15 are banked, R0 (PC), R1 (SP) and
+// R2 (SR) are not. The body is a regular C function (the compiler does not see the asm call, hence "used"),
+// so it may call other functions and use stack locals. Do not re-enable interrupts inside the handler
+// (a nested handler on the same bank would overwrite it).
+#define NEO430_SHADOW_ISR(name) \
+  void __attribute__((used)) name##_body(void); \
+  void __attribute__((naked)) name(void) { asm volatile ("call #" #name "_body \n\t" "reti"); } \
+  void __attribute__((used)) name##_body(void)
+
+// CFU custom instruction "0001 1fff ssss dddd": returns CFU(fn, a, b), fn = 0..7 (requires CFU, check SYS_CFU_EN)
+// operands are passed in r14 (src) and r15 (dst/result)
+#define NEO430_CFU_INSTR(fn, a, b) ({ \
+  register uint16_t _cfu_a asm("r14") = (uint16_t)(a); \
+  register uint16_t _cfu_b asm("r15") = (uint16_t)(b); \
+  asm volatile (".word %c2" : "+r" (_cfu_b) : "r" (_cfu_a), "i" (0x18EF | (((fn) & 7) << 8))); \
+  _cfu_b; })
+
 // prototypes
 void     neo430_critical_start(void);                             // start critical section
 void     neo430_critical_end(void);                               // end critical section
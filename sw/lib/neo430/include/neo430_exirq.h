@@ -42,9 +42,11 @@ struct neo430_exirq_config_t {
 };
 
 // prototypes
-void neo430_exirq_enable(void);                                // activate EXIRQ controller
-void neo430_exirq_disable(void);                               // deactivate EXIRQ controller
-void neo430_exirq_config(struct neo430_exirq_config_t config); // configure EXIRQ controller
-void neo430_exirq_sw_irq(uint8_t id);                          // trigger interrupt by software
+void neo430_exirq_enable(void);                                         // activate EXIRQ controller
+void neo430_exirq_disable(void);                                        // deactivate EXIRQ controller
+void neo430_exirq_config(struct neo430_exirq_config_t config);          // configure EXIRQ controller
+void neo430_exirq_sw_irq(uint8_t id);                                   // trigger interrupt by software
+void neo430_exirq_config_vectored(struct neo430_exirq_config_t config); // configure EXIRQ controller for hardware dispatch
+void neo430_exirq_set_priority(uint8_t prio);                           // select high-priority channels
 
 #endif // neo430_exirq_h
@@ -0,0 +1,52 @@
+// #################################################################################################
+// #  < neo430_mailbox.h - Inter-core mailbox (multi-core cluster) functions >                     #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2020, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEO430 Processor - https://github.com/stnolting/neo430                                    #
+// #################################################################################################
+
+#ifndef neo430_mailbox_h
+#define neo430_mailbox_h
+
+// prototypes
+uint16_t neo430_mailbox_available(void);                          // check if MBOX port was synthesized
+uint8_t  neo430_mailbox_core_id(void);                            // get own core ID
+uint8_t  neo430_mailbox_num_cores(void);                          // get number of cores in cluster
+void     neo430_mailbox_irq_config(uint8_t rx_en, uint8_t db_en); // configure message/doorbell interrupts
+void     neo430_mailbox_send(uint8_t dst, uint16_t msg);          // send message to core
+uint16_t neo430_mailbox_avail(void);                              // check for received messages
+uint16_t neo430_mailbox_receive(uint8_t *src);                    // wait for and get next message
+uint8_t  neo430_mailbox_trylock(uint8_t sem);                     // try to lock semaphore
+void     neo430_mailbox_lock(uint8_t sem);                        // wait until semaphore is locked
+void     neo430_mailbox_unlock(uint8_t sem);                      // release semaphore
+void     neo430_mailbox_ring(uint8_t mask);                       // ring doorbells of other cores
+uint8_t  neo430_mailbox_get_doorbells(void);                      // get and clear pending doorbells
+
+#endif // neo430_mailbox_h
@@ -41,5 +41,10 @@ void     neo430_spi_disable(void);          // deactivate SPI module
 void     neo430_spi_cs_en(uint8_t cs);      // select slave
 void     neo430_spi_cs_dis(void);           // deselect all slaves
 uint16_t neo430_spi_trans(uint16_t d);      // RTX transfer
+uint16_t neo430_spi_fifo_size(void);        // get TX/RX FIFO depth
+void     neo430_spi_write_block(const uint8_t *data, uint16_t num);                       // send data block
+void     neo430_spi_read_block(uint8_t *data, uint16_t num);                              // receive data block
+void     neo430_spi_trans_block(const uint8_t *tx_data, uint8_t *rx_data, uint16_t num); // full-duplex block transfer
+void     neo430_spi_io_config(uint8_t dq_en, uint8_t mode); // configure data lines (single/dual/quad)
 
 #endif // neo430_spi_h
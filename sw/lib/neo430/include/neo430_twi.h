@@ -45,5 +45,9 @@ uint8_t neo430_twi_trans(uint8_t d);       // send byte to active slave
 uint8_t neo430_twi_get_data(void);         // get last received data byte
 void    neo430_twi_generate_stop(void);    // stop transmission (STOP)
 void    neo430_twi_generate_start(void);   // generate start condition
+uint16_t neo430_twi_fifo_size(void);       // get command/RX FIFO depth
+uint8_t neo430_twi_read_regs(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t n); // read n registers from slave (blocking)
+uint8_t neo430_twi_read_regs_start(uint8_t addr, uint8_t reg, uint8_t n);          // start register read sequence (non-blocking)
+uint8_t neo430_twi_read_regs_get(uint8_t *buf, uint8_t n);                         // get data of completed read sequence
 
 #endif // neo430_twi_h
@@ -57,7 +57,9 @@ void neo430_uart_print_hex_qword(uint64_t qw);
 void neo430_uart_print_bin_byte(uint8_t b);                                             // print byte in binary form
 void neo430_uart_print_bin_word(uint16_t w);                                            // print word in binary form
 void neo430_uart_print_bin_dword(uint32_t dw);                                          // print double word in binary form
+uint16_t neo430_utoa(uint32_t x, uint16_t min_digits, char *res);                       // convert double word to decimal number (formatting core)
 void neo430_itoa(uint32_t x, uint16_t leading_zeros, char *res);                        // convert double word to decimal number
+void neo430_bin2bcd(uint32_t x, uint16_t *bcd);                                         // convert double word to BCD using DADD
 void neo430_printf(char *format, ...);                                                  // print format string
 uint32_t neo430_hexstr_to_uint(char *buffer, uint8_t length);                           // convert hex string to number
 void neo430_uart_bs(uint16_t n);                                                        // return terminal cursor n positions
@@ -0,0 +1,56 @@
+// #################################################################################################
+// #  < neo430_xmem.h - Banked far memory (XMEM) functions >                                       #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2020, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEO430 Processor - https://github.com/stnolting/neo430                                    #
+// #################################################################################################
+#ifndef neo430_xmem_h
+#define neo430_xmem_h
+
+// place (uninitialized) variables in the XMEM window, e.g. "uint16_t table[1024] NEO430_XMEM;"
+// these variables are located in the currently selected bank (bank 0 after crt0) and are not cleared by crt0
+#define NEO430_XMEM __attribute__((section(".xmem")))
+
+// place initialized variables in the XMEM window (bank 0), e.g. "uint16_t coeff[4] NEO430_XMEM_DATA = {1, 2, 3, 4};"
+// the initial values are part of the executable (IMEM) and are copied to bank 0 by crt0 - no code in XMEM
+#define NEO430_XMEM_DATA __attribute__((section(".xmem_data")))
+
+// prototypes
+uint16_t neo430_xmem_available(void);                                               // check if XMEM was synthesized
+uint32_t neo430_xmem_size(void);                                                    // get far memory size in bytes
+void     neo430_xmem_set_bank(uint8_t bank);                                        // select bank mapped to the window
+uint8_t  neo430_xmem_get_bank(void);                                                // get bank mapped to the window
+void    *neo430_xmem_map(uint32_t addr);                                            // map far address into window
+uint16_t neo430_xmem_read16(uint32_t addr);                                         // read word via far pointer
+void     neo430_xmem_write16(uint32_t addr, uint16_t data);                         // write word via far pointer
+void     neo430_xmem_read_block(uint32_t addr, uint16_t *dst, uint16_t num);        // copy words from far memory
+void     neo430_xmem_write_block(uint32_t addr, const uint16_t *src, uint16_t num); // copy words to far memory
+
+#endif // neo430_xmem_h
@@ -0,0 +1,167 @@
+// #################################################################################################
+// #  < neo430_bmu.c - Bit manipulation unit helper functions >                                    #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2020, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEO430 Processor - https://github.com/stnolting/neo430                                    #
+// #################################################################################################
+
+#include "neo430.h"
+#include "neo430_bmu.h"
+
+// Private variables
+static uint8_t __neo430_bmu_state = 0; // 0: not checked yet, 1: BMU not available, 2: BMU available
+
+
+/* ------------------------------------------------------------
+ * INFO Check if BMU was synthesized (the result is cached)
+ * RETURN 0 if BMU is not implemented, non-zero if BMU is available
+ * ------------------------------------------------------------ */
+uint16_t neo430_bmu_available(void) {
+
+  if (__neo430_bmu_state == 0) {
+    __neo430_bmu_state = (NX_FEATURES & (1<<NX_BMU_EN)) ? 2 : 1;
+  }
+  return (uint16_t)(__neo430_bmu_state - 1);
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Execute BMU operation; the operand register is shared by
+ * all BMU functions, so the operand write and the result read are
+ * done with interrupts disabled (interrupt handlers may use the BMU)
+ * PARAM reg: BMU result register (e.g. &BMU_POPC)
+ * PARAM x: Input operand
+ * RETURN BMU result
+ * ------------------------------------------------------------ */
+uint16_t neo430_bmu_exe(volatile uint16_t *reg, uint16_t x) {
+
+  register uint16_t sreg, res;
+  asm volatile ("mov r2, %0 \n dint \n nop" : "=r" (sreg) : : "memory"); // save SREG, disable IRQs
+  *reg = x;
+  res = *reg;
+  asm volatile ("mov %0, r2" : : "r" (sreg) : "memory"); // restore SREG (and original GIE)
+  return res;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Population count, uses BMU if available
+ * PARAM x: Input operand
+ * RETURN Number of set bits in x
+ * ------------------------------------------------------------ */
+uint16_t neo430_popcount(uint16_t x) {
+
+  if (neo430_bmu_available()) {
+    return neo430_bmu_exe(&BMU_POPC, x);
+  }
+
+  uint16_t cnt = 0;
+  while (x) { // one iteration per set bit
+    x &= x - 1;
+    cnt++;
+  }
+  return cnt;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Count leading zeros, uses BMU if available
+ * PARAM x: Input operand
+ * RETURN Number of leading zeros in x (16 if x is zero)
+ * ------------------------------------------------------------ */
+uint16_t neo430_clz(uint16_t x) {
+
+  if (neo430_bmu_available()) {
+    return neo430_bmu_exe(&BMU_CLZ, x);
+  }
+
+  if (x == 0)
+    return 16;
+
+  uint16_t cnt = 0;
+  if ((x & 0xFF00) == 0) {
+    cnt += 8;
+    x = x << 8;
+  }
+  while ((x & 0x8000) == 0) {
+    cnt++;
+    x = x << 1;
+  }
+  return cnt;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Count trailing zeros, uses BMU if available
+ * PARAM x: Input operand
+ * RETURN Number of trailing zeros in x (16 if x is zero)
+ * ------------------------------------------------------------ */
+uint16_t neo430_ctz(uint16_t x) {
+
+  if (neo430_bmu_available()) {
+    return neo430_bmu_exe(&BMU_CTZ, x);
+  }
+
+  if (x == 0)
+    return 16;
+
+  uint16_t cnt = 0;
+  if ((x & 0x00FF) == 0) {
+    cnt += 8;
+    x = x >> 8;
+  }
+  while ((x & 0x0001) == 0) {
+    cnt++;
+    x = x >> 1;
+  }
+  return cnt;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Count leading zeros of a byte, uses BMU if available
+ * PARAM x: Input operand
+ * RETURN Number of leading zeros in x (8 if x is zero)
+ * ------------------------------------------------------------ */
+uint16_t neo430_clz8(uint8_t x) {
+
+  return neo430_clz((uint16_t)x) - 8;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Byte bit reversal, uses BMU if available
+ * PARAM x: Input operand
+ * RETURN Reversed bit pattern of x
+ * ------------------------------------------------------------ */
+uint8_t neo430_bit_rev8(uint8_t x) {
+
+  return (uint8_t)(neo430_bit_rev16((uint16_t)x) >> 8);
+}
@@ -288,12 +288,16 @@ void neo430_memcpy(uint8_t *dst, uint8_t *src, uint16_t num) {
 
 
 /* ------------------------------------------------------------
- * INFO 16-bit bit reversal
+ * INFO 16-bit bit reversal, uses BMU if available
  * PARAM input operand to be reversed
  * RETURN reversed bit pattern
  * ------------------------------------------------------------ */
 uint16_t neo430_bit_rev16(uint16_t x) {
 
+  if (neo430_bmu_available()) {
+    return neo430_bmu_exe(&BMU_BREV, x);
+  }
+
   register uint16_t z = x;
   register uint16_t y = 0;
   uint8_t i = 0;
@@ -88,6 +88,44 @@ void neo430_exirq_config(struct neo430_exirq_config_t config) {
 }
 
 
+/* ------------------------------------------------------------
+ * INFO Configure external interrupts controller for vectored mode
+ * INFO The CPU directly calls the channel's handler (no software dispatcher)
+ * INFO and the interrupt is acknowledged automatically by the vector fetch.
+ * INFO Handlers have to be interrupt functions (__attribute__((__interrupt__)))!
+ * PARAM Struct containing the handler functions addresses and the channel enable bits
+ * ------------------------------------------------------------ */
+void neo430_exirq_config_vectored(struct neo430_exirq_config_t config) {
+
+  // reset controller
+  EXIRQ_CT = 0;
+
+  // setup hardware vector table
+  IRQVEC_EXT0 = config.address[0];
+  IRQVEC_EXT1 = config.address[1];
+  IRQVEC_EXT2 = config.address[2];
+  IRQVEC_EXT3 = config.address[3];
+  IRQVEC_EXT4 = config.address[4];
+  IRQVEC_EXT5 = config.address[5];
+  IRQVEC_EXT6 = config.address[6];
+  IRQVEC_EXT7 = config.address[7];
+
+  // configure channel enables and vectored mode
+  uint16_t enable = (uint16_t)config.enable;
+  EXIRQ_CT = (enable<<EXIRQ_CT_IRQ0_EN) | (1<<EXIRQ_CT_VEC);
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Configure channel priorities
+ * PARAM prio: bit n set = channel n is preferred over all channels without PRIO bit
+ * ------------------------------------------------------------ */
+void neo430_exirq_set_priority(uint8_t prio) {
+
+  EXIRQ_PRIO = (uint16_t)prio;
+}
+
+
 /* ------------------------------------------------------------
  * INFO Trigger IRQ channel by software
  * PARAM id (0..7) indicating which (ENABLED!) channel shall be triggered
@@ -42,7 +42,7 @@
  * ------------------------------------------------------------ */
 void neo430_gpio_pin_set(uint8_t p) {
 
-  GPIO_OUTPUT = GPIO_OUTPUT | (uint16_t)(1 << p);
+  BITBAND(GPIO_OUTPUT, p) = 1;
 }
 
 
@@ -52,7 +52,7 @@ void neo430_gpio_pin_set(uint8_t p) {
  * ------------------------------------------------------------ */
 void neo430_gpio_pin_clr(uint8_t p) {
 
-  GPIO_OUTPUT = GPIO_OUTPUT & ~((uint16_t)(1 << p));
+  BITBAND(GPIO_OUTPUT, p) = 0;
 }
 
 
@@ -72,7 +72,7 @@ void neo430_gpio_port_set(uint16_t d) {
  * ------------------------------------------------------------ */
 void neo430_gpio_port_toggle(uint16_t d) {
 
-  GPIO_OUTPUT = GPIO_OUTPUT ^ d;
+  GPIO_OUTPUT_TGL = d;
 }
 
 
@@ -82,7 +82,7 @@ void neo430_gpio_port_toggle(uint16_t d) {
  * ------------------------------------------------------------ */
 void neo430_gpio_pin_toggle(uint8_t p) {
 
-  GPIO_OUTPUT = GPIO_OUTPUT ^ (uint16_t)(1 << p);
+  GPIO_OUTPUT_TGL = (uint16_t)(1 << p);
 }
 
 
@@ -93,7 +93,7 @@ void neo430_gpio_pin_toggle(uint8_t p) {
  * ------------------------------------------------------------ */
 uint16_t neo430_gpio_pin_get(uint8_t p) {
 
-  return GPIO_INPUT & (uint16_t)(1 << p);
+  return (uint16_t)BITBAND(GPIO_INPUT, p);
 }
 
 
@@ -0,0 +1,173 @@
+// #################################################################################################
+// #  < neo430_mailbox.c - Inter-core mailbox (multi-core cluster) functions >                     #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2020, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEO430 Processor - https://github.com/stnolting/neo430                                    #
+// #################################################################################################
+
+#include "neo430.h"
+#include "neo430_mailbox.h"
+
+
+/* ------------------------------------------------------------
+ * INFO Check if inter-core mailbox port was synthesized
+ * RETURN 0 if MBOX is not implemented, non-zero if MBOX is available
+ * ------------------------------------------------------------ */
+uint16_t neo430_mailbox_available(void) {
+
+  return (NX_FEATURES & (1<<NX_MBOX_EN));
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Get ID of this core (position at the mailbox)
+ * RETURN Core ID (0..7)
+ * ------------------------------------------------------------ */
+uint8_t neo430_mailbox_core_id(void) {
+
+  return (uint8_t)((MBOX_CT >> MBOX_CT_ID0) & 7);
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Get number of cores attached to the mailbox
+ * RETURN Number of cores (1..8)
+ * ------------------------------------------------------------ */
+uint8_t neo430_mailbox_num_cores(void) {
+
+  return (uint8_t)(((MBOX_CT >> MBOX_CT_NUM0) & 7) + 1);
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Configure mailbox interrupts (using the serial IRQ vector)
+ * PARAM rx_en: Fire interrupt when a message has been received if not zero
+ * PARAM db_en: Fire interrupt when another core rings the doorbell if not zero
+ * ------------------------------------------------------------ */
+void neo430_mailbox_irq_config(uint8_t rx_en, uint8_t db_en) {
+
+  uint16_t ct = 0;
+  if (rx_en)
+    ct |= (1<<MBOX_CT_RX_IRQ);
+  if (db_en)
+    ct |= (1<<MBOX_CT_DB_IRQ);
+  MBOX_CT = ct;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Send message to another core (or to itself). Waits until the
+ * INFO previous message has been delivered to its destination FIFO.
+ * PARAM dst: Destination core ID
+ * PARAM msg: 16-bit message
+ * ------------------------------------------------------------ */
+void neo430_mailbox_send(uint8_t dst, uint16_t msg) {
+
+  while (MBOX_CT & (1<<MBOX_CT_TX_BUSY)); // wait for delivery of last message
+  MBOX_DST = (uint16_t)dst;
+  MBOX_TX = msg;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Check if a message has been received
+ * RETURN 0 if no message is available, non-zero otherwise
+ * ------------------------------------------------------------ */
+uint16_t neo430_mailbox_avail(void) {
+
+  return (MBOX_CT & (1<<MBOX_CT_RX_AVAIL));
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Wait for a message and remove it from the receive FIFO
+ * PARAM src: Pointer to store the sender's core ID to (may be NULL)
+ * RETURN Received message
+ * ------------------------------------------------------------ */
+uint16_t neo430_mailbox_receive(uint8_t *src) {
+
+  uint16_t s;
+  while ((s = MBOX_SRC) == 0); // wait for message (MBOX_SRC_VALID)
+  if (src != 0)
+    *src = (uint8_t)(s & 7);
+  return MBOX_RX;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Try to lock a hardware semaphore
+ * PARAM sem: Semaphore number (0..15)
+ * RETURN 1 if this core owns the semaphore now, 0 if it is locked by another core
+ * ------------------------------------------------------------ */
+uint8_t neo430_mailbox_trylock(uint8_t sem) {
+
+  MBOX_LOCK = (uint16_t)sem;
+  return (uint8_t)((MBOX_LOCK >> (sem & 15)) & 1);
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Wait until a hardware semaphore is locked by this core
+ * PARAM sem: Semaphore number (0..15)
+ * ------------------------------------------------------------ */
+void neo430_mailbox_lock(uint8_t sem) {
+
+  while (neo430_mailbox_trylock(sem) == 0);
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Release a hardware semaphore (ignored if not owned by this core)
+ * PARAM sem: Semaphore number (0..15)
+ * ------------------------------------------------------------ */
+void neo430_mailbox_unlock(uint8_t sem) {
+
+  MBOX_FREE = (uint16_t)sem;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Ring doorbells of other cores (cross-core interrupt)
+ * PARAM mask: Bit n set = ring doorbell of core n
+ * ------------------------------------------------------------ */
+void neo430_mailbox_ring(uint8_t mask) {
+
+  MBOX_BELL = (uint16_t)mask;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Get and clear pending doorbells
+ * RETURN Bit n set = doorbell rung by core n
+ * ------------------------------------------------------------ */
+uint8_t neo430_mailbox_get_doorbells(void) {
+
+  return (uint8_t)MBOX_BELL;
+}
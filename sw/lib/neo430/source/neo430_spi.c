@@ -71,7 +71,7 @@ void neo430_spi_disable(void) {
  * ------------------------------------------------------------ */
 void neo430_spi_cs_en(uint8_t cs) {
 
-  SPI_CT |= 1 << (cs+SPI_CT_CS_SEL0);
+  BITBAND(SPI_CT, cs+SPI_CT_CS_SEL0) = 1;
 }
 
 
@@ -80,7 +80,7 @@ void neo430_spi_cs_en(uint8_t cs) {
  * ------------------------------------------------------------ */
 void neo430_spi_cs_dis(void) {
 
-  SPI_CT &= ~(0b111111 << SPI_CT_CS_SEL0); // clear all 6 CS lines
+  SPI_CT_CLR = 0b111111 << SPI_CT_CS_SEL0; // clear all 6 CS lines
 }
 
 
@@ -96,3 +96,99 @@ uint16_t neo430_spi_trans(uint16_t d) {
 
   return SPI_RTX;
 }
+
+
+/* ------------------------------------------------------------
+ * INFO Get SPI TX/RX FIFO depth
+ * RETURN FIFO depth in frames
+ * ------------------------------------------------------------ */
+uint16_t neo430_spi_fifo_size(void) {
+
+  return 1 << ((SPI_FCT >> SPI_FCT_SIZE0) & 7);
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Send data block (8-bit frames), received data is discarded (RX FIFO disabled)
+ * INFO The selected CS line stays active during the whole transfer
+ * PARAM data pointer to source data
+ * PARAM num number of bytes to send
+ * ------------------------------------------------------------ */
+void neo430_spi_write_block(const uint8_t *data, uint16_t num) {
+
+  while (num) {
+    if ((SPI_FCT & (1<<SPI_FCT_TX_FULL)) == 0) { // free entry in TX FIFO?
+      SPI_RTX = (uint16_t)(*data++);
+      num--;
+    }
+  }
+  while((SPI_CT & (1<<SPI_CT_BUSY)) != 0); // wait for all frames to be sent
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Receive data block (8-bit frames), dummy frames (0xFF) are generated by hardware
+ * INFO The selected CS line stays active during the whole transfer
+ * PARAM data pointer to destination buffer
+ * PARAM num number of bytes to receive
+ * ------------------------------------------------------------ */
+void neo430_spi_read_block(uint8_t *data, uint16_t num) {
+
+  SPI_FCT |= (1<<SPI_FCT_RX_EN) | (1<<SPI_FCT_RX_CLR); // enable RX FIFO, discard old data
+  SPI_TLEN = num; // start burst - hardware stalls if RX FIFO is full
+
+  while (num) {
+    if ((SPI_FCT & (1<<SPI_FCT_RX_AVAIL)) != 0) { // data available?
+      *data++ = (uint8_t)SPI_RTX;
+      num--;
+    }
+  }
+
+  SPI_FCT &= ~(1<<SPI_FCT_RX_EN); // back to single transfer mode
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Full-duplex data block transfer (8-bit frames)
+ * INFO The selected CS line stays active during the whole transfer
+ * PARAM tx_data pointer to source data
+ * PARAM rx_data pointer to destination buffer
+ * PARAM num number of bytes to transfer
+ * ------------------------------------------------------------ */
+void neo430_spi_trans_block(const uint8_t *tx_data, uint8_t *rx_data, uint16_t num) {
+
+  uint16_t depth = neo430_spi_fifo_size();
+  uint16_t tx_num = num;
+  uint16_t pending = 0; // sent but not yet read frames
+  uint16_t status;
+
+  SPI_FCT |= (1<<SPI_FCT_RX_EN) | (1<<SPI_FCT_RX_CLR); // enable RX FIFO, discard old data
+
+  while (num) {
+    status = SPI_FCT;
+    if ((tx_num) && (pending < depth)) { // never send more frames than the RX FIFO can hold
+      SPI_RTX = (uint16_t)(*tx_data++);
+      tx_num--;
+      pending++;
+    }
+    if ((status & (1<<SPI_FCT_RX_AVAIL)) != 0) { // data available?
+      *rx_data++ = (uint8_t)SPI_RTX;
+      pending--;
+      num--;
+    }
+  }
+
+  SPI_FCT &= ~(1<<SPI_FCT_RX_EN); // back to single transfer mode
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Configure SPI data lines
+ * INFO Only change the mode while the SPI is idle (!SPI_CT_BUSY)
+ * PARAM dq_en 0: use spi_mosi_o/spi_miso_i, 1: use bidirectional spi_dq_io lines
+ * PARAM mode data line mode, see SPI_IO_* (dual/quad modes require dq_en = 1)
+ * ------------------------------------------------------------ */
+void neo430_spi_io_config(uint8_t dq_en, uint8_t mode) {
+
+  SPI_QCT = ((uint16_t)(dq_en & 1) << SPI_QCT_DQ_EN) | ((uint16_t)(mode & 7) << SPI_QCT_MODE0);
+}
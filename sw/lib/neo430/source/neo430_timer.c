@@ -41,7 +41,7 @@
  * ------------------------------------------------------------ */
 void neo430_timer_enable(void) {
 
-  TMR_CT |= (1<<TMR_CT_EN);
+  TMR_CT_SET = (1<<TMR_CT_EN);
 }
 
 
@@ -59,7 +59,7 @@ void neo430_timer_disable(void) {
  * ------------------------------------------------------------ */
 void neo430_timer_run(void) {
 
-  TMR_CT |= (1<<TMR_CT_RUN);
+  TMR_CT_SET = (1<<TMR_CT_RUN);
 }
 
 
@@ -68,18 +68,18 @@ void neo430_timer_run(void) {
  * ------------------------------------------------------------ */
 void neo430_timer_pause(void) {
 
-  TMR_CT &= ~(1<<TMR_CT_RUN);
+  TMR_CT_CLR = (1<<TMR_CT_RUN);
 }
 
 
 /* ------------------------------------------------------------
  * INFO Configure timer period
- * PARAM Timer frequency in Hz (1 ... F_CPU/2), uint16_t pointer to store computed THRES value
+ * PARAM Timer frequency in Hz (1 ... F_IO/2, F_IO = peripheral clock), uint16_t pointer to store computed THRES value
  * RETURN 0 if successful, 0xff if error
  * ------------------------------------------------------------ */
 uint8_t neo430_timer_config_freq(uint32_t f_timer, uint16_t *thres) {
 
-  uint32_t clock = CLOCKSPEED_32bit;
+  uint32_t clock = IOCLOCKSPEED_32bit;
   uint32_t ticks = (clock / f_timer) >> 1; // divide by lowest prescaler (= f/2)
 
   uint8_t prsc = 0;
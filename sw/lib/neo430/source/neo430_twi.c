@@ -141,3 +141,127 @@ void neo430_twi_generate_start(void) {
   TWI_CT |= (1 << TWI_CT_START); // generate START condition
   while(TWI_CT & (1 << TWI_CT_BUSY)); // wait until idle again
 }
+
+
+/* ------------------------------------------------------------
+ * INFO Read consecutive registers from slave using the command sequencer (blocking)
+ * INFO START, addr+W, reg, repeated START, addr+R, n x READ, STOP
+ * PARAM addr 7-bit slave address
+ * PARAM reg address of first register
+ * PARAM buf pointer to destination buffer
+ * PARAM n number of registers to read (>0)
+ * RETURN 0 if successful, 1 if slave did not respond (NACK, FIFOs are cleared and bus is released)
+ * ------------------------------------------------------------ */
+uint8_t neo430_twi_read_regs(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t n) {
+
+  uint16_t cmd_cnt = n + 1; // n reads + STOP
+  uint16_t d;
+
+  TWI_FCT |= (1 << TWI_FCT_CLR); // clear FIFOs and error flag
+
+  TWI_CMD = TWI_CMD_START;
+  TWI_CMD = TWI_CMD_WRITE | ((uint16_t)addr << 1); // write access
+  TWI_CMD = TWI_CMD_WRITE | (uint16_t)reg;
+  TWI_CMD = TWI_CMD_START;
+  TWI_CMD = TWI_CMD_WRITE | ((uint16_t)addr << 1) | 1; // read access
+
+  while (n) {
+    // sequence aborted? check before queueing any further command
+    if (TWI_FCT & (1 << TWI_FCT_NACK)) {
+      TWI_FCT |= (1 << TWI_FCT_CLR); // discard pending commands and data
+      TWI_CMD = TWI_CMD_STOP; // make sure the bus is released
+      while(TWI_FCT & (1 << TWI_FCT_SEQ_BUSY)); // wait until STOP is done
+      return 1;
+    }
+    // feed command FIFO
+    if ((cmd_cnt) && ((TWI_FCT & (1 << TWI_FCT_CMD_FULL)) == 0)) {
+      if (cmd_cnt == 1)
+        TWI_CMD = TWI_CMD_STOP;
+      else if (cmd_cnt == 2)
+        TWI_CMD = TWI_CMD_READ_NACK; // last byte
+      else
+        TWI_CMD = TWI_CMD_READ_ACK;
+      cmd_cnt--;
+    }
+    // get data
+    d = TWI_RXD;
+    if (d & (1 << TWI_RXD_VALID)) {
+      *buf++ = (uint8_t)d;
+      n--;
+    }
+  }
+
+  if (cmd_cnt) { // STOP not queued yet
+    TWI_CMD = TWI_CMD_STOP;
+  }
+  while(TWI_FCT & (1 << TWI_FCT_SEQ_BUSY)); // wait until STOP is done
+
+  return 0;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Get TWI command/RX FIFO depth
+ * RETURN FIFO depth in entries
+ * ------------------------------------------------------------ */
+uint16_t neo430_twi_fifo_size(void) {
+
+  return 1 << ((TWI_FCT >> TWI_FCT_SIZE0) & 7);
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Start register read sequence without waiting for completion
+ * INFO Enable TWI_FCT_SEQ_IRQ to get an interrupt when the sequence is done
+ * PARAM addr 7-bit slave address
+ * PARAM reg address of first register
+ * PARAM n number of registers to read (1..command FIFO depth - 6)
+ * RETURN 0 if sequence was started, 1 if command FIFO is too small (nothing is queued in this case)
+ * ------------------------------------------------------------ */
+uint8_t neo430_twi_read_regs_start(uint8_t addr, uint8_t reg, uint8_t n) {
+
+  // check size before queueing anything: 5 commands for addressing + n reads + STOP
+  if ((n == 0) || (((uint16_t)n + 6) > neo430_twi_fifo_size())) {
+    return 1;
+  }
+
+  while(TWI_FCT & (1 << TWI_FCT_SEQ_BUSY)); // wait until previous sequence is done (bus released)
+  TWI_FCT |= (1 << TWI_FCT_CLR); // clear FIFOs and error flag
+
+  TWI_CMD = TWI_CMD_START;
+  TWI_CMD = TWI_CMD_WRITE | ((uint16_t)addr << 1); // write access
+  TWI_CMD = TWI_CMD_WRITE | (uint16_t)reg;
+  TWI_CMD = TWI_CMD_START;
+  TWI_CMD = TWI_CMD_WRITE | ((uint16_t)addr << 1) | 1; // read access
+
+  while (n) {
+    if (n == 1)
+      TWI_CMD = TWI_CMD_READ_NACK; // last byte
+    else
+      TWI_CMD = TWI_CMD_READ_ACK;
+    n--;
+  }
+  TWI_CMD = TWI_CMD_STOP;
+
+  return 0;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Get data of a completed register read sequence
+ * PARAM buf pointer to destination buffer
+ * PARAM n number of registers to read (same as for neo430_twi_read_regs_start)
+ * RETURN 0 if successful, 1 if slave did not respond (NACK)
+ * ------------------------------------------------------------ */
+uint8_t neo430_twi_read_regs_get(uint8_t *buf, uint8_t n) {
+
+  if (TWI_FCT & (1 << TWI_FCT_NACK)) {
+    return 1;
+  }
+
+  while (n--) {
+    *buf++ = (uint8_t)TWI_RXD;
+  }
+
+  return 0;
+}
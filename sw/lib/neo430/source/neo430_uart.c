@@ -38,7 +38,7 @@
 
 /* ------------------------------------------------------------
  * INFO Reset UART, set the Baud rate of UART transceiver
- * INFO UART_BAUD reg (8 bit) = f_main/(prsc*desired_BAUDRATE)
+ * INFO UART_BAUD reg (8 bit) = f_io/(prsc*desired_BAUDRATE), f_io = peripheral clock
  * INFO PRSC (Baud register bits 10..8):
  *  0: CLK/2
  *  1: CLK/4
@@ -52,17 +52,16 @@
  * ------------------------------------------------------------ */
 void neo430_uart_setup(uint32_t baudrate){
 
-  // raw baud rate prescaler
-  uint32_t clock = CLOCKSPEED_32bit;
-  uint16_t i = 0; // BAUD rate divisor
+  // raw baud rate prescaler (see NEO430_CFG_UART_CT in neo430_cfg.h for a compile-time alternative)
+  uint32_t i = IOCLOCKSPEED_32bit / (2*baudrate); // BAUD rate divisor
   uint8_t p = 0; // prsc = CLK/2
-  while (clock >= 2*baudrate) {
-    clock -= 2*baudrate;
-    i++;
-  }
 
   // find clock prsc
   while (i >= 256) {
+    if (p == 7) { // largest prescaler, saturate divisor
+      i = 255;
+      break;
+    }
     if ((p == 2) || (p == 4))
       i >>= 3;
     else
@@ -71,7 +70,7 @@ void neo430_uart_setup(uint32_t baudrate){
   }
 
   UART_CT = 0;
-  UART_CT = (1<<UART_CT_EN) | ((uint16_t)p << UART_CT_PRSC0) | (i << UART_CT_BAUD0);
+  UART_CT = (1<<UART_CT_EN) | ((uint16_t)p << UART_CT_PRSC0) | ((uint16_t)i << UART_CT_BAUD0);
 }
 
 
@@ -90,7 +89,7 @@ void neo430_uart_disable(void){
 uint32_t neo430_uart_get_baudrate(void) {
 
   // Clock speed
-  uint32_t clock = CLOCKSPEED_32bit;
+  uint32_t clock = IOCLOCKSPEED_32bit;
 
   // prescaler
   uint16_t prsc;
@@ -356,44 +355,143 @@ void neo430_uart_print_bin_dword(uint32_t dw) {
 }
 
 
+/* ------------------------------------------------------------
+ * INFO Convert 32-bit number into 10 BCD digits (double dabble)
+ * INFO Uses the DADD instruction: bcd = bcd + bcd + carry for each bit
+ * INFO Only use this function if the DADD instruction is implemented (NX_DADD_EN)!
+ * PARAM 32-bit value to be converted
+ * PARAM pointer to array (3 elements) to store the BCD result, LSD first
+ * ------------------------------------------------------------ */
+void neo430_bin2bcd(uint32_t x, uint16_t *bcd) {
+
+  register uint16_t lo = (uint16_t)x;
+  register uint16_t hi = (uint16_t)(x >> 16);
+  register uint16_t b0 = 0, b1 = 0, b2 = 0;
+  register uint16_t i = 32;
+
+  asm volatile (
+    "1:                 \n"
+    " rla  %[lo]        \n" // shift MSB of binary input into carry
+    " rlc  %[hi]        \n"
+    " dadd %[b0], %[b0] \n" // bcd = 2*bcd + carry
+    " dadd %[b1], %[b1] \n"
+    " dadd %[b2], %[b2] \n"
+    " dec  %[i]         \n"
+    " jnz  1b           \n"
+    : [lo] "+r" (lo), [hi] "+r" (hi), [b0] "+r" (b0), [b1] "+r" (b1), [b2] "+r" (b2), [i] "+r" (i)
+    :
+    : "cc"
+  );
+
+  bcd[0] = b0;
+  bcd[1] = b1;
+  bcd[2] = b2;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Convert 32-bit number into decimal string (division-free)
+ * INFO Uses BCD conversion if the DADD instruction is available,
+ * INFO subtraction of powers of ten otherwise (16-bit only for
+ * INFO values < 65536). Digits are generated MSD first.
+ * PARAM 32-bit value to be converted
+ * PARAM minimum number of digits (1..10), padded with leading zeros
+ * PARAM pointer to array (11 elements!!!) to store conversion result string
+ * RETURN Number of digits (length of result string)
+ * ------------------------------------------------------------ */
+uint16_t neo430_utoa(uint32_t x, uint16_t min_digits, char *res) {
+
+  static const uint32_t pow10_32[6] = {1000000000, 100000000, 10000000, 1000000, 100000, 10000};
+  static const uint16_t pow10_16[4] = {10000, 1000, 100, 10};
+
+  char *p = res;
+  uint16_t i = 10; // current digit position (10 = most significant)
+  uint16_t d, k, x16;
+  uint16_t start = 0; // first non-zero digit found
+
+  if (min_digits == 0)
+    min_digits = 1;
+
+  if (NX_FEATURES & (1<<NX_DADD_EN)) { // BCD conversion using DADD
+    uint16_t bcd[3], w, n;
+    neo430_bin2bcd(x, bcd);
+    w = bcd[2] << 8; // only 2 digits in upper word
+    n = 2;
+    k = 2;
+    while (1) {
+      while (n--) {
+        d = w >> 12;
+        w <<= 4;
+        if ((d != 0) || (start) || (i <= min_digits)) {
+          *p++ = '0' + (char)d;
+          start = 1;
+        }
+        i--;
+      }
+      if (k == 0)
+        break;
+      w = bcd[--k];
+      n = 4;
+    }
+  }
+  else { // subtract powers of ten
+    if ((uint16_t)(x >> 16) == 0) { // 16-bit value: skip 32-bit arithmetic
+      while (i > 5) {
+        if (i <= min_digits)
+          *p++ = '0';
+        i--;
+      }
+      k = 0;
+    }
+    else {
+      for (k=0; k<6; k++) {
+        d = 0;
+        while (x >= pow10_32[k]) {
+          x -= pow10_32[k];
+          d++;
+        }
+        if ((d != 0) || (start) || (i <= min_digits)) {
+          *p++ = '0' + (char)d;
+          start = 1;
+        }
+        i--;
+      }
+      k = 1; // 10000 already done
+    }
+    x16 = (uint16_t)x;
+    for (; k<4; k++) {
+      d = 0;
+      while (x16 >= pow10_16[k]) {
+        x16 -= pow10_16[k];
+        d++;
+      }
+      if ((d != 0) || (start) || (i <= min_digits)) {
+        *p++ = '0' + (char)d;
+        start = 1;
+      }
+      i--;
+    }
+    *p++ = '0' + (char)x16; // last digit is always printed
+  }
+
+  *p = '\0'; // terminate result string
+  return (uint16_t)(p - res);
+}
+
+
 /* ------------------------------------------------------------
  * INFO Print 32-bit number as decimal number (10 digits)
- * INFO Slow custom version of itoa
+ * INFO Wrapper for neo430_utoa
  * PARAM 32-bit value to be printed as decimal number
  * PARAM show #leading_zeros leading zeros
  * PARAM pointer to array (11 elements!!!) to store conversion result string
  * ------------------------------------------------------------ */
 void neo430_itoa(uint32_t x, uint16_t leading_zeros, char *res) {
 
-  const char numbers[10] = "0123456789";
-  char buffer1[11];
-  uint16_t i, j;
-
-  buffer1[10] = '\0';
-  res[10] = '\0';
-
-  // convert
-  for (i=0; i<10; i++) {
-    buffer1[i] = numbers[x%10];
-    x /= 10;
-  }
-
-  // delete 'leading' zeros
-  for (i=9; i!=leading_zeros; i--) {
-    if (buffer1[i] == '0')
-      buffer1[i] = '\0';
-    else
-      break;
-  }
-
-  // reverse
-  j = 0;
-  do {
-    if (buffer1[i] != '\0')
-      res[j++] = buffer1[i];
-  } while (i--);
+  if (leading_zeros > 9)
+    leading_zeros = 9;
 
-  res[j] = '\0'; // terminate result string
+  neo430_utoa(x, leading_zeros+1, res);
 }
 
 
@@ -431,12 +529,12 @@ void neo430_printf(char *format, ...) {
             n = -n;
             neo430_uart_putc('-');
           }
-          neo430_itoa((uint32_t)n, 0, string_buf);
-          neo430_uart_br_print(string_buf);
+          neo430_utoa((uint32_t)n, 1, string_buf);
+          neo430_uart_print(string_buf);
           break;
         case 'u': // 16-bit unsigned
-          neo430_itoa((uint32_t)va_arg(a, unsigned int), 0, string_buf);
-          neo430_uart_br_print(string_buf);
+          neo430_utoa((uint32_t)va_arg(a, unsigned int), 1, string_buf);
+          neo430_uart_print(string_buf);
           break;
         case 'l': // 32-bit signed long
           n = (int32_t)va_arg(a, int32_t);
@@ -444,12 +542,12 @@ void neo430_printf(char *format, ...) {
             n = -n;
             neo430_uart_putc('-');
           }
-          neo430_itoa((uint32_t)n, 0, string_buf);
-          neo430_uart_br_print(string_buf);
+          neo430_utoa((uint32_t)n, 1, string_buf);
+          neo430_uart_print(string_buf);
           break;
         case 'n': // 32-bit unsigned long
-          neo430_itoa(va_arg(a, uint32_t), 0, string_buf);
-          neo430_uart_br_print(string_buf);
+          neo430_utoa(va_arg(a, uint32_t), 1, string_buf);
+          neo430_uart_print(string_buf);
           break;
         case 'x': // 16-bit hexadecimal
           neo430_uart_print_hex_word(va_arg(a, unsigned int));
@@ -532,8 +630,8 @@ void neo430_uart_print_fpf_32(int32_t num, uint16_t fpf_c, uint16_t num_frac_dig
 
   // print integer part
   char int_buf[11];
-  neo430_itoa((uint32_t)(num_int >> fpf_c), 0, int_buf);
-  neo430_uart_br_print(int_buf);
+  neo430_utoa((uint32_t)(num_int >> fpf_c), 1, int_buf);
+  neo430_uart_print(int_buf);
   neo430_uart_putc('.');
 
 
@@ -561,8 +659,8 @@ void neo430_uart_print_fpf_32(int32_t num, uint16_t fpf_c, uint16_t num_frac_dig
 
   // print fractional part
   char frac_buf[11];
-  neo430_itoa((uint32_t)frac_sum, num_frac_digits_c-1, frac_buf);
+  neo430_utoa((uint32_t)frac_sum, num_frac_digits_c, frac_buf);
   frac_buf[num_frac_digits_c] = '\0'; // truncate
-  neo430_uart_br_print(frac_buf);
+  neo430_uart_print(frac_buf);
 }
 
@@ -0,0 +1,90 @@
+// #################################################################################################
+// #  < neo430_wbs.c - Wishbone slave port (external DMEM access) functions >                      #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2020, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEO430 Processor - https://github.com/stnolting/neo430                                    #
+// #################################################################################################
+
+#include "neo430.h"
+#include "neo430_wbs.h"
+
+
+/* ------------------------------------------------------------
+ * INFO Check if wishbone slave port was synthesized
+ * RETURN 0 if WBS is not implemented, non-zero if WBS is available
+ * ------------------------------------------------------------ */
+uint16_t neo430_wbs_available(void) {
+
+  return (NX_FEATURES & (1<<NX_WBS_EN));
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Enable external DMEM access via the wishbone slave port
+ * PARAM irq_en: Fire (serial) interrupt when the host rings a doorbell if not zero
+ * ------------------------------------------------------------ */
+void neo430_wbs_enable(uint8_t irq_en) {
+
+  uint16_t ct = (1<<WBS_CT_EN);
+  if (irq_en)
+    ct |= (1<<WBS_CT_IRQ_EN);
+  WBS_CT = ct;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Disable external DMEM access (pending access is still completed)
+ * ------------------------------------------------------------ */
+void neo430_wbs_disable(void) {
+
+  WBS_CT = 0;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Get and clear all doorbells rung by the host
+ * RETURN Doorbell flags set by the host since last call
+ * ------------------------------------------------------------ */
+uint16_t neo430_wbs_get_doorbells(void) {
+
+  uint16_t db = WBS_DBIN;
+  WBS_DBIN = db; // clear only the flags we have seen
+  return db;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Ring doorbells to the host (wbs_irq_o is set until the host clears all flags)
+ * PARAM m: Doorbell flags to set
+ * ------------------------------------------------------------ */
+void neo430_wbs_ring_doorbells(uint16_t m) {
+
+  WBS_DBOUT = m;
+}
@@ -0,0 +1,143 @@
+// #################################################################################################
+// #  < neo430_xmem.c - Banked far memory (XMEM) functions >                                       #
+// # ********************************************************************************************* #
+// # BSD 3-Clause License                                                                          #
+// #                                                                                               #
+// # Copyright (c) 2020, Stephan Nolting. All rights reserved.                                     #
+// #                                                                                               #
+// # Redistribution and use in source and binary forms, with or without modification, are          #
+// # permitted provided that the following conditions are met:                                     #
+// #                                                                                               #
+// # 1. Redistributions of source code must retain the above copyright notice, this list of        #
+// #    conditions and the following disclaimer.                                                   #
+// #                                                                                               #
+// # 2. Redistributions in binary form must reproduce the above copyright notice, this list of     #
+// #    conditions and the following disclaimer in the documentation and/or other materials        #
+// #    provided with the distribution.                                                            #
+// #                                                                                               #
+// # 3. Neither the name of the copyright holder nor the names of its contributors may be used to  #
+// #    endorse or promote products derived from this software without specific prior written      #
+// #    permission.                                                                                #
+// #                                                                                               #
+// # THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS   #
+// # OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF               #
+// # MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE    #
+// # COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,     #
+// # EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE #
+// # GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED    #
+// # AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING     #
+// # NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED  #
+// # OF THE POSSIBILITY OF SUCH DAMAGE.                                                            #
+// # ********************************************************************************************* #
+// # The NEO430 Processor - https://github.com/stnolting/neo430                                    #
+// #################################################################################################
+#include "neo430.h"
+#include "neo430_xmem.h"
+
+
+/* ------------------------------------------------------------
+ * INFO Check if banked far memory was synthesized
+ * RETURN 0 if XMEM is not implemented, non-zero if XMEM is available
+ * ------------------------------------------------------------ */
+uint16_t neo430_xmem_available(void) {
+
+  return (NX_FEATURES & (1<<NX_XMEM_EN));
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Get size of the far memory
+ * RETURN Far memory size in bytes (0 if not implemented)
+ * ------------------------------------------------------------ */
+uint32_t neo430_xmem_size(void) {
+
+  return ((uint32_t)XMEM_SIZE_KB) << 10;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Select far memory bank mapped to the window (XMEM_ADDR_BASE)
+ * PARAM bank: Bank number (0..63), far address = bank * 16kB
+ * ------------------------------------------------------------ */
+void neo430_xmem_set_bank(uint8_t bank) {
+
+  XMEM_BANK = (uint16_t)bank;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Get far memory bank currently mapped to the window
+ * RETURN Bank number (0..63)
+ * ------------------------------------------------------------ */
+uint8_t neo430_xmem_get_bank(void) {
+
+  return (uint8_t)XMEM_BANK;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Map far address into the window by selecting the according bank
+ * INFO The returned pointer is valid until another bank is selected,
+ * INFO accesses must not cross the 16kB window boundary.
+ * PARAM addr: 20-bit far address
+ * RETURN Near pointer to far address
+ * ------------------------------------------------------------ */
+void *neo430_xmem_map(uint32_t addr) {
+
+  XMEM_BANK = (uint16_t)(addr >> 14);
+  return (void*)(XMEM_ADDR_BASE + ((uint16_t)addr & (XMEM_WIN_SIZE-1)));
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Read word from far memory via the far pointer (window bank is not changed)
+ * PARAM addr: 20-bit far address (word-aligned)
+ * RETURN Read data
+ * ------------------------------------------------------------ */
+uint16_t neo430_xmem_read16(uint32_t addr) {
+
+  XMEM_PTR_32bit = addr;
+  return XMEM_DATA;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Write word to far memory via the far pointer (window bank is not changed)
+ * PARAM addr: 20-bit far address (word-aligned)
+ * PARAM data: Write data
+ * ------------------------------------------------------------ */
+void neo430_xmem_write16(uint32_t addr, uint16_t data) {
+
+  XMEM_PTR_32bit = addr;
+  XMEM_DATA = data;
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Copy words from far memory (auto-incrementing far pointer)
+ * PARAM addr: 20-bit far source address (word-aligned)
+ * PARAM dst: Destination buffer
+ * PARAM num: Number of words
+ * ------------------------------------------------------------ */
+void neo430_xmem_read_block(uint32_t addr, uint16_t *dst, uint16_t num) {
+
+  XMEM_PTR_32bit = addr;
+  while (num--) {
+    *dst++ = XMEM_DATA;
+  }
+}
+
+
+/* ------------------------------------------------------------
+ * INFO Copy words to far memory (auto-incrementing far pointer)
+ * PARAM addr: 20-bit far destination address (word-aligned)
+ * PARAM src: Source buffer
+ * PARAM num: Number of words
+ * ------------------------------------------------------------ */
+void neo430_xmem_write_block(uint32_t addr, const uint16_t *src, uint16_t num) {
+
+  XMEM_PTR_32bit = addr;
+  while (num--) {
+    XMEM_DATA = *src++;
+  }
+}
@@ -11,6 +11,9 @@ srcdir_core=$homedir/rtl/core
 srcdir_top_templates=$homedir/rtl/top_templates
 srcdir_sim=$homedir/sim
 
+# Additional images for the testbenches (generated by sw_check.sh)
+imgdir=$homedir/travis_ci/images
+
 # Show GHDL version
 ghdl -v
 
@@ -19,36 +22,45 @@ ls -al $srcdir_core
 ls -al $srcdir_top_templates
 ls -al $srcdir_sim
 
-# Analyse sources
-ghdl -a --work=neo430 $srcdir_core/neo430_package.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_application_image.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_bootloader_image.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_addr_gen.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_alu.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_boot_rom.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_cfu.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_control.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_cpu.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_crc.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_dmem.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_exirq.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_freq_gen.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_gpio.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_imem.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_muldiv.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_pwm.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_reg_file.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_spi.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_sysconfig.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_timer.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_top.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_trng.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_twi.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_uart.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_wb_interface.vhd
-ghdl -a --work=neo430 $srcdir_core/neo430_wdt.vhd
-
-ghdl -a --work=neo430 $srcdir_top_templates/*.vhd $srcdir_sim/*.vhd
+# Analyse sources ($1: application image, $2: boot ROM image - optional)
+analyse_sources() {
+  ghdl -a --work=neo430 $srcdir_core/neo430_package.vhd
+  ghdl -a --work=neo430 $1
+  ghdl -a --work=neo430 ${2:-$srcdir_core/neo430_bootloader_image.vhd}
+  ghdl -a --work=neo430 $srcdir_core/neo430_addr_gen.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_alu.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_bmu.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_wb_slave.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_mailbox.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_xmem.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_boot_rom.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_cfu.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_control.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_cpu.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_crc.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_dmem.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_exirq.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_freq_gen.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_gpio.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_imem.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_io_bridge.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_muldiv.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_pwm.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_reg_file.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_spi.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_sysconfig.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_timer.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_top.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_trng.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_twi.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_uart.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_wb_interface.vhd
+  ghdl -a --work=neo430 $srcdir_core/neo430_wdt.vhd
+
+  ghdl -a --work=neo430 $srcdir_top_templates/*.vhd $srcdir_sim/*.vhd
+}
+
+analyse_sources $srcdir_core/neo430_application_image.vhd
 
 # Elaborate top entity
 ghdl -e --work=neo430 neo430_top
@@ -56,6 +68,10 @@ ghdl -e --work=neo430 neo430_top
 # Prepare UART tx output log file and run simulation
 touch neo430.uart_tx.txt
 chmod 777 neo430.uart_tx.txt
+touch neo430.irq_latency.txt
+chmod 777 neo430.irq_latency.txt
+touch neo430.startup.txt
+chmod 777 neo430.startup.txt
 ghdl -e --work=neo430 neo430_tb
 ghdl -r --work=neo430 neo430_tb --stop-time=20ms --ieee-asserts=disable-at-0 --assert-level=error
 
@@ -65,3 +81,48 @@ echo "Checking UART output. Should be:" $uart_res_reference
 echo "UART output is:"
 cat neo430.uart_tx.txt
 grep -q "$uart_res_reference" neo430.uart_tx.txt
+
+# Show startup benchmark
+cat neo430.startup.txt
+
+# Run simulation again with separate peripheral clock (IO clock domain bridge) and check output
+ghdl -r --work=neo430 neo430_tb -gIO_CLK_SEPARATE=true --stop-time=20ms --ieee-asserts=disable-at-0 --assert-level=error
+echo "UART output (separate IO clock) is:"
+cat neo430.uart_tx.txt
+grep -q "$uart_res_reference" neo430.uart_tx.txt
+
+# Run simulation again booting via the bootloader (fast boot from IMEM) and show startup benchmark (reset to main)
+analyse_sources $srcdir_core/neo430_application_image.vhd $imgdir/bootloader_fast_boot_image.vhd
+ghdl -e --work=neo430 neo430_tb
+ghdl -r --work=neo430 neo430_tb -gFAST_BOOT=true --stop-time=20ms --ieee-asserts=disable-at-0 --assert-level=error
+echo "UART output (fast boot) is:"
+cat neo430.uart_tx.txt
+grep -q "$uart_res_reference" neo430.uart_tx.txt
+cat neo430.startup.txt
+
+# Multi-core cluster: run inter-core mailbox test (image built by sw_check.sh) and check output
+analyse_sources $imgdir/mailbox_test_image.vhd
+ghdl -e --work=neo430 neo430_cluster_tb
+touch neo430_cluster.uart_tx.txt
+chmod 777 neo430_cluster.uart_tx.txt
+touch neo430_cluster.benchmark.txt
+chmod 777 neo430_cluster.benchmark.txt
+ghdl -r --work=neo430 neo430_cluster_tb -gNUM_CORES=2 --stop-time=50ms --ieee-asserts=disable-at-0 --assert-level=error
+uart_res_reference="MBOX test OK"
+echo "Checking cluster UART output. Should be:" $uart_res_reference
+echo "UART output is:"
+cat neo430_cluster.uart_tx.txt
+grep -q "$uart_res_reference" neo430_cluster.uart_tx.txt
+
+# Multi-core cluster: run parallel prime numbers benchmark for 1, 2 and 4 cores, check result and show cycle counts
+analyse_sources $imgdir/prime_cluster_image.vhd
+ghdl -e --work=neo430 neo430_cluster_tb
+uart_res_reference="Total: 171 odd primes below 1024"
+for cores in 1 2 4; do
+  ghdl -r --work=neo430 neo430_cluster_tb -gNUM_CORES=$cores --stop-time=150ms --ieee-asserts=disable-at-0 --assert-level=error
+  echo "Checking cluster UART output ($cores cores). Should be:" $uart_res_reference
+  echo "UART output is:"
+  cat neo430_cluster.uart_tx.txt
+  grep -q "$uart_res_reference" neo430_cluster.uart_tx.txt
+  cat neo430_cluster.benchmark.txt
+done
@@ -6,6 +6,10 @@ set -e
 # The directories of the sw source files
 srcdir_examples=/mnt/data/sw/example
 srcdir_bootloader=/mnt/data/sw/bootloader
+srcdir_core=/mnt/data/rtl/core
+
+# Additional images for the testbenches (used by hw_check.sh)
+imgdir=/mnt/data/travis_ci/images
 
 # List files
 ls -al $srcdir_examples
@@ -17,3 +21,18 @@ make -C $srcdir_examples/blink_led check
 # Try to compile all example + bootloader
 make -C $srcdir_examples clean_all info compile
 make -C $srcdir_bootloader clean_all info all
+
+# Generate boot ROM image with (forced) fast boot for the startup benchmark, then restore the default boot ROM image
+mkdir -p $imgdir
+make -C $srcdir_bootloader clean_all all CC_USER_FLAGS="-DFAST_BOOT_EN=1 -DFAST_BOOT_FORCE=1"
+cp $srcdir_core/neo430_bootloader_image.vhd $imgdir/bootloader_fast_boot_image.vhd
+make -C $srcdir_bootloader clean_all all
+
+# Generate application images for the cluster testbench
+make -C $srcdir_examples/mailbox_test clean_all install
+cp $srcdir_core/neo430_application_image.vhd $imgdir/mailbox_test_image.vhd
+make -C $srcdir_examples/prime_cluster clean_all install
+cp $srcdir_core/neo430_application_image.vhd $imgdir/prime_cluster_image.vhd
+
+# Default application image for the processor testbench (with crt0 simulation marker for the startup benchmark)
+make -C $srcdir_examples/blink_led clean_all install NEO430_CRT0_SIM_MARKER=1